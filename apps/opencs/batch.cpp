@@ -0,0 +1,511 @@
+#include "batch.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <QCoreApplication>
+
+#include <components/files/collections.hpp>
+#include <components/ogreinit/ogreinit.hpp>
+#include <components/bsa/resources.hpp>
+
+#include "model/doc/document.hpp"
+#include "model/doc/state.hpp"
+
+#include "model/tools/reportmodel.hpp"
+
+namespace bpo = boost::program_options;
+
+namespace
+{
+    std::string getPhaseName (int type)
+    {
+        switch (type)
+        {
+            case CSMDoc::State_Verifying: return "verify";
+            case CSMDoc::State_Searching: return "search";
+            case CSMDoc::State_Merging: return "merge";
+            case CSMDoc::State_Saving: return "save";
+        }
+
+        return "operation";
+    }
+
+    // keep each report entry on a single line with a fixed number of fields
+    std::string escape (const std::string& text)
+    {
+        std::string result (text);
+        std::replace (result.begin(), result.end(), '\t', ' ');
+        std::replace (result.begin(), result.end(), '\n', ' ');
+        std::replace (result.begin(), result.end(), '\r', ' ');
+        return result;
+    }
+}
+
+bool CS::Batch::isRequested (int argc, char *argv[])
+{
+    for (int i=1; i<argc; ++i)
+        if (std::strcmp (argv[i], "--batch")==0)
+            return true;
+
+    return false;
+}
+
+bool CS::Batch::parseOptions (int argc, char *argv[], Arguments& arguments)
+{
+    bpo::options_description desc ("Run an OpenCS operation without a user interface\n"
+        "Syntax: openmw-cs --batch [options] operation content-files...\n"
+        "Allowed operations:\n"
+        "  verify\t Run the verifier on the last content file.\n"
+        "  search\t Search the loaded content files.\n"
+        "  merge\t Merge all content files into the file given by --output.\n"
+        "  save\t Save the last content file (to --output, if given).\n\n"
+        "Allowed options");
+
+    desc.add_options()
+        ("help,h", "print help message.")
+        ("batch", "run without a user interface (required)")
+        ("threads,j", bpo::value<int> (&arguments.mThreads)->default_value (0),
+         "number of threads used by the verifier (0: one per core)")
+        ("report,r", bpo::value<std::string> (&arguments.mReport)->default_value (""),
+         "write the report to this file instead of stdout")
+        ("output,o", bpo::value<std::string> (&arguments.mOutput)->default_value (""),
+         "content file to create (merge, save)")
+        ("search,s", bpo::value<std::string> (&arguments.mSearchText)->default_value (""),
+         "text to search for (search)")
+        ("search-type", bpo::value<std::string>()->default_value ("text"),
+         "text, text-regex, id or id-regex (search)")
+        ;
+
+    std::string finalText = "\nThe report is written as tab separated values (severity, record type,"
+        " ID, message, hint).\nTimings are written to stderr. The exit status is 2, if the"
+        " verifier reported errors.";
+
+    bpo::options_description hidden ("Hidden Options");
+
+    hidden.add_options()
+        ("operation", bpo::value<std::string>(), "operation")
+        ("content", bpo::value<std::vector<std::string> >(), "content files")
+        ;
+
+    bpo::positional_options_description p;
+    p.add ("operation", 1).add ("content", -1);
+
+    bpo::options_description all;
+    all.add (desc).add (hidden);
+    bpo::variables_map variables;
+
+    try
+    {
+        bpo::store (bpo::command_line_parser (argc, argv).options (all).positional (p).run(),
+            variables);
+        bpo::notify (variables);
+    }
+    catch (const bpo::error& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return false;
+    }
+
+    if (variables.count ("help"))
+    {
+        std::cout << desc << finalText << std::endl;
+        return false;
+    }
+
+    if (!variables.count ("operation") || !variables.count ("content"))
+    {
+        std::cerr << "ERROR: missing operation or content files" << std::endl << std::endl
+            << desc << finalText << std::endl;
+        return false;
+    }
+
+    std::string operation = variables["operation"].as<std::string>();
+
+    if (operation=="verify")
+        arguments.mOperation = Operation_Verify;
+    else if (operation=="search")
+        arguments.mOperation = Operation_Search;
+    else if (operation=="merge")
+        arguments.mOperation = Operation_Merge;
+    else if (operation=="save")
+        arguments.mOperation = Operation_Save;
+    else
+    {
+        std::cerr << "ERROR: invalid operation \"" << operation << "\"" << std::endl;
+        return false;
+    }
+
+    arguments.mContentFiles = variables["content"].as<std::vector<std::string> >();
+
+    std::string searchType = variables["search-type"].as<std::string>();
+
+    if (searchType=="text")
+        arguments.mSearchType = CSMTools::Search::Type_Text;
+    else if (searchType=="text-regex")
+        arguments.mSearchType = CSMTools::Search::Type_TextRegEx;
+    else if (searchType=="id")
+        arguments.mSearchType = CSMTools::Search::Type_Id;
+    else if (searchType=="id-regex")
+        arguments.mSearchType = CSMTools::Search::Type_IdRegEx;
+    else
+    {
+        std::cerr << "ERROR: invalid search type \"" << searchType << "\"" << std::endl;
+        return false;
+    }
+
+    if (arguments.mOperation==Operation_Search && arguments.mSearchText.empty())
+    {
+        std::cerr << "ERROR: search requires --search" << std::endl;
+        return false;
+    }
+
+    if (arguments.mOperation==Operation_Merge && arguments.mOutput.empty())
+    {
+        std::cerr << "ERROR: merge requires --output" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+CS::Batch::Batch (const Arguments& arguments)
+: mUserSettings (mCfgMgr), mDocumentManager (mCfgMgr), mArguments (arguments), mFsStrict (false),
+  mDocument (0), mTarget (0), mRunning (0)
+{}
+
+std::pair<Files::PathContainer, std::vector<std::string> > CS::Batch::readConfig()
+{
+    bpo::variables_map variables;
+    bpo::options_description desc;
+
+    desc.add_options()
+    ("data", bpo::value<Files::PathContainer>()->default_value(Files::PathContainer(), "data")->multitoken()->composing())
+    ("data-local", bpo::value<std::string>()->default_value(""))
+    ("fs-strict", bpo::value<bool>()->implicit_value(true)->default_value(false))
+    ("encoding", bpo::value<std::string>()->default_value("win1252"))
+    ("resources", bpo::value<std::string>()->default_value("resources"))
+    ("fallback-archive", bpo::value<std::vector<std::string> >()->
+        default_value(std::vector<std::string>(), "fallback-archive")->multitoken())
+    ("script-blacklist", bpo::value<std::vector<std::string> >()->default_value(std::vector<std::string>(), "")
+        ->multitoken())
+    ("script-blacklist-use", bpo::value<bool>()->implicit_value(true)->default_value(true));
+
+    bpo::notify (variables);
+
+    mCfgMgr.readConfiguration (variables, desc, true);
+
+    mDocumentManager.setEncoding (
+        ToUTF8::calculateEncoding (variables["encoding"].as<std::string>()));
+
+    mDocumentManager.setResourceDir (variables["resources"].as<std::string>());
+
+    if (variables["script-blacklist-use"].as<bool>())
+        mDocumentManager.setBlacklistedScripts (
+            variables["script-blacklist"].as<std::vector<std::string> >());
+
+    mFsStrict = variables["fs-strict"].as<bool>();
+
+    Files::PathContainer dataDirs, dataLocal;
+    if (!variables["data"].empty())
+        dataDirs = Files::PathContainer (variables["data"].as<Files::PathContainer>());
+
+    std::string local = variables["data-local"].as<std::string>();
+    if (!local.empty())
+        dataLocal.push_back (Files::PathContainer::value_type (local));
+
+    mCfgMgr.processPaths (dataDirs);
+    mCfgMgr.processPaths (dataLocal, true);
+
+    dataDirs.insert (dataDirs.end(), dataLocal.begin(), dataLocal.end());
+
+    Files::PathContainer canonicalPaths;
+
+    for (Files::PathContainer::const_iterator iter = dataDirs.begin(); iter != dataDirs.end(); ++iter)
+    {
+        boost::filesystem::path path = boost::filesystem::canonical (*iter);
+
+        if (std::find (canonicalPaths.begin(), canonicalPaths.end(), path)==canonicalPaths.end())
+            canonicalPaths.push_back (path);
+    }
+
+    return std::make_pair (canonicalPaths,
+        variables["fallback-archive"].as<std::vector<std::string> >());
+}
+
+std::vector<boost::filesystem::path> CS::Batch::resolveContentFiles (
+    const Files::PathContainer& dataDirs) const
+{
+    Files::Collections collections (dataDirs, !mFsStrict);
+
+    std::vector<boost::filesystem::path> files;
+
+    for (std::vector<std::string>::const_iterator iter (mArguments.mContentFiles.begin());
+        iter!=mArguments.mContentFiles.end(); ++iter)
+    {
+        boost::filesystem::path path (*iter);
+
+        if (boost::filesystem::exists (path))
+            files.push_back (boost::filesystem::system_complete (path));
+        else
+            files.push_back (collections.getPath (*iter));
+    }
+
+    return files;
+}
+
+int CS::Batch::run (OgreInit::OgreInit& ogreInit)
+{
+    std::pair<Files::PathContainer, std::vector<std::string> > config = readConfig();
+
+    CSMSettings::UserSettings::instance().loadSettings ("opencs.ini");
+
+    // resources are only needed for the lists of available meshes, textures, etc.
+    ogreInit.init ((mCfgMgr.getUserConfigPath() / "opencsOgre.log").string());
+
+    Bsa::registerResources (Files::Collections (config.first, !mFsStrict), config.second, true,
+        mFsStrict);
+
+    mDocumentManager.listResources();
+
+    std::vector<boost::filesystem::path> files = resolveContentFiles (config.first);
+
+    boost::filesystem::path savePath = files.back();
+
+    if (mArguments.mOperation==Operation_Save && !mArguments.mOutput.empty())
+        savePath = mArguments.mOutput;
+
+    connect (&mDocumentManager, SIGNAL (nextStage (CSMDoc::Document *, const std::string&, int)),
+        this, SLOT (nextStage (CSMDoc::Document *, const std::string&, int)));
+    connect (&mDocumentManager, SIGNAL (loadMessage (CSMDoc::Document *, const std::string&)),
+        this, SLOT (loadMessage (CSMDoc::Document *, const std::string&)));
+    connect (&mDocumentManager,
+        SIGNAL (loadingStopped (CSMDoc::Document *, bool, const std::string&)),
+        this, SLOT (loadingStopped (CSMDoc::Document *, bool, const std::string&)));
+
+    mOperationTimer.start();
+    mStageTimer.start();
+
+    mDocumentManager.addDocument (files, savePath, false);
+
+    return QCoreApplication::exec();
+}
+
+void CS::Batch::startOperation()
+{
+    connect (mDocument, SIGNAL (operationFinished (int, bool)),
+        this, SLOT (operationFinished (int, bool)));
+    connect (mDocument, SIGNAL (stageTiming (const std::string&, int, double, int)),
+        this, SLOT (stageTiming (const std::string&, int, double, int)));
+
+    mOperationTimer.restart();
+
+    switch (mArguments.mOperation)
+    {
+        case Operation_Verify:
+
+            mRunning = CSMDoc::State_Verifying;
+            mDocument->setVerifierThreads (mArguments.mThreads);
+            mReportId = mDocument->verify();
+            break;
+
+        case Operation_Search:
+        {
+            CSMTools::Search search;
+
+            if (mArguments.mSearchType==CSMTools::Search::Type_TextRegEx ||
+                mArguments.mSearchType==CSMTools::Search::Type_IdRegEx)
+                search = CSMTools::Search (mArguments.mSearchType,
+                    QRegExp (QString::fromUtf8 (mArguments.mSearchText.c_str()), Qt::CaseInsensitive));
+            else
+                search = CSMTools::Search (mArguments.mSearchType, mArguments.mSearchText);
+
+            mRunning = CSMDoc::State_Searching;
+            mReportId = mDocument->newSearch();
+            mDocument->runSearch (mReportId, search);
+            break;
+        }
+
+        case Operation_Merge:
+        {
+            std::vector<boost::filesystem::path> files (1,
+                boost::filesystem::system_complete (mArguments.mOutput));
+
+            std::auto_ptr<CSMDoc::Document> target (
+                mDocumentManager.makeDocument (files, files[0], true));
+
+            connect (mDocument, SIGNAL (mergeDone (CSMDoc::Document *)),
+                this, SLOT (mergeDone (CSMDoc::Document *)));
+
+            mRunning = CSMDoc::State_Merging;
+            mDocument->runMerge (target);
+            break;
+        }
+
+        case Operation_Save:
+
+            mRunning = CSMDoc::State_Saving;
+            mDocument->save();
+            break;
+    }
+}
+
+void CS::Batch::finishOperation (bool failed)
+{
+    printTiming (getPhaseName (mRunning), "total", 0, mOperationTimer.elapsed() / 1000.0);
+
+    mRunning = 0;
+
+    if (failed)
+    {
+        exit (1);
+        return;
+    }
+
+    if (mArguments.mOperation==Operation_Verify || mArguments.mOperation==Operation_Search)
+    {
+        if (mArguments.mReport.empty())
+            writeReport (std::cout);
+        else
+        {
+            std::ofstream stream (mArguments.mReport.c_str());
+
+            if (!stream.is_open())
+            {
+                std::cerr << "ERROR: can not open report file " << mArguments.mReport << std::endl;
+                exit (1);
+                return;
+            }
+
+            writeReport (stream);
+        }
+
+        if (mArguments.mOperation==Operation_Verify &&
+            mDocument->getReport (mReportId)->countErrors()>0)
+        {
+            exit (2);
+            return;
+        }
+    }
+
+    exit (0);
+}
+
+void CS::Batch::writeReport (std::ostream& stream)
+{
+    const CSMTools::ReportModel *report = mDocument->getReport (mReportId);
+
+    int size = report->rowCount();
+
+    for (int i=0; i<size; ++i)
+    {
+        const CSMDoc::Message& message = report->getMessage (i);
+
+        stream
+            << CSMDoc::Message::toString (message.mSeverity) << "\t"
+            << message.mId.getTypeName() << "\t"
+            << escape (message.mId.getId()) << "\t"
+            << escape (message.mMessage) << "\t"
+            << escape (message.mHint) << "\n";
+    }
+
+    stream.flush();
+}
+
+void CS::Batch::printTiming (const std::string& phase, const std::string& name, int steps,
+    double seconds) const
+{
+    std::cerr << phase << "\t" << name << "\t" << steps << "\t" << seconds << std::endl;
+}
+
+void CS::Batch::exit (int status)
+{
+    QCoreApplication::exit (status);
+}
+
+void CS::Batch::nextStage (CSMDoc::Document *document, const std::string& name,
+    int totalRecords)
+{
+    if (!mLoadStage.empty())
+        printTiming ("load", mLoadStage, 0, mStageTimer.restart() / 1000.0);
+    else
+        mStageTimer.restart();
+
+    mLoadStage = name;
+}
+
+void CS::Batch::loadMessage (CSMDoc::Document *document, const std::string& message)
+{
+    std::cerr << "load: " << message << std::endl;
+}
+
+void CS::Batch::loadingStopped (CSMDoc::Document *document, bool completed,
+    const std::string& error)
+{
+    if (!mLoadStage.empty())
+    {
+        printTiming ("load", mLoadStage, 0, mStageTimer.elapsed() / 1000.0);
+        mLoadStage.clear();
+    }
+
+    if (!completed)
+    {
+        std::cerr << "ERROR: loading failed: " << error << std::endl;
+        exit (1);
+        return;
+    }
+
+    if (document==mTarget)
+    {
+        // the merged document has been set up, now write it
+        connect (mTarget, SIGNAL (operationFinished (int, bool)),
+            this, SLOT (operationFinished (int, bool)));
+        connect (mTarget, SIGNAL (stageTiming (const std::string&, int, double, int)),
+            this, SLOT (stageTiming (const std::string&, int, double, int)));
+
+        mOperationTimer.restart();
+        mRunning = CSMDoc::State_Saving;
+        mTarget->save();
+        return;
+    }
+
+    printTiming ("load", "total", 0, mOperationTimer.elapsed() / 1000.0);
+
+    mDocument = document;
+    startOperation();
+}
+
+void CS::Batch::operationFinished (int type, bool failed)
+{
+    if (type!=mRunning)
+        return;
+
+    if (type==CSMDoc::State_Merging && !failed)
+    {
+        printTiming (getPhaseName (type), "total", 0, mOperationTimer.elapsed() / 1000.0);
+
+        // the document manager loads the merged document (mergeDone), which is then saved
+        mRunning = 0;
+        mStageTimer.restart();
+        mOperationTimer.restart();
+        return;
+    }
+
+    finishOperation (failed);
+}
+
+void CS::Batch::mergeDone (CSMDoc::Document *document)
+{
+    mTarget = document;
+}
+
+void CS::Batch::stageTiming (const std::string& stage, int steps, double seconds, int type)
+{
+    printTiming (getPhaseName (type), stage, steps, seconds);
+}
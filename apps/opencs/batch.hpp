@@ -0,0 +1,137 @@
+#ifndef CS_BATCH_H
+#define CS_BATCH_H
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <boost/filesystem/path.hpp>
+
+#include <QObject>
+#include <QElapsedTimer>
+
+#ifndef Q_MOC_RUN
+#include <components/files/configurationmanager.hpp>
+#endif
+
+#include "model/settings/usersettings.hpp"
+#include "model/doc/documentmanager.hpp"
+
+#include "model/world/universalid.hpp"
+
+#include "model/tools/search.hpp"
+
+namespace OgreInit
+{
+    class OgreInit;
+}
+
+namespace CSMDoc
+{
+    class Document;
+}
+
+namespace CS
+{
+    /// \brief Runs a single document operation from the command line, without a user interface
+    ///
+    /// Syntax: openmw-cs --batch [options] operation content-files...
+    ///
+    /// The report is written as tab separated values. Timings for the load stages and the stages
+    /// of the operation are written to stderr in the same format.
+    class Batch : public QObject
+    {
+            Q_OBJECT
+
+        public:
+
+            enum Operation
+            {
+                Operation_Verify,
+                Operation_Search,
+                Operation_Merge,
+                Operation_Save
+            };
+
+            struct Arguments
+            {
+                Operation mOperation;
+                std::vector<std::string> mContentFiles;
+                std::string mOutput;
+                std::string mReport;
+                int mThreads;
+                CSMTools::Search::Type mSearchType;
+                std::string mSearchText;
+            };
+
+        private:
+
+            Files::ConfigurationManager mCfgMgr;
+            CSMSettings::UserSettings mUserSettings;
+            CSMDoc::DocumentManager mDocumentManager;
+            Arguments mArguments;
+            bool mFsStrict;
+            CSMDoc::Document *mDocument;
+            CSMDoc::Document *mTarget; // result of a merge
+            int mRunning; // state of the operation that is running
+            CSMWorld::UniversalId mReportId;
+            std::string mLoadStage;
+            QElapsedTimer mStageTimer;
+            QElapsedTimer mOperationTimer;
+
+            std::pair<Files::PathContainer, std::vector<std::string> > readConfig();
+            ///< \return data paths and archives
+
+            std::vector<boost::filesystem::path> resolveContentFiles (
+                const Files::PathContainer& dataDirs) const;
+
+            void startOperation();
+
+            void finishOperation (bool failed);
+
+            void writeReport (std::ostream& stream);
+
+            void printTiming (const std::string& phase, const std::string& name, int steps,
+                double seconds) const;
+
+            void exit (int status);
+
+            // not implemented
+            Batch (const Batch&);
+            Batch& operator= (const Batch&);
+
+        public:
+
+            static bool isRequested (int argc, char *argv[]);
+            ///< Has batch mode been requested on the command line?
+
+            static bool parseOptions (int argc, char *argv[], Arguments& arguments);
+            ///< \return Continue with the operation? (false on errors and when only help has
+            /// been requested)
+
+            Batch (const Arguments& arguments);
+
+            int run (OgreInit::OgreInit& ogreInit);
+            ///< Run the event loop until the operation is finished.
+            ///
+            /// \return 0 on success, 1 if the operation failed, 2 if the verifier reported errors
+
+        private slots:
+
+            void nextStage (CSMDoc::Document *document, const std::string& name,
+                int totalRecords);
+
+            void loadMessage (CSMDoc::Document *document, const std::string& message);
+
+            void loadingStopped (CSMDoc::Document *document, bool completed,
+                const std::string& error);
+
+            void operationFinished (int type, bool failed);
+
+            void mergeDone (CSMDoc::Document *document);
+
+            void stageTiming (const std::string& stage, int steps, double seconds, int type);
+    };
+}
+
+#endif
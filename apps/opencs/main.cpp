@@ -1,4 +1,5 @@
 #include "editor.hpp"
+#include "batch.hpp"
 
 #include <exception>
 #include <iostream>
@@ -57,6 +58,33 @@ int main(int argc, char *argv[])
 
         OgreInit::OgreInit ogreInit;
 
+        if (CS::Batch::isRequested (argc, argv))
+        {
+            CS::Batch::Arguments arguments;
+
+            if (!CS::Batch::parseOptions (argc, argv, arguments))
+                return 1;
+
+            // the document model still uses a few GUI classes, but must not need a display
+    #if QT_VERSION >= 0x050000
+            qputenv ("QT_QPA_PLATFORM", "offscreen");
+            QApplication application (argc, argv);
+    #else
+            QApplication application (argc, argv, false);
+    #endif
+
+            try
+            {
+                CS::Batch batch (arguments);
+                return batch.run (ogreInit);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "ERROR: " << e.what() << std::endl;
+                return 1;
+            }
+        }
+
         std::auto_ptr<sh::Factory> shinyFactory;
 
         Application application (argc, argv);
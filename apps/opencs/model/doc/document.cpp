@@ -2304,6 +2304,11 @@ CSMDoc::Document::Document (const Files::ConfigurationManager& configuration,
     connect (&mSaving, SIGNAL (progress (int, int, int)), this, SLOT (progress (int, int, int)));
     connect (&mSaving, SIGNAL (done (int, bool)), this, SLOT (operationDone (int, bool)));
 
+    connect (&mTools, SIGNAL (stageTiming (const std::string&, int, double, int)),
+        this, SIGNAL (stageTiming (const std::string&, int, double, int)));
+    connect (&mSaving, SIGNAL (stageTiming (const std::string&, int, double, int)),
+        this, SIGNAL (stageTiming (const std::string&, int, double, int)));
+
     connect (
         &mSaving, SIGNAL (reportMessage (const CSMDoc::Message&, int)),
         this, SLOT (reportMessage (const CSMDoc::Message&, int)));
@@ -2403,6 +2408,11 @@ void CSMDoc::Document::abortOperation (int type)
         mTools.abortOperation (type);
 }
 
+void CSMDoc::Document::setVerifierThreads (int threads)
+{
+    mTools.setVerifierThreads (threads);
+}
+
 void CSMDoc::Document::modificationStateChanged (bool clean)
 {
     emit stateChanged (getState(), this);
@@ -2420,6 +2430,7 @@ void CSMDoc::Document::operationDone (int type, bool failed)
         mDirty = false;
 
     emit stateChanged (getState(), this);
+    emit operationFinished (type, failed);
 }
 
 const CSMWorld::Data& CSMDoc::Document::getData() const
@@ -132,6 +132,9 @@ namespace CSMDoc
 
             void abortOperation (int type);
 
+            /// Number of threads used by the verifier (0: one per core).
+            void setVerifierThreads (int threads);
+
             const CSMWorld::Data& getData() const;
 
             CSMWorld::Data& getData();
@@ -164,6 +167,10 @@ namespace CSMDoc
             /// document. This signal must be handled to avoid a leak.
             void mergeDone (CSMDoc::Document *document);
 
+            void stageTiming (const std::string& stage, int steps, double seconds, int type);
+
+            void operationFinished (int type, bool failed);
+
         private slots:
 
             void modificationStateChanged (bool clean);
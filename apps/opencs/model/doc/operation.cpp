@@ -1,8 +1,15 @@
 #include "operation.hpp"
 
+#include <cstdlib>
 #include <string>
+#include <typeinfo>
 #include <vector>
 
+#ifdef __GNUC__
+#include <cxxabi.h>
+#endif
+
+#include <QElapsedTimer>
 #include <QTimer>
 
 #include "../world/universalid.hpp"
@@ -10,6 +17,28 @@
 
 #include "state.hpp"
 #include "stage.hpp"
+#include "stagerunner.hpp"
+
+namespace
+{
+    std::string getStageName (const CSMDoc::Stage& stage)
+    {
+        const char *name = typeid (stage).name();
+
+#ifdef __GNUC__
+        int status = 0;
+
+        if (char *demangled = abi::__cxa_demangle (name, 0, 0, &status))
+        {
+            std::string result (demangled);
+            std::free (demangled);
+            return result;
+        }
+#endif
+
+        return name;
+    }
+}
 
 void CSMDoc::Operation::prepareStages()
 {
@@ -18,6 +47,7 @@ void CSMDoc::Operation::prepareStages()
     mCurrentStepTotal = 0;
     mTotalSteps = 0;
     mError = false;
+    mStageTimes.assign (mStages.size(), 0);
 
     for (std::vector<std::pair<Stage *, int> >::iterator iter (mStages.begin()); iter!=mStages.end(); ++iter)
     {
@@ -33,13 +63,15 @@ CSMDoc::Operation::Operation (int type, bool ordered, bool finalAlways)
 : mType (type), mStages(std::vector<std::pair<Stage *, int> >()), mCurrentStage(mStages.begin()),
   mCurrentStep(0), mCurrentStepTotal(0), mTotalSteps(0), mOrdered (ordered),
   mFinalAlways (finalAlways), mError(false), mConnected (false), mPrepared (false),
-  mDefaultSeverity (Message::Severity_Error)
+  mDefaultSeverity (Message::Severity_Error), mThreads (1), mRunner (0)
 {
     mTimer = new QTimer (this);
 }
 
 CSMDoc::Operation::~Operation()
 {
+    delete mRunner;
+
     for (std::vector<std::pair<Stage *, int> >::iterator iter (mStages.begin()); iter!=mStages.end(); ++iter)
         delete iter->first;
 }
@@ -56,6 +88,9 @@ void CSMDoc::Operation::run()
 
     mPrepared = false;
 
+    delete mRunner;
+    mRunner = 0;
+
     mTimer->start (0);
 }
 
@@ -77,6 +112,11 @@ void CSMDoc::Operation::setDefaultSeverity (Message::Severity severity)
     mDefaultSeverity = severity;
 }
 
+void CSMDoc::Operation::setParallel (int threads)
+{
+    mThreads = threads;
+}
+
 bool CSMDoc::Operation::hasError() const
 {
     return mError;
@@ -89,6 +129,12 @@ void CSMDoc::Operation::abort()
 
     mError = true;
 
+    if (mRunner)
+    {
+        mRunner->abort();
+        return;
+    }
+
     if (mFinalAlways)
     {
         if (mStages.begin()!=mStages.end() && mCurrentStage!=--mStages.end())
@@ -115,8 +161,17 @@ void CSMDoc::Operation::executeStage()
     {
         prepareStages();
         mPrepared = true;
+
+        if (!mOrdered && !mFinalAlways && mThreads!=1)
+            mRunner = new StageRunner (mStages, mDefaultSeverity, mThreads);
     }
-    
+
+    if (mRunner)
+    {
+        executeParallel();
+        return;
+    }
+
     Messages messages (mDefaultSeverity);
 
     while (mCurrentStage!=mStages.end())
@@ -128,6 +183,11 @@ void CSMDoc::Operation::executeStage()
         }
         else
         {
+            QElapsedTimer timer;
+            timer.start();
+
+            int stage = mCurrentStage - mStages.begin();
+
             try
             {
                 mCurrentStage->first->perform (mCurrentStep++, messages);
@@ -138,6 +198,8 @@ void CSMDoc::Operation::executeStage()
                 abort();
             }
 
+            mStageTimes[stage] += timer.nsecsElapsed() / 1000000000.0;
+
             ++mCurrentStepTotal;
             break;
         }
@@ -149,7 +211,41 @@ void CSMDoc::Operation::executeStage()
         emit reportMessage (*iter, mType);
 
     if (mCurrentStage==mStages.end())
+    {
+        reportStageTimes();
         operationDone();
+    }
+}
+
+void CSMDoc::Operation::executeParallel()
+{
+    Messages messages (mDefaultSeverity);
+
+    // wait a bit, so that progress is not reported more often than necessary
+    mCurrentStepTotal = mRunner->poll (messages, 50);
+
+    if (mRunner->hasFailed())
+        mError = true;
+
+    emit progress (mCurrentStepTotal, mTotalSteps ? mTotalSteps : 1, mType);
+
+    for (Messages::Iterator iter (messages.begin()); iter!=messages.end(); ++iter)
+        emit reportMessage (*iter, mType);
+
+    if (mRunner->isDone())
+    {
+        reportStageTimes();
+        delete mRunner;
+        mRunner = 0;
+        operationDone();
+    }
+}
+
+void CSMDoc::Operation::reportStageTimes()
+{
+    for (std::size_t i=0; i<mStages.size(); ++i)
+        emit stageTiming (getStageName (*mStages[i].first), mStages[i].second,
+            mRunner ? mRunner->getStageTime (i) : mStageTimes[i], mType);
 }
 
 void CSMDoc::Operation::operationDone()
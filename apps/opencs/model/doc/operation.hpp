@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <map>
+#include <string>
 
 #include <QObject>
 #include <QTimer>
@@ -18,6 +19,7 @@ namespace CSMWorld
 namespace CSMDoc
 {
     class Stage;
+    class StageRunner;
 
     class Operation : public QObject
     {
@@ -37,9 +39,16 @@ namespace CSMDoc
             std::map<QString, QStringList> mSettings;
             bool mPrepared;
             Message::Severity mDefaultSeverity;
+            int mThreads;
+            StageRunner *mRunner;
+            std::vector<double> mStageTimes; // seconds per stage (sequential runs only)
 
             void prepareStages();
 
+            void executeParallel();
+
+            void reportStageTimes();
+
         public:
 
             Operation (int type, bool ordered, bool finalAlways = false);
@@ -61,6 +70,15 @@ namespace CSMDoc
             /// \attention Do no call this function while this Operation is running.
             void setDefaultSeverity (Message::Severity severity);
 
+            /// Perform the stages on \a threads worker threads (0: one per core). Messages are
+            /// still reported in the same order as in a sequential run.
+            ///
+            /// \note Ignored for ordered operations and operations with a final stage that is
+            /// always executed.
+            ///
+            /// \attention Do no call this function while this Operation is running.
+            void setParallel (int threads = 0);
+
             bool hasError() const;
 
         signals:
@@ -71,6 +89,12 @@ namespace CSMDoc
 
             void done (int type, bool failed);
 
+            /// Emitted for each stage when the operation has finished.
+            ///
+            /// \param seconds time spent performing the steps of the stage (summed over all
+            /// threads for parallel runs)
+            void stageTiming (const std::string& stage, int steps, double seconds, int type);
+
         public slots:
 
             void abort();
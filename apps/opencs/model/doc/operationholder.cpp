@@ -27,6 +27,10 @@ void CSMDoc::OperationHolder::setOperation (Operation *operation)
         mOperation, SIGNAL (done (int, bool)),
         this, SLOT (doneSlot (int, bool)));
 
+    connect (
+        mOperation, SIGNAL (stageTiming (const std::string&, int, double, int)),
+        this, SIGNAL (stageTiming (const std::string&, int, double, int)));
+
     connect (this, SIGNAL (abortSignal()), mOperation, SLOT (abort()));
 
     connect (&mThread, SIGNAL (started()), mOperation, SLOT (run()));
@@ -50,6 +50,8 @@ namespace CSMDoc
 
             void done (int type, bool failed);
 
+            void stageTiming (const std::string& stage, int steps, double seconds, int type);
+
             void abortSignal();
     };
 }
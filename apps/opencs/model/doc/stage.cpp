@@ -3,3 +3,8 @@
 CSMDoc::Stage::~Stage() {}
 
 void CSMDoc::Stage::updateUserSetting (const QString& name, const QStringList& value) {}
+
+bool CSMDoc::Stage::isReentrant() const
+{
+    return false;
+}
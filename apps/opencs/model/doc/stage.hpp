@@ -26,6 +26,12 @@ namespace CSMDoc
 
             /// Default-implementation: ignore
             virtual void updateUserSetting (const QString& name, const QStringList& value);
+
+            /// Can different steps of this stage be performed concurrently from multiple
+            /// threads?
+            ///
+            /// Default-implementation: false
+            virtual bool isReentrant() const;
     };
 }
 
@@ -0,0 +1,217 @@
+#include "stagerunner.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/thread_time.hpp>
+
+#include "stage.hpp"
+
+CSMDoc::StageRunner::StageRunner (const std::vector<std::pair<Stage *, int> >& stages,
+    Message::Severity defaultSeverity, int threads)
+: mDefaultSeverity (defaultSeverity), mCompletedSteps (0), mActiveWorkers (0), mAborted (false),
+  mFailed (false), mReportStage (0), mReportStep (0)
+{
+    for (std::vector<std::pair<Stage *, int> >::const_iterator iter (stages.begin());
+        iter!=stages.end(); ++iter)
+    {
+        StageState state;
+        state.mStage = iter->first;
+        state.mSteps = iter->second;
+        state.mNext = 0;
+        state.mBusy = false;
+        state.mReentrant = iter->first->isReentrant();
+        state.mTime = 0;
+        mStages.push_back (state);
+    }
+
+    if (threads<=0)
+        threads = std::max (1, static_cast<int> (boost::thread::hardware_concurrency()));
+
+    mActiveWorkers = threads;
+
+    for (int i=0; i<threads; ++i)
+        mThreads.create_thread (boost::bind (&StageRunner::run, this));
+}
+
+CSMDoc::StageRunner::~StageRunner()
+{
+    abort();
+    mThreads.join_all();
+}
+
+bool CSMDoc::StageRunner::claim (int& stage, int& begin, int& end)
+{
+    for (int i=0; i<static_cast<int> (mStages.size()); ++i)
+    {
+        StageState& state = mStages[i];
+
+        if (state.mNext<state.mSteps && (state.mReentrant || !state.mBusy))
+        {
+            stage = i;
+            begin = state.mNext;
+            end = std::min (begin + sChunkSteps, state.mSteps);
+
+            state.mNext = end;
+            state.mBusy = true;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CSMDoc::StageRunner::run()
+{
+    boost::mutex::scoped_lock lock (mMutex);
+
+    while (!mAborted)
+    {
+        int stage = 0;
+        int begin = 0;
+        int end = 0;
+
+        if (!claim (stage, begin, end))
+        {
+            bool remaining = false;
+
+            for (std::vector<StageState>::const_iterator iter (mStages.begin());
+                iter!=mStages.end() && !remaining; ++iter)
+                remaining = iter->mNext<iter->mSteps;
+
+            if (!remaining)
+                break;
+
+            // the remaining steps belong to stages another worker is busy with
+            mWorkAvailable.wait (lock);
+            continue;
+        }
+
+        StageState& state = mStages[stage];
+
+        lock.unlock();
+
+        Messages messages (mDefaultSeverity);
+        bool failed = false;
+
+        boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+        try
+        {
+            for (int step = begin; step<end; ++step)
+                state.mStage->perform (step, messages);
+        }
+        catch (const std::exception& e)
+        {
+            messages.add (CSMWorld::UniversalId(), e.what(), "", Message::Severity_SeriousError);
+            failed = true;
+        }
+
+        boost::posix_time::time_duration duration =
+            boost::posix_time::microsec_clock::universal_time() - start;
+
+        lock.lock();
+
+        state.mTime += duration.total_microseconds() / 1000000.0;
+
+        Chunk& chunk = state.mChunks[begin];
+        chunk.mEnd = end;
+        chunk.mMessages.assign (messages.begin(), messages.end());
+
+        state.mBusy = false;
+        mCompletedSteps += end-begin;
+
+        if (failed)
+            mAborted = mFailed = true;
+
+        mWorkAvailable.notify_all();
+        mProgress.notify_all();
+    }
+
+    --mActiveWorkers;
+
+    mWorkAvailable.notify_all();
+    mProgress.notify_all();
+}
+
+void CSMDoc::StageRunner::abort()
+{
+    boost::mutex::scoped_lock lock (mMutex);
+    mAborted = true;
+    mWorkAvailable.notify_all();
+}
+
+int CSMDoc::StageRunner::poll (Messages& messages, int timeout)
+{
+    boost::mutex::scoped_lock lock (mMutex);
+
+    boost::system_time deadline = boost::get_system_time() + boost::posix_time::milliseconds (timeout);
+
+    while (mActiveWorkers>0)
+        if (!mProgress.timed_wait (lock, deadline))
+            break;
+
+    while (mReportStage<static_cast<int> (mStages.size()))
+    {
+        StageState& state = mStages[mReportStage];
+
+        if (mReportStep>=state.mSteps)
+        {
+            ++mReportStage;
+            mReportStep = 0;
+            continue;
+        }
+
+        std::map<int, Chunk>::iterator iter = state.mChunks.find (mReportStep);
+
+        if (iter==state.mChunks.end())
+            break;
+
+        for (Messages::Iterator iter2 (iter->second.mMessages.begin());
+            iter2!=iter->second.mMessages.end(); ++iter2)
+            messages.add (iter2->mId, iter2->mMessage, iter2->mHint, iter2->mSeverity);
+
+        mReportStep = iter->second.mEnd;
+        state.mChunks.erase (iter);
+    }
+
+    if (mActiveWorkers==0 && mAborted)
+    {
+        // an aborted run leaves gaps, report whatever has been finished
+        for (; mReportStage<static_cast<int> (mStages.size()); ++mReportStage)
+        {
+            StageState& state = mStages[mReportStage];
+
+            for (std::map<int, Chunk>::const_iterator iter (state.mChunks.begin());
+                iter!=state.mChunks.end(); ++iter)
+                for (Messages::Iterator iter2 (iter->second.mMessages.begin());
+                    iter2!=iter->second.mMessages.end(); ++iter2)
+                    messages.add (iter2->mId, iter2->mMessage, iter2->mHint, iter2->mSeverity);
+
+            state.mChunks.clear();
+        }
+    }
+
+    return mCompletedSteps;
+}
+
+bool CSMDoc::StageRunner::isDone()
+{
+    boost::mutex::scoped_lock lock (mMutex);
+    return mActiveWorkers==0 && mReportStage>=static_cast<int> (mStages.size());
+}
+
+bool CSMDoc::StageRunner::hasFailed()
+{
+    boost::mutex::scoped_lock lock (mMutex);
+    return mFailed;
+}
+
+double CSMDoc::StageRunner::getStageTime (int stage)
+{
+    boost::mutex::scoped_lock lock (mMutex);
+    return mStages.at (stage).mTime;
+}
@@ -0,0 +1,100 @@
+#ifndef CSM_DOC_STAGERUNNER_H
+#define CSM_DOC_STAGERUNNER_H
+
+#include <map>
+#include <vector>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include "messages.hpp"
+
+namespace CSMDoc
+{
+    class Stage;
+
+    /// \brief Performs the steps of a list of stages on a pool of worker threads
+    ///
+    /// Steps are claimed in chunks. A stage that is not reentrant is only worked on by one thread
+    /// at a time, so its steps are still performed in order. Different stages may run concurrently
+    /// and must therefore only read shared data.
+    ///
+    /// Messages are handed out in the same order a sequential run would produce them.
+    class StageRunner
+    {
+            struct Chunk
+            {
+                int mEnd;
+                Messages::Collection mMessages;
+            };
+
+            struct StageState
+            {
+                Stage *mStage;
+                int mSteps;
+                int mNext; // first step that has not been claimed yet
+                bool mBusy;
+                bool mReentrant;
+                double mTime; // seconds spent performing steps, summed over all threads
+                std::map<int, Chunk> mChunks; // finished chunks by first step
+            };
+
+            std::vector<StageState> mStages;
+            Message::Severity mDefaultSeverity;
+            int mCompletedSteps;
+            int mActiveWorkers;
+            bool mAborted;
+            bool mFailed;
+            int mReportStage;
+            int mReportStep;
+
+            boost::mutex mMutex;
+            boost::condition_variable mWorkAvailable;
+            boost::condition_variable mProgress;
+            boost::thread_group mThreads;
+
+            // not implemented
+            StageRunner (const StageRunner&);
+            StageRunner& operator= (const StageRunner&);
+
+            bool claim (int& stage, int& begin, int& end);
+            ///< Must be called with mMutex locked.
+
+            void run();
+
+        public:
+
+            /// Number of steps a worker claims at once.
+            static const int sChunkSteps = 32;
+
+            StageRunner (const std::vector<std::pair<Stage *, int> >& stages,
+                Message::Severity defaultSeverity, int threads);
+            ///< \param stages stages and their number of steps (setup must have been called already)
+            /// \param threads number of worker threads, 0 for one per core
+
+            ~StageRunner();
+            ///< Aborts and waits for the worker threads.
+
+            void abort();
+            ///< Stop claiming new steps. Steps that are already running will be finished.
+
+            int poll (Messages& messages, int timeout);
+            ///< Wait up to \a timeout milliseconds for progress and append the messages that are
+            /// ready to be reported to \a messages.
+            ///
+            /// \return Number of steps completed so far
+
+            bool isDone();
+            ///< All workers have finished (either because all steps have been performed or
+            /// because the run has been aborted) and all messages have been passed on by poll.
+
+            bool hasFailed();
+            ///< Has a step thrown an exception?
+
+            double getStageTime (int stage);
+            ///< Seconds spent performing the steps of \a stage, summed over all threads.
+    };
+}
+
+#endif
@@ -2,6 +2,8 @@
 
 #include <sstream>
 
+#include "compiledfilter.hpp"
+
 CSMFilter::AndNode::AndNode (const std::vector<boost::shared_ptr<Node> >& nodes)
 : NAryNode (nodes, "and")
 {}
@@ -17,3 +19,15 @@ bool CSMFilter::AndNode::test (const CSMWorld::IdTableBase& table, int row,
 
     return true;
 }
+
+void CSMFilter::AndNode::compile (CompiledFilter& filter) const
+{
+    filter.beginGroup (CompiledFilter::Op_And);
+
+    int size = getSize();
+
+    for (int i=0; i<size; ++i)
+        (*this)[i].compile (filter);
+
+    filter.endGroup();
+}
@@ -15,6 +15,9 @@ namespace CSMFilter
                 const std::map<int, int>& columns) const;
             ///< \return Can the specified table row pass through to filter?
             /// \param columns column ID to column index mapping
+
+            virtual void compile (CompiledFilter& filter) const;
+            ///< Append the instructions for this node to \a filter.
     };
 }
 
@@ -1,5 +1,7 @@
 #include "booleannode.hpp"
 
+#include "compiledfilter.hpp"
+
 CSMFilter::BooleanNode::BooleanNode (bool true_) : mTrue (true_) {}
 
 bool CSMFilter::BooleanNode::test (const CSMWorld::IdTableBase& table, int row,
@@ -8,6 +10,11 @@ bool CSMFilter::BooleanNode::test (const CSMWorld::IdTableBase& table, int row,
     return mTrue;
 }
 
+void CSMFilter::BooleanNode::compile (CompiledFilter& filter) const
+{
+    filter.addBoolean (mTrue);
+}
+
 std::string CSMFilter::BooleanNode::toString (bool numericColumns) const
 {
     return mTrue ? "true" : "false";
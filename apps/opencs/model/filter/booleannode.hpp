@@ -18,6 +18,9 @@ namespace CSMFilter
             ///< \return Can the specified table row pass through to filter?
             /// \param columns column ID to column index mapping
 
+            virtual void compile (CompiledFilter& filter) const;
+            ///< Append the instructions for this node to \a filter.
+
             virtual std::string toString (bool numericColumns) const;
             ///< Return a string that represents this node.
             ///
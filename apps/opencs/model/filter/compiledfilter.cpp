@@ -0,0 +1,297 @@
+#include "compiledfilter.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "../world/columns.hpp"
+#include "../world/idtablebase.hpp"
+
+#include "node.hpp"
+
+namespace
+{
+    void testChunk (const CSMFilter::CompiledFilter *filter, const CSMWorld::IdTableBase *table,
+        int begin, int end, std::vector<char> *result, char *failed)
+    {
+        try
+        {
+            filter->test (*table, begin, end, *result);
+        }
+        catch (...)
+        {
+            // the chunk is repeated on the calling thread, which will report the error
+            *failed = 1;
+        }
+    }
+}
+
+CSMFilter::CompiledFilter::CompiledFilter (const Node& node, const std::map<int, int>& columns)
+: mColumns (columns)
+{
+    node.compile (*this);
+
+    if (!mGroups.empty())
+        throw std::logic_error ("unterminated group in compiled filter");
+}
+
+int CSMFilter::CompiledFilter::getColumnIndex (int columnId, const char *node) const
+{
+    std::map<int, int>::const_iterator iter = mColumns.find (columnId);
+
+    if (iter==mColumns.end())
+        throw std::logic_error (std::string ("invalid column in ") + node + " node");
+
+    return iter->second;
+}
+
+CSMFilter::CompiledFilter::Instruction& CSMFilter::CompiledFilter::addInstruction (OpCode opCode)
+{
+    Instruction instruction;
+    instruction.mOpCode = opCode;
+    instruction.mSize = 1;
+    instruction.mColumn = -1;
+    instruction.mText = -1;
+    instruction.mValue = false;
+    instruction.mLower = 0;
+    instruction.mUpper = 0;
+    instruction.mLowerType = ValueNode::Type_Infinite;
+    instruction.mUpperType = ValueNode::Type_Infinite;
+
+    mInstructions.push_back (instruction);
+
+    return mInstructions.back();
+}
+
+void CSMFilter::CompiledFilter::addBoolean (bool value)
+{
+    addInstruction (Op_Boolean).mValue = value;
+}
+
+void CSMFilter::CompiledFilter::addText (int columnId, const std::string& text)
+{
+    CSMWorld::Columns::ColumnId id = static_cast<CSMWorld::Columns::ColumnId> (columnId);
+
+    Text compiled;
+
+    /// \todo make pattern syntax configurable
+    compiled.mRegExp = QRegExp (QString::fromUtf8 (text.c_str()), Qt::CaseInsensitive);
+
+    // build the pattern now, so that copies made for other threads share it
+    compiled.mRegExp.isValid();
+
+    compiled.mEmpty = text.empty();
+    compiled.mHasEnums = CSMWorld::Columns::hasEnums (id);
+
+    if (compiled.mHasEnums)
+    {
+        std::vector<std::string> enums = CSMWorld::Columns::getEnums (id);
+
+        for (std::vector<std::string>::const_iterator iter (enums.begin()); iter!=enums.end();
+            ++iter)
+            compiled.mEnums.push_back (QString::fromUtf8 (iter->c_str()));
+    }
+
+    int column = getColumnIndex (columnId, "text");
+
+    mTexts.push_back (compiled);
+
+    Instruction& instruction = addInstruction (Op_Text);
+    instruction.mColumn = column;
+    instruction.mText = mTexts.size()-1;
+}
+
+void CSMFilter::CompiledFilter::addValue (int columnId, ValueNode::Type lowerType,
+    ValueNode::Type upperType, double lower, double upper)
+{
+    int column = getColumnIndex (columnId, "value");
+
+    Instruction& instruction = addInstruction (Op_Value);
+    instruction.mColumn = column;
+    instruction.mLower = lower;
+    instruction.mUpper = upper;
+    instruction.mLowerType = lowerType;
+    instruction.mUpperType = upperType;
+}
+
+void CSMFilter::CompiledFilter::beginGroup (OpCode opCode)
+{
+    if (opCode!=Op_And && opCode!=Op_Or && opCode!=Op_Not)
+        throw std::logic_error ("invalid group in compiled filter");
+
+    mGroups.push_back (mInstructions.size());
+    addInstruction (opCode);
+}
+
+void CSMFilter::CompiledFilter::endGroup()
+{
+    if (mGroups.empty())
+        throw std::logic_error ("unbalanced group in compiled filter");
+
+    int group = mGroups.back();
+    mGroups.pop_back();
+
+    mInstructions[group].mSize = mInstructions.size()-group;
+}
+
+bool CSMFilter::CompiledFilter::test (const CSMWorld::IdTableBase& table, int row,
+    int index) const
+{
+    const Instruction& instruction = mInstructions[index];
+
+    switch (instruction.mOpCode)
+    {
+        case Op_Boolean: return instruction.mValue;
+        case Op_Text: return testText (table, row, instruction);
+        case Op_Value: return testValue (table, row, instruction);
+
+        case Op_And:
+        {
+            int end = index + instruction.mSize;
+
+            for (int child = index+1; child<end; child += mInstructions[child].mSize)
+                if (!test (table, row, child))
+                    return false;
+
+            return true;
+        }
+
+        case Op_Or:
+        {
+            int end = index + instruction.mSize;
+
+            for (int child = index+1; child<end; child += mInstructions[child].mSize)
+                if (test (table, row, child))
+                    return true;
+
+            return false;
+        }
+
+        case Op_Not: return !test (table, row, index+1);
+    }
+
+    throw std::logic_error ("invalid instruction in compiled filter");
+}
+
+bool CSMFilter::CompiledFilter::testText (const CSMWorld::IdTableBase& table, int row,
+    const Instruction& instruction) const
+{
+    if (instruction.mColumn==-1)
+        return true;
+
+    const Text& text = mTexts[instruction.mText];
+
+    QVariant data = table.getRecordData (row, instruction.mColumn);
+
+    QString string;
+
+    if (data.type()==QVariant::String)
+    {
+        string = data.toString();
+    }
+    else if ((data.type()==QVariant::Int || data.type()==QVariant::UInt) && text.mHasEnums)
+    {
+        int value = data.toInt();
+
+        if (value>=0 && value<static_cast<int> (text.mEnums.size()))
+            string = text.mEnums[value];
+    }
+    else if (data.type()==QVariant::Bool)
+    {
+        string = data.toBool() ? "true" : "false";
+    }
+    else if (text.mEmpty && !data.isValid())
+        return true;
+    else
+        return false;
+
+    return text.mRegExp.exactMatch (string);
+}
+
+bool CSMFilter::CompiledFilter::testValue (const CSMWorld::IdTableBase& table, int row,
+    const Instruction& instruction) const
+{
+    if (instruction.mColumn==-1)
+        return true;
+
+    QVariant data = table.getRecordData (row, instruction.mColumn);
+
+    if (data.type()!=QVariant::Double && data.type()!=QVariant::Bool && data.type()!=QVariant::Int &&
+        data.type()!=QVariant::UInt && data.type()!=static_cast<QVariant::Type> (QMetaType::Float))
+        return false;
+
+    double value = data.toDouble();
+
+    switch (instruction.mLowerType)
+    {
+        case ValueNode::Type_Closed: if (value<instruction.mLower) return false; break;
+        case ValueNode::Type_Open: if (value<=instruction.mLower) return false; break;
+        case ValueNode::Type_Infinite: break;
+    }
+
+    switch (instruction.mUpperType)
+    {
+        case ValueNode::Type_Closed: if (value>instruction.mUpper) return false; break;
+        case ValueNode::Type_Open: if (value>=instruction.mUpper) return false; break;
+        case ValueNode::Type_Infinite: break;
+    }
+
+    return true;
+}
+
+bool CSMFilter::CompiledFilter::test (const CSMWorld::IdTableBase& table, int row) const
+{
+    if (mInstructions.empty())
+        return true;
+
+    return test (table, row, 0);
+}
+
+void CSMFilter::CompiledFilter::test (const CSMWorld::IdTableBase& table, int begin, int end,
+    std::vector<char>& result) const
+{
+    for (int row = begin; row<end; ++row)
+        result[row] = test (table, row);
+}
+
+void CSMFilter::CompiledFilter::testAll (const CSMWorld::IdTableBase& table,
+    std::vector<char>& result) const
+{
+    int rows = table.rowCount();
+
+    result.resize (rows);
+
+    int threads = boost::thread::hardware_concurrency();
+
+    if (rows<sParallelRows || threads<2)
+    {
+        test (table, 0, rows, result);
+        return;
+    }
+
+    // each thread needs its own copy, because matching a regular expression is not thread-safe
+    std::vector<CompiledFilter> filters (threads, *this);
+    std::vector<char> failed (threads, 0);
+
+    int chunk = (rows + threads - 1) / threads;
+
+    boost::thread_group group;
+
+    for (int i=0; i<threads; ++i)
+    {
+        int begin = i * chunk;
+        int end = std::min (begin + chunk, rows);
+
+        if (begin<end)
+            group.create_thread (boost::bind (&testChunk, &filters[i], &table, begin, end,
+                &result, &failed[i]));
+    }
+
+    group.join_all();
+
+    for (int i=0; i<threads; ++i)
+        if (failed[i])
+            test (table, i * chunk, std::min ((i+1) * chunk, rows), result);
+}
@@ -0,0 +1,127 @@
+#ifndef CSM_FILTER_COMPILEDFILTER_H
+#define CSM_FILTER_COMPILEDFILTER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <QRegExp>
+#include <QString>
+
+#include "valuenode.hpp"
+
+namespace CSMWorld
+{
+    class IdTableBase;
+}
+
+namespace CSMFilter
+{
+    class Node;
+
+    /// \brief Filter node tree compiled against the columns of a specific table
+    ///
+    /// Column indices, regular expressions and enum names are resolved once when the filter is
+    /// compiled instead of for every row that is tested. The node tree is flattened into a list of
+    /// instructions in prefix order.
+    ///
+    /// \note Testing modifies the match state of the regular expressions. A single instance must
+    /// not be used from multiple threads at the same time; use copies instead.
+    class CompiledFilter
+    {
+        public:
+
+            enum OpCode
+            {
+                Op_Boolean,
+                Op_Text,
+                Op_Value,
+                Op_And,
+                Op_Or,
+                Op_Not
+            };
+
+            /// Tables with at least this many rows are tested on multiple threads.
+            static const int sParallelRows = 50000;
+
+        private:
+
+            struct Instruction
+            {
+                OpCode mOpCode;
+                int mSize; // number of instructions in this sub-tree, including this one
+                int mColumn; // column index in the table, -1 if the table does not have the column
+                int mText; // index into mTexts
+                bool mValue;
+                double mLower;
+                double mUpper;
+                ValueNode::Type mLowerType;
+                ValueNode::Type mUpperType;
+            };
+
+            struct Text
+            {
+                QRegExp mRegExp;
+                bool mEmpty;
+                bool mHasEnums;
+                std::vector<QString> mEnums;
+            };
+
+            std::map<int, int> mColumns;
+            std::vector<Instruction> mInstructions;
+            std::vector<Text> mTexts;
+            std::vector<int> mGroups; // instructions of groups that have not been ended yet
+
+            int getColumnIndex (int columnId, const char *node) const;
+
+            Instruction& addInstruction (OpCode opCode);
+
+            bool test (const CSMWorld::IdTableBase& table, int row, int instruction) const;
+
+            bool testText (const CSMWorld::IdTableBase& table, int row,
+                const Instruction& instruction) const;
+
+            bool testValue (const CSMWorld::IdTableBase& table, int row,
+                const Instruction& instruction) const;
+
+        public:
+
+            CompiledFilter (const Node& node, const std::map<int, int>& columns);
+            ///< \param columns column ID to column index mapping (must contain all columns
+            /// referenced by \a node)
+
+            /// \name Compilation
+            ///
+            /// Used by the nodes to append their instructions.
+            ///@{
+
+            void addBoolean (bool value);
+
+            void addText (int columnId, const std::string& text);
+
+            void addValue (int columnId, ValueNode::Type lowerType, ValueNode::Type upperType,
+                double lower, double upper);
+
+            void beginGroup (OpCode opCode);
+            ///< Start a group (and, or, not). All instructions added until the matching endGroup
+            /// call are children of the group.
+
+            void endGroup();
+
+            ///@}
+
+            bool test (const CSMWorld::IdTableBase& table, int row) const;
+            ///< \return Can the specified table row pass through to filter?
+
+            void test (const CSMWorld::IdTableBase& table, int begin, int end,
+                std::vector<char>& result) const;
+            ///< Test the rows [begin, end) and store the results at the same indices in \a result
+            /// (which must be large enough already).
+
+            void testAll (const CSMWorld::IdTableBase& table, std::vector<char>& result) const;
+            ///< Test all rows of \a table. Tables with at least sParallelRows rows are split into
+            /// chunks that are tested on multiple threads.
+    };
+}
+
+#endif
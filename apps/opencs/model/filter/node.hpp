@@ -16,6 +16,8 @@ namespace CSMWorld
 
 namespace CSMFilter
 {
+    class CompiledFilter;
+
     /// \brief Root class for the filter node hierarchy
     ///
     /// \note When the function documentation for this class mentions "this node", this should be
@@ -37,6 +39,9 @@ namespace CSMFilter
             ///< \return Can the specified table row pass through to filter?
             /// \param columns column ID to column index mapping
 
+            virtual void compile (CompiledFilter& filter) const = 0;
+            ///< Append the instructions for this node to \a filter.
+
             virtual std::vector<int> getReferencedColumns() const = 0;
             ///< Return a list of the IDs of the columns referenced by this node. The column mapping
             /// passed into test as columns must contain all columns listed here.
@@ -1,5 +1,7 @@
 #include "notnode.hpp"
 
+#include "compiledfilter.hpp"
+
 CSMFilter::NotNode::NotNode (boost::shared_ptr<Node> child) : UnaryNode (child, "not") {}
 
 bool CSMFilter::NotNode::test (const CSMWorld::IdTableBase& table, int row,
@@ -7,3 +9,10 @@ bool CSMFilter::NotNode::test (const CSMWorld::IdTableBase& table, int row,
 {
     return !getChild().test (table, row, columns);
 }
+
+void CSMFilter::NotNode::compile (CompiledFilter& filter) const
+{
+    filter.beginGroup (CompiledFilter::Op_Not);
+    getChild().compile (filter);
+    filter.endGroup();
+}
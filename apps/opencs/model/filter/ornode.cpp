@@ -2,6 +2,8 @@
 
 #include <sstream>
 
+#include "compiledfilter.hpp"
+
 CSMFilter::OrNode::OrNode (const std::vector<boost::shared_ptr<Node> >& nodes)
 : NAryNode (nodes, "or")
 {}
@@ -17,3 +19,15 @@ bool CSMFilter::OrNode::test (const CSMWorld::IdTableBase& table, int row,
 
     return false;
 }
+
+void CSMFilter::OrNode::compile (CompiledFilter& filter) const
+{
+    filter.beginGroup (CompiledFilter::Op_Or);
+
+    int size = getSize();
+
+    for (int i=0; i<size; ++i)
+        (*this)[i].compile (filter);
+
+    filter.endGroup();
+}
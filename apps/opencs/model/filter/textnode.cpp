@@ -8,6 +8,8 @@
 #include "../world/columns.hpp"
 #include "../world/idtablebase.hpp"
 
+#include "compiledfilter.hpp"
+
 CSMFilter::TextNode::TextNode (int columnId, const std::string& text)
 : mColumnId (columnId), mText (text)
 {}
@@ -59,6 +61,11 @@ bool CSMFilter::TextNode::test (const CSMWorld::IdTableBase& table, int row,
     return regExp.exactMatch (string);
 }
 
+void CSMFilter::TextNode::compile (CompiledFilter& filter) const
+{
+    filter.addText (mColumnId, mText);
+}
+
 std::vector<int> CSMFilter::TextNode::getReferencedColumns() const
 {
     return std::vector<int> (1, mColumnId);
@@ -19,6 +19,9 @@ namespace CSMFilter
             ///< \return Can the specified table row pass through to filter?
             /// \param columns column ID to column index mapping
 
+            virtual void compile (CompiledFilter& filter) const;
+            ///< Append the instructions for this node to \a filter.
+
             virtual std::vector<int> getReferencedColumns() const;
             ///< Return a list of the IDs of the columns referenced by this node. The column mapping
             /// passed into test as columns must contain all columns listed here.
@@ -6,6 +6,8 @@
 #include "../world/columns.hpp"
 #include "../world/idtablebase.hpp"
 
+#include "compiledfilter.hpp"
+
 CSMFilter::ValueNode::ValueNode (int columnId, Type lowerType, Type upperType,
     double lower, double upper)
 : mColumnId (columnId), mLower (lower), mUpper (upper), mLowerType (lowerType), mUpperType (upperType){}
@@ -48,6 +50,11 @@ bool CSMFilter::ValueNode::test (const CSMWorld::IdTableBase& table, int row,
     return true;
 }
 
+void CSMFilter::ValueNode::compile (CompiledFilter& filter) const
+{
+    filter.addValue (mColumnId, mLowerType, mUpperType, mLower, mUpper);
+}
+
 std::vector<int> CSMFilter::ValueNode::getReferencedColumns() const
 {
     return std::vector<int> (1, mColumnId);
@@ -149,3 +149,8 @@ void CSMTools::PathgridCheckStage::perform (int stage, CSMDoc::Messages& message
 
     // TODO: check whether there are disconnected graphs
 }
+
+bool CSMTools::PathgridCheckStage::isReentrant() const
+{
+    return true;
+}
@@ -34,6 +34,8 @@ namespace CSMTools
         virtual int setup();
 
         virtual void perform (int stage, CSMDoc::Messages& messages);
+
+        virtual bool isReentrant() const;
     };
 }
 
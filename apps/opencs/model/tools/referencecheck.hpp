@@ -17,6 +17,8 @@ namespace CSMTools
             virtual void perform(int stage, CSMDoc::Messages& messages);
             virtual int setup();
 
+            virtual bool isReentrant() const;
+
         private:
             const CSMWorld::RefCollection& mReferences;
             const CSMWorld::RefIdCollection& mReferencables;
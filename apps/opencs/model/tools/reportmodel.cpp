@@ -163,6 +163,11 @@ const CSMWorld::UniversalId& CSMTools::ReportModel::getUniversalId (int row) con
     return mRows.at (row).mId;
 }
 
+const CSMDoc::Message& CSMTools::ReportModel::getMessage (int row) const
+{
+    return mRows.at (row);
+}
+
 std::string CSMTools::ReportModel::getHint (int row) const
 {
     return mRows.at (row).mHint;
@@ -49,6 +49,8 @@ namespace CSMTools
                 
             const CSMWorld::UniversalId& getUniversalId (int row) const;
 
+            const CSMDoc::Message& getMessage (int row) const;
+
             std::string getHint (int row) const;
 
             void clear();
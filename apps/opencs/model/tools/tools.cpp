@@ -58,8 +58,13 @@ CSMDoc::OperationHolder *CSMTools::Tools::getVerifier()
 
         mVerifierOperation->configureSettings (settings);
 
+        // the checks only read the document, so they can run on all cores
+        mVerifierOperation->setParallel (mVerifierThreads);
+
         connect (&mVerifier, SIGNAL (progress (int, int, int)), this, SIGNAL (progress (int, int, int)));
         connect (&mVerifier, SIGNAL (done (int, bool)), this, SIGNAL (done (int, bool)));
+        connect (&mVerifier, SIGNAL (stageTiming (const std::string&, int, double, int)),
+            this, SIGNAL (stageTiming (const std::string&, int, double, int)));
         connect (&mVerifier, SIGNAL (reportMessage (const CSMDoc::Message&, int)),
             this, SLOT (verifierMessage (const CSMDoc::Message&, int)));
 
@@ -124,7 +129,8 @@ CSMDoc::OperationHolder *CSMTools::Tools::getVerifier()
 
 CSMTools::Tools::Tools (CSMDoc::Document& document, ToUTF8::FromType encoding)
 : mDocument (document), mData (document.getData()), mVerifierOperation (0),
-  mSearchOperation (0), mMergeOperation (0), mNextReportNumber (0), mEncoding (encoding)
+  mSearchOperation (0), mMergeOperation (0), mNextReportNumber (0), mEncoding (encoding),
+  mVerifierThreads (0)
 {
     // index 0: load error log
     mReports.insert (std::make_pair (mNextReportNumber++, new ReportModel));
@@ -132,11 +138,15 @@ CSMTools::Tools::Tools (CSMDoc::Document& document, ToUTF8::FromType encoding)
 
     connect (&mSearch, SIGNAL (progress (int, int, int)), this, SIGNAL (progress (int, int, int)));
     connect (&mSearch, SIGNAL (done (int, bool)), this, SIGNAL (done (int, bool)));
+    connect (&mSearch, SIGNAL (stageTiming (const std::string&, int, double, int)),
+        this, SIGNAL (stageTiming (const std::string&, int, double, int)));
     connect (&mSearch, SIGNAL (reportMessage (const CSMDoc::Message&, int)),
         this, SLOT (verifierMessage (const CSMDoc::Message&, int)));
 
     connect (&mMerge, SIGNAL (progress (int, int, int)), this, SIGNAL (progress (int, int, int)));
     connect (&mMerge, SIGNAL (done (int, bool)), this, SIGNAL (done (int, bool)));
+    connect (&mMerge, SIGNAL (stageTiming (const std::string&, int, double, int)),
+        this, SIGNAL (stageTiming (const std::string&, int, double, int)));
     // don't need to connect report message, since there are no messages for merge
 }
 
@@ -246,6 +256,14 @@ int CSMTools::Tools::getRunningOperations() const
     return result;
 }
 
+void CSMTools::Tools::setVerifierThreads (int threads)
+{
+    mVerifierThreads = threads;
+
+    if (mVerifierOperation)
+        mVerifierOperation->setParallel (threads);
+}
+
 CSMTools::ReportModel *CSMTools::Tools::getReport (const CSMWorld::UniversalId& id)
 {
     if (id.getType()!=CSMWorld::UniversalId::Type_VerificationResults &&
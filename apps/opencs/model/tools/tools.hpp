@@ -47,6 +47,7 @@ namespace CSMTools
             int mNextReportNumber;
             std::map<int, int> mActiveReports; // type, report number
             ToUTF8::FromType mEncoding;
+            int mVerifierThreads;
 
             // not implemented
             Tools (const Tools&);
@@ -84,6 +85,11 @@ namespace CSMTools
 
             int getRunningOperations() const;
 
+            /// Number of threads used by the verifier (0: one per core).
+            ///
+            /// \attention Do not call this function while the verifier is running.
+            void setVerifierThreads (int threads);
+
             ReportModel *getReport (const CSMWorld::UniversalId& id);
             ///< The ownership of the returned report is not transferred.
 
@@ -97,6 +103,8 @@ namespace CSMTools
 
             void done (int type, bool failed);
 
+            void stageTiming (const std::string& stage, int steps, double seconds, int type);
+
             /// \attention When this signal is emitted, *this hands over the ownership of the
             /// document. This signal must be handled to avoid a leak.
             void mergeDone (CSMDoc::Document *document);
@@ -16,6 +16,7 @@
 #include "columnbase.hpp"
 
 #include "collectionbase.hpp"
+#include "rowindex.hpp"
 
 namespace CSMWorld
 {
@@ -51,7 +52,8 @@ namespace CSMWorld
         private:
 
             std::vector<std::unique_ptr<Record<ESXRecordT> > > mRecords;
-            std::map<std::string, int> mIndex;
+            std::map<std::string, RowIndex::Handle> mIndex;
+            RowIndex mRows; // keeps track of the row of each entry in mIndex
             std::vector<Column<ESXRecordT> *> mColumns;
 
             // not implemented
@@ -189,10 +191,7 @@ namespace CSMWorld
             std::move (buffer.begin(), buffer.end(), mRecords.begin()+baseIndex);
 
             // adjust index
-            for (std::map<std::string, int>::iterator iter (mIndex.begin()); iter!=mIndex.end();
-                 ++iter)
-                if (iter->second>=baseIndex && iter->second<baseIndex+size)
-                    iter->second = newOrder.at (iter->second-baseIndex)+baseIndex;
+            mRows.reorder (baseIndex, newOrder);
         }
 
         return true;
@@ -227,7 +226,7 @@ namespace CSMWorld
     {
         std::string id = Misc::StringUtils::lowerCase (IdAccessorT().getId (record));
 
-        std::map<std::string, int>::iterator iter = mIndex.find (id);
+        std::map<std::string, RowIndex::Handle>::iterator iter = mIndex.find (id);
 
         if (iter==mIndex.end())
         {
@@ -239,7 +238,7 @@ namespace CSMWorld
         }
         else
         {
-            mRecords[iter->second]->setModified (record);
+            mRecords[mRows.getRow (iter->second)]->setModified (record);
         }
     }
 
@@ -331,27 +330,17 @@ namespace CSMWorld
     template<typename ESXRecordT, typename IdAccessorT>
     void Collection<ESXRecordT, IdAccessorT>::removeRows (int index, int count)
     {
-        mRecords.erase (mRecords.begin()+index, mRecords.begin()+index+count);
-
-        typename std::map<std::string, int>::iterator iter = mIndex.begin();
-
-        while (iter!=mIndex.end())
+        for (int i=index; i<index+count; ++i)
         {
-            if (iter->second>=index)
-            {
-                if (iter->second>=index+count)
-                {
-                    iter->second -= count;
-                    ++iter;
-                }
-                else
-                {
-                    mIndex.erase (iter++);
-                }
-            }
-            else
-                ++iter;
+            std::map<std::string, RowIndex::Handle>::iterator iter = mIndex.find (
+                Misc::StringUtils::lowerCase (IdAccessorT().getId (mRecords.at (i)->get())));
+
+            if (iter!=mIndex.end() && iter->second==mRows.getHandle (i))
+                mIndex.erase (iter);
         }
+
+        mRecords.erase (mRecords.begin()+index, mRecords.begin()+index+count);
+        mRows.erase (index, count);
     }
 
     template<typename ESXRecordT, typename IdAccessorT>
@@ -374,12 +363,12 @@ namespace CSMWorld
     {
         std::string id2 = Misc::StringUtils::lowerCase(id);
 
-        std::map<std::string, int>::const_iterator iter = mIndex.find (id2);
+        std::map<std::string, RowIndex::Handle>::const_iterator iter = mIndex.find (id2);
 
         if (iter==mIndex.end())
             return -1;
 
-        return iter->second;
+        return mRows.getRow (iter->second);
     }
 
     template<typename ESXRecordT, typename IdAccessorT>
@@ -410,11 +399,13 @@ namespace CSMWorld
     {
         std::vector<std::string> ids;
 
-        for (typename std::map<std::string, int>::const_iterator iter = mIndex.begin();
+        for (std::map<std::string, RowIndex::Handle>::const_iterator iter = mIndex.begin();
             iter!=mIndex.end(); ++iter)
         {
-            if (listDeleted || !mRecords[iter->second]->isDeleted())
-                ids.push_back (IdAccessorT().getId (mRecords[iter->second]->get()));
+            const Record<ESXRecordT>& record = *mRecords[mRows.getRow (iter->second)];
+
+            if (listDeleted || !record.isDeleted())
+                ids.push_back (IdAccessorT().getId (record.get()));
         }
 
         return ids;
@@ -449,16 +440,8 @@ namespace CSMWorld
         else
             mRecords.insert (mRecords.begin()+index, std::move(record2));
 
-        if (index < size-1)
-        {
-            for (std::map<std::string, int>::iterator iter (mIndex.begin()); iter!=mIndex.end(); ++iter)
-            {
-                if (iter->second >= index)
-                    ++(iter->second);
-            }
-        }
-
-        mIndex.insert (std::make_pair (lowerId, index));
+        // the rows of the following records are shifted implicitly
+        mIndex.insert (std::make_pair (lowerId, mRows.insert (index)));
     }
 
     template<typename ESXRecordT, typename IdAccessorT>
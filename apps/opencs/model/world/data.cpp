@@ -6,6 +6,7 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
 
 #include <QAbstractItemModel>
 
@@ -26,6 +27,8 @@
 #include "resourcetable.hpp"
 #include "nestedcoladapterimp.hpp"
 #include "npcautocalc.hpp"
+#include "recordpreloader.hpp"
+#include "stagedrecord.hpp"
 
 void CSMWorld::Data::addModel (QAbstractItemModel *model, UniversalId::Type type, bool update)
 {
@@ -68,9 +71,9 @@ int CSMWorld::Data::count (RecordBase::State state, const CollectionBase& collec
 }
 
 CSMWorld::Data::Data (ToUTF8::FromType encoding, const ResourcesManager& resourcesManager)
-: mEncoder (encoding), mPathgrids (mCells), mReferenceables (self()), mRefs (mCells),
-  mResourcesManager (resourcesManager), mReader (0), mDialogue (0), mReaderIndex(0),
-  mNpcAutoCalc (0)
+: mEncoding (encoding), mEncoder (encoding), mPathgrids (mCells), mReferenceables (self()),
+  mRefs (mCells), mResourcesManager (resourcesManager), mReader (0), mDialogue (0),
+  mReaderIndex(0), mNpcAutoCalc (0), mPreloader (0)
 {
     int index = 0;
 
@@ -572,6 +575,9 @@ CSMWorld::Data::Data (ToUTF8::FromType encoding, const ResourcesManager& resourc
 
 CSMWorld::Data::~Data()
 {
+    // the worker threads of the preloader access the collections
+    delete mPreloader;
+
     for (std::vector<QAbstractItemModel *>::iterator iter (mModels.begin()); iter!=mModels.end(); ++iter)
         delete *iter;
 
@@ -929,6 +935,9 @@ int CSMWorld::Data::getTotalRecords (const std::vector<boost::filesystem::path>&
 
 int CSMWorld::Data::startLoading (const boost::filesystem::path& path, bool base, bool project)
 {
+    delete mPreloader;
+    mPreloader = 0;
+
     // Don't delete the Reader yet. Some record types store a reference to the Reader to handle on-demand loading
     boost::shared_ptr<ESM::ESMReader> ptr(mReader);
     mReaders.push_back(ptr);
@@ -998,6 +1007,10 @@ int CSMWorld::Data::startLoading (const boost::filesystem::path& path, bool base
                     Record<MetaData> (RecordBase::State_ModifiedOnly, 0, &metaData)));
     }
 
+    if (!(isTes4 || isTes5 || isFONV) && mReader->getRecordCount()>=RecordPreloader::sMinRecords &&
+        boost::thread::hardware_concurrency()>1)
+        startPreloading (path);
+
     return mReader->getRecordCount();
 }
 
@@ -1031,6 +1044,9 @@ bool CSMWorld::Data::continueLoading (CSMDoc::Messages& messages)
 
         mReader = 0;
 
+        delete mPreloader;
+        mPreloader = 0;
+
         mDialogue = 0;
         return true;
     }
@@ -1041,6 +1057,17 @@ bool CSMWorld::Data::continueLoading (CSMDoc::Messages& messages)
     ESM::NAME n = mReader->getRecName();
     mReader->getRecHeader();
 
+    if (mPreloader)
+    {
+        if (std::unique_ptr<StagedRecord> record = mPreloader->next (n))
+        {
+            // already read by a worker thread
+            mReader->skipRecord();
+            record->add (mBase);
+            return false;
+        }
+    }
+
     bool unhandledRecord = false;
 
     switch (n.val)
@@ -1219,6 +1246,107 @@ bool CSMWorld::Data::continueLoading (CSMDoc::Messages& messages)
     return false;
 }
 
+CSMWorld::StagedRecord *CSMWorld::Data::createStagedRecord (const ESM::NAME& name)
+{
+    switch (name.val)
+    {
+        case ESM::REC_GLOB: return new StagedIdRecord<IdCollection<ESM::Global> > (mGlobals);
+        case ESM::REC_GMST: return new StagedIdRecord<IdCollection<ESM::GameSetting> > (mGmsts);
+        case ESM::REC_SKIL: return new StagedIdRecord<IdCollection<ESM::Skill> > (mSkills);
+        case ESM::REC_CLAS: return new StagedIdRecord<IdCollection<ESM::Class> > (mClasses);
+        case ESM::REC_FACT: return new StagedIdRecord<NestedIdCollection<ESM::Faction> > (mFactions);
+        case ESM::REC_RACE: return new StagedIdRecord<NestedIdCollection<ESM::Race> > (mRaces);
+        case ESM::REC_SOUN: return new StagedIdRecord<IdCollection<ESM::Sound> > (mSounds);
+        case ESM::REC_SCPT: return new StagedIdRecord<IdCollection<ESM::Script> > (mScripts);
+        case ESM::REC_REGN: return new StagedIdRecord<NestedIdCollection<ESM::Region> > (mRegions);
+        case ESM::REC_BSGN:
+            return new StagedIdRecord<NestedIdCollection<ESM::BirthSign> > (mBirthsigns);
+        case ESM::REC_SPEL: return new StagedIdRecord<NestedIdCollection<ESM::Spell> > (mSpells);
+        case ESM::REC_ENCH:
+            return new StagedIdRecord<NestedIdCollection<ESM::Enchantment> > (mEnchantments);
+        case ESM::REC_BODY: return new StagedIdRecord<IdCollection<ESM::BodyPart> > (mBodyParts);
+        case ESM::REC_SNDG:
+            return new StagedIdRecord<IdCollection<ESM::SoundGenerator> > (mSoundGens);
+        case ESM::REC_MGEF:
+            return new StagedIdRecord<IdCollection<ESM::MagicEffect> > (mMagicEffects);
+        case ESM::REC_SSCR:
+            return new StagedIdRecord<IdCollection<ESM::StartScript> > (mStartScripts);
+
+        case ESM::REC_ACTI:
+            return new StagedRefIdRecord<ESM::Activator> (mReferenceables, UniversalId::Type_Activator);
+        case ESM::REC_ALCH:
+            return new StagedRefIdRecord<ESM::Potion> (mReferenceables, UniversalId::Type_Potion);
+        case ESM::REC_APPA:
+            return new StagedRefIdRecord<ESM::Apparatus> (mReferenceables, UniversalId::Type_Apparatus);
+        case ESM::REC_ARMO:
+            return new StagedRefIdRecord<ESM::Armor> (mReferenceables, UniversalId::Type_Armor);
+        case ESM::REC_BOOK:
+            return new StagedRefIdRecord<ESM::Book> (mReferenceables, UniversalId::Type_Book);
+        case ESM::REC_CLOT:
+            return new StagedRefIdRecord<ESM::Clothing> (mReferenceables, UniversalId::Type_Clothing);
+        case ESM::REC_CONT:
+            return new StagedRefIdRecord<ESM::Container> (mReferenceables, UniversalId::Type_Container);
+        case ESM::REC_CREA:
+            return new StagedRefIdRecord<ESM::Creature> (mReferenceables, UniversalId::Type_Creature);
+        case ESM::REC_DOOR:
+            return new StagedRefIdRecord<ESM::Door> (mReferenceables, UniversalId::Type_Door);
+        case ESM::REC_INGR:
+            return new StagedRefIdRecord<ESM::Ingredient> (mReferenceables, UniversalId::Type_Ingredient);
+        case ESM::REC_LEVC:
+            return new StagedRefIdRecord<ESM::CreatureLevList> (mReferenceables,
+                UniversalId::Type_CreatureLevelledList);
+        case ESM::REC_LEVI:
+            return new StagedRefIdRecord<ESM::ItemLevList> (mReferenceables,
+                UniversalId::Type_ItemLevelledList);
+        case ESM::REC_LIGH:
+            return new StagedRefIdRecord<ESM::Light> (mReferenceables, UniversalId::Type_Light);
+        case ESM::REC_LOCK:
+            return new StagedRefIdRecord<ESM::Lockpick> (mReferenceables, UniversalId::Type_Lockpick);
+        case ESM::REC_MISC:
+            return new StagedRefIdRecord<ESM::Miscellaneous> (mReferenceables,
+                UniversalId::Type_Miscellaneous);
+        case ESM::REC_NPC_:
+            return new StagedRefIdRecord<ESM::NPC> (mReferenceables, UniversalId::Type_Npc);
+        case ESM::REC_PROB:
+            return new StagedRefIdRecord<ESM::Probe> (mReferenceables, UniversalId::Type_Probe);
+        case ESM::REC_REPA:
+            return new StagedRefIdRecord<ESM::Repair> (mReferenceables, UniversalId::Type_Repair);
+        case ESM::REC_STAT:
+            return new StagedRefIdRecord<ESM::Static> (mReferenceables, UniversalId::Type_Static);
+        case ESM::REC_WEAP:
+            return new StagedRefIdRecord<ESM::Weapon> (mReferenceables, UniversalId::Type_Weapon);
+
+        // Cells, references, dialogues, land and path grids depend on the records in front of them
+        // (or on the reader they have been loaded from) and are read by the loader itself.
+        default:
+
+            return 0;
+    }
+}
+
+void CSMWorld::Data::startPreloading (const boost::filesystem::path& path)
+{
+    mPreloader = new RecordPreloader (path.string(), mReader->getIndex(), mEncoding);
+
+    // find the position of each record
+    ESM::ESMReader reader;
+    reader.setEncoder (&mEncoder);
+    reader.setIndex (mReader->getIndex());
+    reader.open (path.string());
+
+    while (reader.hasMoreRecs())
+    {
+        ESM::NAME name = reader.getRecName();
+        ESM::ESM_Context context = reader.getContext();
+        reader.getRecHeader();
+        reader.skipRecord();
+
+        mPreloader->add (context, name, createStagedRecord (name));
+    }
+
+    mPreloader->start (0);
+}
+
 bool CSMWorld::Data::hasId (const std::string& id) const
 {
     return
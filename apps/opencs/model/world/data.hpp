@@ -27,6 +27,7 @@
 #include <components/esm/loadmgef.hpp>
 #include <components/esm/loadsscr.hpp>
 #include <components/esm/debugprofile.hpp>
+#include <components/esm/esmcommon.hpp>
 #include <components/esm/filter.hpp>
 
 #include <components/to_utf8/to_utf8.hpp>
@@ -67,11 +68,14 @@ namespace CSMWorld
     class ResourcesManager;
     class Resources;
     class NpcAutoCalc;
+    class RecordPreloader;
+    class StagedRecord;
 
     class Data : public QObject
     {
             Q_OBJECT
 
+            ToUTF8::FromType mEncoding;
             ToUTF8::Utf8Encoder mEncoder;
             IdCollection<ESM::Global> mGlobals;
             IdCollection<ESM::GameSetting> mGmsts;
@@ -117,6 +121,8 @@ namespace CSMWorld
 
             NpcAutoCalc *mNpcAutoCalc;
 
+            RecordPreloader *mPreloader;
+
             // not implemented
             Data (const Data&);
             Data& operator= (const Data&);
@@ -132,6 +138,13 @@ namespace CSMWorld
 
             const Data& self ();
 
+            StagedRecord *createStagedRecord (const ESM::NAME& name);
+            ///< \return 0, if records of this type can't be read independently of the records in
+            /// front of them.
+
+            void startPreloading (const boost::filesystem::path& path);
+            ///< Start reading the records of the file that is being loaded on worker threads.
+
             bool loadTes4Group (CSMDoc::Messages& messages);
             bool loadTes4Record (const ESM4::RecordHeader& hdr, CSMDoc::Messages& messages);
 
@@ -18,6 +18,16 @@ namespace CSMWorld
             /// \return Index of loaded record (-1 if no record was loaded)
             int load (ESM::ESMReader& reader, bool base);
 
+            void readRecord (ESXRecordT& record, ESM::ESMReader& reader, bool& isDeleted);
+            ///< Read a record from \a reader without adding it to the collection.
+            ///
+            /// \note Only accesses \a reader and \a record, so records can be read on other threads.
+
+            /// Add a record that has been read by readRecord.
+            ///
+            /// \return Index of loaded record (-1 if no record was loaded)
+            int addLoaded (const ESXRecordT& record, bool isDeleted, bool base);
+
             /// \param index Index at which the record can be found.
             /// Special values: -2 index unknown, -1 record does not exist yet and therefore
             /// does not have an index
@@ -45,8 +55,22 @@ namespace CSMWorld
         ESXRecordT record;
         bool isDeleted = false;
 
+        readRecord (record, reader, isDeleted);
+
+        return addLoaded (record, isDeleted, base);
+    }
+
+    template<typename ESXRecordT, typename IdAccessorT>
+    void IdCollection<ESXRecordT, IdAccessorT>::readRecord (ESXRecordT& record,
+        ESM::ESMReader& reader, bool& isDeleted)
+    {
         loadRecord (record, reader, isDeleted);
+    }
 
+    template<typename ESXRecordT, typename IdAccessorT>
+    int IdCollection<ESXRecordT, IdAccessorT>::addLoaded (const ESXRecordT& record, bool isDeleted,
+        bool base)
+    {
         std::string id = IdAccessorT().getId (record);
         int index = this->searchId (id);
 
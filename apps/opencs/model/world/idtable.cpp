@@ -269,6 +269,11 @@ int CSMWorld::IdTable::getColumnId(int column) const
     return mIdCollection->getColumn(column).getId();
 }
 
+QVariant CSMWorld::IdTable::getRecordData (int row, int column) const
+{
+    return mIdCollection->getData (row, column);
+}
+
 CSMWorld::CollectionBase *CSMWorld::IdTable::idCollection() const
 {
     return mIdCollection;
@@ -86,6 +86,9 @@ namespace CSMWorld
 
             virtual int getColumnId(int column) const;
 
+            /// Return the display value of \a column in \a row directly from the record.
+            virtual QVariant getRecordData (int row, int column) const;
+
         protected:
 
             virtual CollectionBase *idCollection() const;
@@ -6,3 +6,8 @@ unsigned int CSMWorld::IdTableBase::getFeatures() const
 {
     return mFeatures;
 }
+
+QVariant CSMWorld::IdTableBase::getRecordData (int row, int column) const
+{
+    return data (index (row, column));
+}
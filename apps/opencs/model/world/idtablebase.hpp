@@ -61,6 +61,10 @@ namespace CSMWorld
             virtual bool isDeleted (const std::string& id) const = 0;
 
             virtual int getColumnId (int column) const = 0;
+
+            /// Return the display value of \a column in \a row, without going through a model
+            /// index and the role handling of data().
+            virtual QVariant getRecordData (int row, int column) const;
             
             unsigned int getFeatures() const;
     };
@@ -28,6 +28,19 @@ void CSMWorld::IdTableProxyModel::updateColumnMap()
             mColumnMap.insert (std::make_pair (*iter, 
                 mSourceModel->searchColumnIndex (static_cast<CSMWorld::Columns::ColumnId> (*iter))));
     }
+
+    if (mFilter)
+        mCompiledFilter.reset (new CSMFilter::CompiledFilter (*mFilter, mColumnMap));
+    else
+        mCompiledFilter.reset();
+}
+
+void CSMWorld::IdTableProxyModel::updateFilterResults()
+{
+    mFilterResults.clear();
+
+    if (mCompiledFilter && mSourceModel->rowCount()>=CSMFilter::CompiledFilter::sParallelRows)
+        mCompiledFilter->testAll (*mSourceModel, mFilterResults);
 }
 
 bool CSMWorld::IdTableProxyModel::filterAcceptsRow (int sourceRow, const QModelIndex& sourceParent)
@@ -43,10 +56,13 @@ bool CSMWorld::IdTableProxyModel::filterAcceptsRow (int sourceRow, const QModelI
     if (sourceParent.isValid())
         return false;
 
-    if (!mFilter)
+    if (!mCompiledFilter)
         return true;
 
-    return mFilter->test (*mSourceModel, sourceRow, mColumnMap);
+    if (sourceRow<static_cast<int> (mFilterResults.size()))
+        return mFilterResults[sourceRow];
+
+    return mCompiledFilter->test (*mSourceModel, sourceRow);
 }
 
 CSMWorld::IdTableProxyModel::IdTableProxyModel (QObject *parent)
@@ -87,7 +103,12 @@ void CSMWorld::IdTableProxyModel::setFilter (const boost::shared_ptr<CSMFilter::
     beginResetModel();
     mFilter = filter;
     updateColumnMap();
+    updateFilterResults();
     endResetModel();
+
+    // the proxy filters lazily, so force it while the precomputed results are still valid
+    rowCount();
+    mFilterResults.clear();
 }
 
 bool CSMWorld::IdTableProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
@@ -124,7 +145,9 @@ void CSMWorld::IdTableProxyModel::refreshFilter()
     if (mFilter)
     {
         updateColumnMap();
+        updateFilterResults();
         invalidateFilter();
+        mFilterResults.clear();
     }
 }
 
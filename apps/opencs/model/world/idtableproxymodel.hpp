@@ -10,6 +10,7 @@
 #include <QSortFilterProxyModel>
 
 #include "../filter/node.hpp"
+#include "../filter/compiledfilter.hpp"
 
 #include "columns.hpp"
 
@@ -21,6 +22,11 @@ namespace CSMWorld
 
             boost::shared_ptr<CSMFilter::Node> mFilter;
             std::map<int, int> mColumnMap; // column ID, column index in this model (or -1)
+            boost::shared_ptr<CSMFilter::CompiledFilter> mCompiledFilter;
+
+            // Results of testing all rows at once, only valid while the proxy is being refiltered
+            // by setFilter or refreshFilter.
+            std::vector<char> mFilterResults;
 
             // Cache of enum values for enum columns (e.g. Modified, Record Type).
             // Used to speed up comparisons during the sort by such columns.
@@ -35,6 +41,10 @@ namespace CSMWorld
 
             void updateColumnMap();
 
+            /// Test all rows in advance if the source model is large enough for that to be done
+            /// in parallel.
+            void updateFilterResults();
+
         public:
 
             IdTableProxyModel (QObject *parent = 0);
@@ -0,0 +1,131 @@
+#include "recordpreloader.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+
+#include <components/esm/esmreader.hpp>
+
+#include "stagedrecord.hpp"
+
+void CSMWorld::RecordPreloader::run()
+{
+    ESM::ESMReader reader;
+    ToUTF8::Utf8Encoder encoder (mEncoding);
+
+    try
+    {
+        reader.setEncoder (&encoder);
+        reader.setIndex (mIndex);
+        reader.open (mPath);
+    }
+    catch (const std::exception& e)
+    {
+        boost::mutex::scoped_lock lock (mMutex);
+        mError = e.what();
+        mAborted = true;
+        mRecordDone.notify_all();
+        return;
+    }
+
+    boost::mutex::scoped_lock lock (mMutex);
+
+    while (!mAborted)
+    {
+        while (mNext<static_cast<int> (mEntries.size()) && !mEntries[mNext].mRecord)
+            ++mNext;
+
+        if (mNext>=static_cast<int> (mEntries.size()))
+            break;
+
+        Entry& entry = mEntries[mNext++];
+
+        lock.unlock();
+
+        std::string error;
+
+        try
+        {
+            reader.restoreContext (entry.mContext);
+            reader.getRecHeader();
+            entry.mRecord->read (reader);
+        }
+        catch (const std::exception& e)
+        {
+            error = e.what();
+        }
+
+        lock.lock();
+
+        entry.mDone = true;
+        entry.mError = error;
+
+        mRecordDone.notify_all();
+    }
+}
+
+CSMWorld::RecordPreloader::RecordPreloader (const std::string& path, int index,
+    ToUTF8::FromType encoding)
+: mPath (path), mIndex (index), mEncoding (encoding), mNext (0), mCurrent (0), mAborted (false)
+{}
+
+CSMWorld::RecordPreloader::~RecordPreloader()
+{
+    {
+        boost::mutex::scoped_lock lock (mMutex);
+        mAborted = true;
+    }
+
+    mThreads.join_all();
+
+    for (std::vector<Entry>::iterator iter (mEntries.begin()); iter!=mEntries.end(); ++iter)
+        delete iter->mRecord;
+}
+
+void CSMWorld::RecordPreloader::add (const ESM::ESM_Context& context, ESM::NAME name,
+    StagedRecord *record)
+{
+    Entry entry;
+    entry.mContext = context;
+    entry.mName = name;
+    entry.mRecord = record;
+    entry.mDone = !record;
+
+    mEntries.push_back (entry);
+}
+
+void CSMWorld::RecordPreloader::start (int threads)
+{
+    if (threads<=0)
+        threads = std::max (1, static_cast<int> (boost::thread::hardware_concurrency()));
+
+    for (int i=0; i<threads; ++i)
+        mThreads.create_thread (boost::bind (&RecordPreloader::run, this));
+}
+
+std::unique_ptr<CSMWorld::StagedRecord> CSMWorld::RecordPreloader::next (ESM::NAME name)
+{
+    boost::mutex::scoped_lock lock (mMutex);
+
+    if (mCurrent>=static_cast<int> (mEntries.size()) || mEntries[mCurrent].mName.val!=name.val)
+        throw std::logic_error ("preloaded records are out of sync with " + mPath);
+
+    Entry& entry = mEntries[mCurrent++];
+
+    while (!entry.mDone)
+    {
+        if (!mError.empty())
+            throw std::runtime_error (mError);
+
+        mRecordDone.wait (lock);
+    }
+
+    if (!entry.mError.empty())
+        throw std::runtime_error (entry.mError);
+
+    std::unique_ptr<StagedRecord> record (entry.mRecord);
+    entry.mRecord = 0;
+
+    return record;
+}
@@ -0,0 +1,86 @@
+#ifndef CSM_WOLRD_RECORDPRELOADER_H
+#define CSM_WOLRD_RECORDPRELOADER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <components/esm/esmcommon.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+namespace CSMWorld
+{
+    class StagedRecord;
+
+    /// \brief Reads the records of a content file on worker threads ahead of the loader
+    ///
+    /// The file must have been scanned for the position of each record first (see add). Records
+    /// that come with a staged record are then read by a pool of worker threads, each with its own
+    /// reader. The loader takes the records in file order and adds them to their collections.
+    class RecordPreloader
+    {
+            struct Entry
+            {
+                ESM::ESM_Context mContext; // positioned in front of the record header
+                ESM::NAME mName;
+                StagedRecord *mRecord; // 0 for records the loader reads itself
+                bool mDone;
+                std::string mError;
+            };
+
+            std::string mPath;
+            int mIndex;
+            ToUTF8::FromType mEncoding;
+            std::vector<Entry> mEntries;
+            int mNext; // first entry that has not been claimed by a worker
+            int mCurrent; // next entry to be handed to the loader
+            bool mAborted;
+            std::string mError; // a worker could not open the file
+
+            boost::mutex mMutex;
+            boost::condition_variable mRecordDone;
+            boost::thread_group mThreads;
+
+            // not implemented
+            RecordPreloader (const RecordPreloader&);
+            RecordPreloader& operator= (const RecordPreloader&);
+
+            void run();
+
+        public:
+
+            /// Files with fewer records are not worth the overhead.
+            static const int sMinRecords = 1000;
+
+            RecordPreloader (const std::string& path, int index, ToUTF8::FromType encoding);
+
+            ~RecordPreloader();
+            ///< Stops and waits for the worker threads.
+
+            void add (const ESM::ESM_Context& context, ESM::NAME name, StagedRecord *record);
+            ///< Add the next record of the file.
+            ///
+            /// \param context reader context after the record name has been read
+            /// \param record 0, if the record can't be read independently of the records in front
+            /// of it (ownership is transferred)
+
+            void start (int threads);
+            ///< Start reading records.
+            ///
+            /// \param threads number of worker threads, 0 for one per core
+
+            std::unique_ptr<StagedRecord> next (ESM::NAME name);
+            ///< Wait until the next record of the file has been read and return it (0, if the
+            /// loader has to read the record itself).
+            ///
+            /// \param name name of the record the loader is looking at (for checking)
+            ///
+            /// If the record could not be read, an exception is thrown.
+    };
+}
+
+#endif
@@ -105,6 +105,11 @@ namespace CSMWorld
 
             void load (ESM::ESMReader& reader, bool base, UniversalId::Type type);
 
+            template<typename RecordT>
+            void addLoaded (const RecordT& record, bool isDeleted, bool base,
+                UniversalId::Type type);
+            ///< Add a record that has been read from a content file.
+
             virtual int getAppendIndex (const std::string& id, UniversalId::Type type) const;
             ///< \param type Will be ignored, unless the collection supports multiple record types
 
@@ -142,6 +147,13 @@ namespace CSMWorld
             const RefIdData& getDataSet() const; //I can't figure out a better name for this one :(
             void copyTo (int index, RefIdCollection& target) const;
     };
+
+    template<typename RecordT>
+    void RefIdCollection::addLoaded (const RecordT& record, bool isDeleted, bool base,
+        UniversalId::Type type)
+    {
+        mData.addLoaded (record, isDeleted, base, type);
+    }
 }
 
 #endif
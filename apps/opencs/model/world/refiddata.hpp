@@ -4,6 +4,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <stdexcept>
 
 #include <components/esm/loadacti.hpp>
 #include <components/esm/loadalch.hpp>
@@ -80,6 +81,11 @@ namespace CSMWorld
         virtual int load (ESM::ESMReader& reader, bool base);
         ///< \return index of a loaded record or -1 if no record was loaded
 
+        int addLoaded (const RecordT& record, bool isDeleted, bool base);
+        ///< Add a record that has been read from a content file.
+        ///
+        /// \return index of a loaded record or -1 if no record was loaded
+
         virtual void erase (int index, int count);
 
         virtual std::string getId (int index) const;
@@ -142,6 +148,12 @@ namespace CSMWorld
 
         record.load(reader, isDeleted);
 
+        return addLoaded (record, isDeleted, base);
+    }
+
+    template<typename RecordT>
+    int RefIdDataContainer<RecordT>::addLoaded (const RecordT& record, bool isDeleted, bool base)
+    {
         int index = 0;
         int numRecords = static_cast<int>(mContainer.size());
         for (; index < numRecords; ++index)
@@ -257,6 +269,9 @@ namespace CSMWorld
 
             std::string getRecordId(const LocalIndex &index) const;
 
+            void updateIndex (int index, bool base, UniversalId::Type type);
+            ///< Update the ID index after a record has been loaded into the container for \a type.
+
         public:
 
             RefIdData();
@@ -282,6 +297,10 @@ namespace CSMWorld
 
             void load (ESM::ESMReader& reader, bool base, UniversalId::Type type);
 
+            template<typename RecordT>
+            void addLoaded (const RecordT& record, bool isDeleted, bool base, UniversalId::Type type);
+            ///< Add a record that has been read from a content file.
+
             int getSize() const;
 
             std::vector<std::string> getIds (bool listDeleted = true) const;
@@ -315,6 +334,22 @@ namespace CSMWorld
 
             void copyTo (int index, RefIdData& target) const;
     };
+
+    template<typename RecordT>
+    void RefIdData::addLoaded (const RecordT& record, bool isDeleted, bool base,
+        UniversalId::Type type)
+    {
+        std::map<UniversalId::Type, RefIdDataContainerBase *>::iterator found =
+            mRecordContainers.find (type);
+
+        RefIdDataContainer<RecordT> *container = found==mRecordContainers.end() ? 0 :
+            dynamic_cast<RefIdDataContainer<RecordT> *> (found->second);
+
+        if (!container)
+            throw std::logic_error ("Invalid Referenceable ID type");
+
+        updateIndex (container->addLoaded (record, isDeleted, base), base, type);
+    }
 }
 
 #endif
@@ -0,0 +1,240 @@
+#include "rowindex.hpp"
+
+#include <stdexcept>
+
+// The entries are kept in a treap ordered by row. Every node knows the size of its subtree and
+// its parent, so the row of a node is found by walking up to the root.
+struct CSMWorld::RowIndex::Node
+{
+    Node *mLeft;
+    Node *mRight;
+    Node *mParent;
+    int mSize;
+    unsigned int mPriority;
+};
+
+unsigned int CSMWorld::RowIndex::nextPriority()
+{
+    // xorshift, so that the shape of the tree does not depend on the order of the inserts
+    mSeed ^= mSeed << 13;
+    mSeed ^= mSeed >> 17;
+    mSeed ^= mSeed << 5;
+    return mSeed;
+}
+
+int CSMWorld::RowIndex::getSize (const Node *node)
+{
+    return node ? node->mSize : 0;
+}
+
+void CSMWorld::RowIndex::update (Node *node)
+{
+    node->mSize = 1 + getSize (node->mLeft) + getSize (node->mRight);
+
+    if (node->mLeft)
+        node->mLeft->mParent = node;
+
+    if (node->mRight)
+        node->mRight->mParent = node;
+}
+
+void CSMWorld::RowIndex::split (Node *node, int rows, Node *& left, Node *& right)
+{
+    if (!node)
+    {
+        left = right = 0;
+        return;
+    }
+
+    if (getSize (node->mLeft)<rows)
+    {
+        split (node->mRight, rows - getSize (node->mLeft) - 1, node->mRight, right);
+        left = node;
+    }
+    else
+    {
+        split (node->mLeft, rows, left, node->mLeft);
+        right = node;
+    }
+
+    update (node);
+    node->mParent = 0;
+}
+
+CSMWorld::RowIndex::Node *CSMWorld::RowIndex::merge (Node *left, Node *right)
+{
+    if (!left)
+        return right;
+
+    if (!right)
+        return left;
+
+    if (left->mPriority>right->mPriority)
+    {
+        left->mRight = merge (left->mRight, right);
+        update (left);
+        return left;
+    }
+
+    right->mLeft = merge (left, right->mLeft);
+    update (right);
+    return right;
+}
+
+void CSMWorld::RowIndex::collect (Node *node, std::vector<Node *>& nodes)
+{
+    if (node)
+    {
+        collect (node->mLeft, nodes);
+        nodes.push_back (node);
+        collect (node->mRight, nodes);
+    }
+}
+
+void CSMWorld::RowIndex::destroy (Node *node)
+{
+    if (node)
+    {
+        destroy (node->mLeft);
+        destroy (node->mRight);
+        delete node;
+    }
+}
+
+CSMWorld::RowIndex::RowIndex() : mRoot (0), mSeed (2463534242u) {}
+
+CSMWorld::RowIndex::~RowIndex()
+{
+    destroy (mRoot);
+}
+
+int CSMWorld::RowIndex::getSize() const
+{
+    return getSize (mRoot);
+}
+
+CSMWorld::RowIndex::Handle CSMWorld::RowIndex::insert (int row)
+{
+    if (row<0 || row>getSize())
+        throw std::runtime_error ("row index out of range");
+
+    Node *node = new Node;
+    node->mLeft = node->mRight = node->mParent = 0;
+    node->mSize = 1;
+    node->mPriority = nextPriority();
+
+    Node *left = 0;
+    Node *right = 0;
+    split (mRoot, row, left, right);
+
+    mRoot = merge (merge (left, node), right);
+    mRoot->mParent = 0;
+
+    return node;
+}
+
+void CSMWorld::RowIndex::erase (int row, int count)
+{
+    if (count<=0)
+        return;
+
+    if (row<0 || row+count>getSize())
+        throw std::runtime_error ("row index out of range");
+
+    Node *left = 0;
+    Node *middle = 0;
+    Node *right = 0;
+    split (mRoot, row, left, right);
+    split (right, count, middle, right);
+
+    destroy (middle);
+
+    mRoot = merge (left, right);
+
+    if (mRoot)
+        mRoot->mParent = 0;
+}
+
+void CSMWorld::RowIndex::reorder (int baseIndex, const std::vector<int>& newOrder)
+{
+    int size = static_cast<int> (newOrder.size());
+
+    if (size==0)
+        return;
+
+    if (baseIndex<0 || baseIndex+size>getSize())
+        throw std::runtime_error ("row index out of range");
+
+    Node *left = 0;
+    Node *middle = 0;
+    Node *right = 0;
+    split (mRoot, baseIndex, left, right);
+    split (right, size, middle, right);
+
+    std::vector<Node *> nodes;
+    nodes.reserve (size);
+    collect (middle, nodes);
+
+    std::vector<Node *> buffer (size);
+
+    for (int i=0; i<size; ++i)
+        buffer[newOrder.at (i)] = nodes[i];
+
+    // rebuild the reordered range; the nodes keep their priorities, so the result is a valid treap
+    middle = 0;
+
+    for (int i=0; i<size; ++i)
+    {
+        Node *node = buffer[i];
+
+        if (!node)
+            throw std::logic_error ("invalid row order");
+
+        node->mLeft = node->mRight = node->mParent = 0;
+        node->mSize = 1;
+        middle = merge (middle, node);
+    }
+
+    mRoot = merge (merge (left, middle), right);
+    mRoot->mParent = 0;
+}
+
+int CSMWorld::RowIndex::getRow (Handle handle) const
+{
+    int row = getSize (handle->mLeft);
+
+    for (const Node *node = handle; node->mParent; node = node->mParent)
+        if (node->mParent->mRight==node)
+            row += getSize (node->mParent->mLeft) + 1;
+
+    return row;
+}
+
+CSMWorld::RowIndex::Handle CSMWorld::RowIndex::getHandle (int row) const
+{
+    if (row<0 || row>=getSize())
+        throw std::runtime_error ("row index out of range");
+
+    const Node *node = mRoot;
+
+    while (true)
+    {
+        int leftSize = getSize (node->mLeft);
+
+        if (row<leftSize)
+            node = node->mLeft;
+        else if (row==leftSize)
+            return node;
+        else
+        {
+            row -= leftSize + 1;
+            node = node->mRight;
+        }
+    }
+}
+
+void CSMWorld::RowIndex::clear()
+{
+    destroy (mRoot);
+    mRoot = 0;
+}
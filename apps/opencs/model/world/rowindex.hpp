@@ -0,0 +1,77 @@
+#ifndef CSM_WOLRD_ROWINDEX_H
+#define CSM_WOLRD_ROWINDEX_H
+
+#include <vector>
+
+namespace CSMWorld
+{
+    /// \brief Tracks the row of each entry in a table that grows and shrinks in the middle
+    ///
+    /// Each entry is represented by a handle that stays valid until the entry is removed. The
+    /// current row of an entry can be looked up from its handle. Inserting, removing and looking
+    /// up a row all take O(log n) time, no matter how many rows are affected by the change.
+    class RowIndex
+    {
+        public:
+
+            struct Node;
+
+            typedef const Node *Handle;
+
+        private:
+
+            Node *mRoot;
+            unsigned int mSeed;
+
+            // not implemented
+            RowIndex (const RowIndex&);
+            RowIndex& operator= (const RowIndex&);
+
+            unsigned int nextPriority();
+
+            static int getSize (const Node *node);
+
+            static void update (Node *node);
+
+            static void split (Node *node, int rows, Node *& left, Node *& right);
+            ///< Split \a node into the first \a rows entries and the rest.
+
+            static Node *merge (Node *left, Node *right);
+
+            static void collect (Node *node, std::vector<Node *>& nodes);
+            ///< Append the entries of \a node to \a nodes in row order.
+
+            static void destroy (Node *node);
+
+        public:
+
+            RowIndex();
+
+            ~RowIndex();
+
+            int getSize() const;
+
+            Handle insert (int row);
+            ///< Insert a new entry at \a row and move the entries from \a row onwards down by one.
+            ///
+            /// \return handle of the new entry
+
+            void erase (int row, int count);
+            ///< Remove the entries [row, row+count). Their handles become invalid.
+
+            void reorder (int baseIndex, const std::vector<int>& newOrder);
+            ///< Reorder the entries [baseIndex, baseIndex+newOrder.size()) according to the
+            /// indices given in \a newOrder (baseIndex+newOrder[0] specifies the new row of entry
+            /// baseIndex).
+            ///
+            /// \attention \a newOrder must be a permutation.
+
+            int getRow (Handle handle) const;
+
+            Handle getHandle (int row) const;
+
+            void clear();
+    };
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef CSM_WOLRD_STAGEDRECORD_H
+#define CSM_WOLRD_STAGEDRECORD_H
+
+#include "universalid.hpp"
+
+namespace ESM
+{
+    class ESMReader;
+}
+
+namespace CSMWorld
+{
+    class RefIdCollection;
+
+    /// \brief A record that has been read from a content file, but not added to its collection yet
+    class StagedRecord
+    {
+        public:
+
+            virtual ~StagedRecord() {}
+
+            virtual void read (ESM::ESMReader& reader) = 0;
+            ///< Read the record. Must not access anything but \a reader and the record itself.
+
+            virtual void add (bool base) = 0;
+            ///< Add the record to its collection.
+    };
+
+    /// \brief Staged record for an IdCollection
+    template<typename CollectionT>
+    class StagedIdRecord : public StagedRecord
+    {
+            CollectionT& mCollection;
+            typename CollectionT::ESXRecord mRecord;
+            bool mDeleted;
+
+        public:
+
+            StagedIdRecord (CollectionT& collection)
+            : mCollection (collection), mDeleted (false)
+            {}
+
+            virtual void read (ESM::ESMReader& reader)
+            {
+                mCollection.readRecord (mRecord, reader, mDeleted);
+            }
+
+            virtual void add (bool base)
+            {
+                mCollection.addLoaded (mRecord, mDeleted, base);
+            }
+    };
+
+    /// \brief Staged record for the referenceable collection
+    template<typename RecordT>
+    class StagedRefIdRecord : public StagedRecord
+    {
+            RefIdCollection& mCollection;
+            UniversalId::Type mType;
+            RecordT mRecord;
+            bool mDeleted;
+
+        public:
+
+            StagedRefIdRecord (RefIdCollection& collection, UniversalId::Type type)
+            : mCollection (collection), mType (type), mDeleted (false)
+            {}
+
+            virtual void read (ESM::ESMReader& reader)
+            {
+                mRecord.load (reader, mDeleted);
+            }
+
+            virtual void add (bool base)
+            {
+                mCollection.addLoaded (mRecord, mDeleted, base, mType);
+            }
+    };
+}
+
+#endif
@@ -70,6 +70,9 @@ void OMW::Engine::executeLocalScripts()
 
 bool OMW::Engine::frameStarted (const Ogre::FrameEvent& evt)
 {
+    // Free the settings snapshots that were replaced before the previous frame
+    Settings::Manager::releaseSnapshots();
+
     if (MWBase::Environment::get().getStateManager()->getState()!=
         MWBase::StateManager::State_NoGame)
     {
@@ -164,6 +167,10 @@ bool OMW::Engine::frameRenderingQueued (const Ogre::FrameEvent& evt)
             MWBase::Environment::get().getWorld()->getTriangleBatchCount(tri, batch);
             MWBase::Environment::get().getWindowManager()->wmUpdateFps(window->getLastFPS(), tri, batch);
 
+            unsigned int skeletons, skippedSkeletons, bones;
+            MWBase::Environment::get().getWorld()->getAnimationLodStats(skeletons, skippedSkeletons, bones);
+            MWBase::Environment::get().getWindowManager()->wmUpdateAnimationStats(skeletons, skippedSkeletons, bones);
+
             MWBase::Environment::get().getWindowManager()->update();
         }
     }
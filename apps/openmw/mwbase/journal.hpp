@@ -88,6 +88,9 @@ namespace MWBase
             virtual TTopicIter topicEnd() const = 0;
             ///< Iterator pointing past the last topic.
 
+            virtual unsigned int getRevision() const = 0;
+            ///< Changes whenever a journal entry or topic response is added or removed.
+
             virtual int countSavedGameRecords() const = 0;
 
             virtual void write (ESM::ESMWriter& writer, Loading::Listener& progress) const = 0;
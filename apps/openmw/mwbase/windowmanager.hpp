@@ -160,6 +160,9 @@ namespace MWBase
 
             virtual void wmUpdateFps(float fps, unsigned int triangleCount, unsigned int batchCount) = 0;
 
+            virtual void wmUpdateAnimationStats(unsigned int skeletonsUpdated, unsigned int skeletonsSkipped,
+                                                unsigned int bonesUpdated) = 0;
+
             /// Set value for the given ID.
             virtual void setValue (const std::string& id, const MWMechanics::AttributeValue& value) = 0;
             virtual void setValue (int parSkill, const MWMechanics::SkillValue& value) = 0;
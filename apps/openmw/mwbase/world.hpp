@@ -127,6 +127,11 @@ namespace MWBase
 
             virtual void getTriangleBatchCount(unsigned int &triangles, unsigned int &batches) = 0;
 
+            virtual void getAnimationLodStats(unsigned int &skeletonsUpdated, unsigned int &skeletonsSkipped,
+                                              unsigned int &bonesUpdated) = 0;
+            ///< Skeletons posed, skeletons skipped by the animation level of detail and bones
+            /// updated in the last frame
+
             virtual const MWWorld::Fallback *getFallback () const = 0;
 
             virtual MWWorld::Player& getPlayer() = 0;
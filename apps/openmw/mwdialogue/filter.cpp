@@ -586,8 +586,25 @@ bool MWDialogue::Filter::hasFactionRankReputationRequirements (const MWWorld::Pt
     return stats.getFactionReputation (factionId)>=faction.mData.mRankData[rank].mFactReaction;
 }
 
-MWDialogue::Filter::Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer)
-: mActor (actor), mChoice (choice), mTalkedToPlayer (talkedToPlayer)
+void MWDialogue::Filter::getInfos (const ESM::Dialogue& dialogue,
+    std::vector<const ESM::DialInfo *>& infos) const
+{
+    if (mIndex)
+    {
+        mIndex->getCandidates (dialogue, mSelection, infos);
+        return;
+    }
+
+    infos.clear();
+    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin();
+        iter!=dialogue.mInfo.end(); ++iter)
+        infos.push_back (&*iter);
+}
+
+MWDialogue::Filter::Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer,
+    const InfoIndex *index)
+: mActor (actor), mChoice (choice), mTalkedToPlayer (talkedToPlayer), mIndex (index),
+  mSelection (index ? InfoIndex::Selection (actor) : InfoIndex::Selection())
 {}
 
 const ESM::DialInfo* MWDialogue::Filter::search (const ESM::Dialogue& dialogue, const bool fallbackToInfoRefusal) const
@@ -602,6 +619,7 @@ const ESM::DialInfo* MWDialogue::Filter::search (const ESM::Dialogue& dialogue,
 
 std::vector<const ESM::DialInfo *> MWDialogue::Filter::listAll (const ESM::Dialogue& dialogue) const
 {
+    // Not using the index here, its buckets also take the player's cell into account
     std::vector<const ESM::DialInfo *> infos;
     for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin(); iter!=dialogue.mInfo.end(); ++iter)
     {
@@ -618,14 +636,17 @@ std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue
 
     bool infoRefusal = false;
 
+    std::vector<const ESM::DialInfo *> candidates;
+    getInfos (dialogue, candidates);
+
     // Iterate over topic responses to find a matching one
-    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin();
-        iter!=dialogue.mInfo.end(); ++iter)
+    for (std::vector<const ESM::DialInfo *>::const_iterator iter = candidates.begin();
+        iter!=candidates.end(); ++iter)
     {
-        if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter))
+        if (testActor (**iter) && testPlayer (**iter) && testSelectStructs (**iter))
         {
-            if (testDisposition (*iter, invertDisposition)) {
-                infos.push_back(&*iter);
+            if (testDisposition (**iter, invertDisposition)) {
+                infos.push_back(*iter);
                 if (!searchAll)
                     break;
             }
@@ -644,10 +665,12 @@ std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue
 
         const ESM::Dialogue& infoRefusalDialogue = *dialogues.find ("Info Refusal");
 
-        for (ESM::Dialogue::InfoContainer::const_iterator iter = infoRefusalDialogue.mInfo.begin();
-            iter!=infoRefusalDialogue.mInfo.end(); ++iter)
-            if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter) && testDisposition(*iter, invertDisposition)) {
-                infos.push_back(&*iter);
+        getInfos (infoRefusalDialogue, candidates);
+
+        for (std::vector<const ESM::DialInfo *>::const_iterator iter = candidates.begin();
+            iter!=candidates.end(); ++iter)
+            if (testActor (**iter) && testPlayer (**iter) && testSelectStructs (**iter) && testDisposition(**iter, invertDisposition)) {
+                infos.push_back(*iter);
                 if (!searchAll)
                     break;
             }
@@ -658,10 +681,13 @@ std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue
 
 bool MWDialogue::Filter::responseAvailable (const ESM::Dialogue& dialogue) const
 {
-    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin();
-        iter!=dialogue.mInfo.end(); ++iter)
+    std::vector<const ESM::DialInfo *> candidates;
+    getInfos (dialogue, candidates);
+
+    for (std::vector<const ESM::DialInfo *>::const_iterator iter = candidates.begin();
+        iter!=candidates.end(); ++iter)
     {
-        if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter))
+        if (testActor (**iter) && testPlayer (**iter) && testSelectStructs (**iter))
             return true;
     }
 
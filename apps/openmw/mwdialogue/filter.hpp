@@ -5,6 +5,8 @@
 
 #include "../mwworld/ptr.hpp"
 
+#include "infoindex.hpp"
+
 namespace ESM
 {
     struct DialInfo;
@@ -20,6 +22,8 @@ namespace MWDialogue
             MWWorld::Ptr mActor;
             int mChoice;
             bool mTalkedToPlayer;
+            const InfoIndex *mIndex;
+            InfoIndex::Selection mSelection;
 
             bool testActor (const ESM::DialInfo& info) const;
             ///< Is this the right actor for this \a info?
@@ -49,9 +53,13 @@ namespace MWDialogue
             bool hasFactionRankReputationRequirements (const MWWorld::Ptr& actor, const std::string& factionId,
                 int rank) const;
 
+            void getInfos (const ESM::Dialogue& dialogue, std::vector<const ESM::DialInfo *>& infos) const;
+            ///< Infos of \a dialogue that need to be tested, in dialogue order.
+
         public:
 
-            Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer);
+            Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer, const InfoIndex *index = 0);
+            ///< \param index If given, only the infos in the buckets matching \a actor are tested.
 
             std::vector<const ESM::DialInfo *> list (const ESM::Dialogue& dialogue,
                 bool fallbackToInfoRefusal, bool searchAll, bool invertDisposition=false) const;
@@ -1,4 +1,5 @@
 #include <components/esm/loaddial.hpp>
+#include <components/misc/stringops.hpp>
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
@@ -50,15 +51,20 @@ namespace MWDialogue
             const MWWorld::Store<ESM::Dialogue> & dialogs =
                 MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
 
-            std::list<std::string> keywordList;
-            for (MWWorld::Store<ESM::Dialogue>::iterator it = dialogs.begin(); it != dialogs.end(); ++it)
-                keywordList.push_back(Misc::StringUtils::lowerCase(it->mId));
-            keywordList.sort(Misc::StringUtils::ciLess);
+            // The dialogue store doesn't change while playing, so only compile the search again
+            // when a different set of records has been loaded
+            static KeywordSearch<std::string, int /*unused*/> keywordSearch;
+            static size_t keywordGeneration = 0;
 
-            KeywordSearch<std::string, int /*unused*/> keywordSearch;
+            if (keywordGeneration != dialogs.getGeneration())
+            {
+                keywordSearch.clear();
+
+                for (MWWorld::Store<ESM::Dialogue>::iterator it = dialogs.begin(); it != dialogs.end(); ++it)
+                    keywordSearch.seed(Misc::StringUtils::lowerCase(it->mId), 0 /*unused*/);
 
-            for (std::list<std::string>::const_iterator it = keywordList.begin(); it != keywordList.end(); ++it)
-                keywordSearch.seed(*it, 0 /*unused*/);
+                keywordGeneration = dialogs.getGeneration();
+            }
 
             std::vector<KeywordSearch<std::string, int /*unused*/>::Match> matches;
             keywordSearch.highlightKeywords(text.begin(), text.end(), matches);
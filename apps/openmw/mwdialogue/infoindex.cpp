@@ -0,0 +1,143 @@
+#include "infoindex.hpp"
+
+#include <algorithm>
+#include <typeinfo>
+
+#include <components/esm/loaddial.hpp>
+#include <components/esm/loadnpc.hpp>
+#include <components/misc/stringops.hpp>
+
+#include "../mwbase/environment.hpp"
+#include "../mwbase/world.hpp"
+
+#include "../mwworld/class.hpp"
+#include "../mwworld/cellstore.hpp"
+
+namespace
+{
+    bool comparePosition (const std::pair<size_t, const ESM::DialInfo *>& left,
+        const std::pair<size_t, const ESM::DialInfo *>& right)
+    {
+        return left.first < right.first;
+    }
+
+    std::string getBucketKey (const ESM::DialInfo& info)
+    {
+        if (!info.mActor.empty())
+            return "a:" + Misc::StringUtils::lowerCase (info.mActor);
+
+        if (!info.mRace.empty())
+            return "r:" + Misc::StringUtils::lowerCase (info.mRace);
+
+        if (!info.mClass.empty())
+            return "c:" + Misc::StringUtils::lowerCase (info.mClass);
+
+        if (!info.mFaction.empty())
+            return "f:" + Misc::StringUtils::lowerCase (info.mFaction);
+
+        if (!info.mCell.empty())
+            return "l:" + Misc::StringUtils::lowerCase (info.mCell);
+
+        if (info.mData.mGender==0)
+            return "g:0";
+
+        if (info.mData.mGender==1)
+            return "g:1";
+
+        return "";
+    }
+}
+
+MWDialogue::InfoIndex::Selection::Selection()
+: mIsCreature (false), mGender (-1)
+{}
+
+MWDialogue::InfoIndex::Selection::Selection (const MWWorld::Ptr& actor)
+: mIsCreature (actor.getTypeName() != typeid (ESM::NPC).name()), mGender (-1)
+{
+    mId = Misc::StringUtils::lowerCase (actor.getClass().getId (actor));
+
+    if (mIsCreature)
+        return;
+
+    const ESM::NPC *npc = actor.get<ESM::NPC>()->mBase;
+
+    mRace = Misc::StringUtils::lowerCase (npc->mRace);
+    mClass = Misc::StringUtils::lowerCase (npc->mClass);
+    mFaction = Misc::StringUtils::lowerCase (actor.getClass().getPrimaryFaction (actor));
+    mGender = (npc->mFlags & ESM::NPC::Female) ? 1 : 0;
+
+    MWBase::World *world = MWBase::Environment::get().getWorld();
+    const MWWorld::Ptr player = world->getPlayerPtr();
+    mCell = Misc::StringUtils::lowerCase (world->getCellName (player.getCell()));
+}
+
+const MWDialogue::InfoIndex::DialogueBuckets& MWDialogue::InfoIndex::getBuckets (
+    const ESM::Dialogue& dialogue) const
+{
+    std::map<const ESM::Dialogue *, DialogueBuckets>::iterator iter = mDialogues.find (&dialogue);
+
+    if (iter!=mDialogues.end())
+        return iter->second;
+
+    DialogueBuckets& buckets = mDialogues[&dialogue];
+
+    size_t position = 0;
+    for (ESM::Dialogue::InfoContainer::const_iterator info = dialogue.mInfo.begin();
+        info!=dialogue.mInfo.end(); ++info, ++position)
+    {
+        std::string key = getBucketKey (*info);
+
+        if (key.compare (0, 2, "l:")==0)
+            buckets.mCellLengths.insert (key.size()-2);
+
+        buckets.mBuckets[key].push_back (std::make_pair (position, &*info));
+    }
+
+    return buckets;
+}
+
+void MWDialogue::InfoIndex::addBucket (const DialogueBuckets& buckets, const std::string& key,
+    Bucket& candidates)
+{
+    std::map<std::string, Bucket>::const_iterator iter = buckets.mBuckets.find (key);
+
+    if (iter!=buckets.mBuckets.end())
+        candidates.insert (candidates.end(), iter->second.begin(), iter->second.end());
+}
+
+void MWDialogue::InfoIndex::getCandidates (const ESM::Dialogue& dialogue, const Selection& selection,
+    std::vector<const ESM::DialInfo *>& candidates) const
+{
+    const DialogueBuckets& buckets = getBuckets (dialogue);
+
+    Bucket found;
+
+    addBucket (buckets, "a:" + selection.mId, found);
+
+    // Creatures only ever match infos specific to their id
+    if (!selection.mIsCreature)
+    {
+        addBucket (buckets, "", found);
+        addBucket (buckets, "r:" + selection.mRace, found);
+        addBucket (buckets, "c:" + selection.mClass, found);
+
+        if (!selection.mFaction.empty())
+            addBucket (buckets, "f:" + selection.mFaction, found);
+
+        addBucket (buckets, selection.mGender==1 ? "g:1" : "g:0", found);
+
+        // Cell selectors are partial matches, so look up every prefix length that is used
+        for (std::set<size_t>::const_iterator length = buckets.mCellLengths.begin();
+            length!=buckets.mCellLengths.end() && *length<=selection.mCell.size(); ++length)
+            addBucket (buckets, "l:" + selection.mCell.substr (0, *length), found);
+    }
+
+    std::sort (found.begin(), found.end(), comparePosition);
+
+    candidates.clear();
+    candidates.reserve (found.size());
+
+    for (Bucket::const_iterator iter = found.begin(); iter!=found.end(); ++iter)
+        candidates.push_back (iter->second);
+}
@@ -0,0 +1,71 @@
+#ifndef GAME_MWDIALOGUE_INFOINDEX_H
+#define GAME_MWDIALOGUE_INFOINDEX_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ESM
+{
+    struct DialInfo;
+    struct Dialogue;
+}
+
+namespace MWWorld
+{
+    class Ptr;
+}
+
+namespace MWDialogue
+{
+    /// \brief Buckets the infos of each dialogue by their static selectors
+    ///
+    /// Every info is put into one bucket, chosen by the first of actor id, race, class, faction,
+    /// cell and speaker sex it requires. Looking up the buckets an actor can match gives a small,
+    /// ordered superset of the infos that can pass Filter::testActor and Filter::testPlayer.
+    class InfoIndex
+    {
+        public:
+
+            /// The static selector values of one actor (and the cell the player is in)
+            struct Selection
+            {
+                bool mIsCreature;
+                std::string mId;
+                std::string mRace;
+                std::string mClass;
+                std::string mFaction;
+                std::string mCell;
+                int mGender;
+
+                Selection();
+
+                Selection (const MWWorld::Ptr& actor);
+            };
+
+            void getCandidates (const ESM::Dialogue& dialogue, const Selection& selection,
+                std::vector<const ESM::DialInfo *>& candidates) const;
+            ///< Fills \a candidates with the infos of \a dialogue that might apply to \a selection,
+            /// in dialogue order.
+
+        private:
+
+            typedef std::vector<std::pair<size_t, const ESM::DialInfo *> > Bucket;
+
+            struct DialogueBuckets
+            {
+                std::map<std::string, Bucket> mBuckets;
+                std::set<size_t> mCellLengths;
+            };
+
+            // Built on first use, keyed by the dialogue record
+            mutable std::map<const ESM::Dialogue *, DialogueBuckets> mDialogues;
+
+            const DialogueBuckets& getBuckets (const ESM::Dialogue& dialogue) const;
+
+            static void addBucket (const DialogueBuckets& buckets, const std::string& key, Bucket& candidates);
+    };
+}
+
+#endif
@@ -66,6 +66,7 @@ namespace MWDialogue
     }
 
     Journal::Journal()
+    : mRevision (0)
     {}
 
     void Journal::clear()
@@ -73,6 +74,7 @@ namespace MWDialogue
         mJournal.clear();
         mQuests.clear();
         mTopics.clear();
+        ++mRevision;
     }
 
     void Journal::addEntry (const std::string& id, int index)
@@ -91,6 +93,8 @@ namespace MWDialogue
 
         quest.addEntry (entry); // we are doing slicing on purpose here
 
+        ++mRevision;
+
         MWBase::Environment::get().getWindowManager()->messageBox ("#{sJournalEntry}");
     }
 
@@ -108,6 +112,8 @@ namespace MWDialogue
         JournalEntry entry(topicId, infoId, actor);
         entry.mActorName = actor.getClass().getName(actor);
         topic.addEntry (entry);
+
+        ++mRevision;
     }
 
     void Journal::removeLastAddedTopicResponse(const std::string &topicId, const std::string &actorName)
@@ -118,6 +124,8 @@ namespace MWDialogue
 
         if (topic.begin() == topic.end())
             mTopics.erase(mTopics.find(topicId)); // All responses removed -> remove topic
+
+        ++mRevision;
     }
 
     int Journal::getJournalIndex (const std::string& id) const
@@ -160,6 +168,11 @@ namespace MWDialogue
         return mTopics.end();
     }
 
+    unsigned int Journal::getRevision() const
+    {
+        return mRevision;
+    }
+
     int Journal::countSavedGameRecords() const
     {
         int count = static_cast<int> (mQuests.size());
@@ -228,6 +241,8 @@ namespace MWDialogue
 
     void Journal::readRecord (ESM::ESMReader& reader, uint32_t type)
     {
+        ++mRevision;
+
         if (type==ESM::REC_JOUR || type==ESM::REC_JOUR_LEGACY)
         {
             ESM::JournalEntry record;
@@ -14,6 +14,7 @@ namespace MWDialogue
             TEntryContainer mJournal;
             TQuestContainer mQuests;
             TTopicContainer mTopics;
+            unsigned int mRevision;
 
         private:
 
@@ -67,6 +68,9 @@ namespace MWDialogue
             virtual TTopicIter topicEnd() const;
             ///< Iterator pointing past the last topic.
 
+            virtual unsigned int getRevision() const;
+            ///< Changes whenever a journal entry or topic response is added or removed.
+
             virtual int countSavedGameRecords() const;
 
             virtual void write (ESM::ESMWriter& writer, Loading::Listener& progress) const;
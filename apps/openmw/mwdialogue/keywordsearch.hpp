@@ -1,17 +1,24 @@
 #ifndef GAME_MWDIALOGUE_KEYWORDSEARCH_H
 #define GAME_MWDIALOGUE_KEYWORDSEARCH_H
 
+#include <cctype>
 #include <map>
-#include <locale>
+#include <list>
+#include <deque>
 #include <stdexcept>
 #include <vector>
-#include <algorithm>    // std::reverse
-
-#include <components/misc/stringops.hpp>
+#include <algorithm>
 
 namespace MWDialogue
 {
 
+/// \brief Finds all keywords in a text with a single pass over it per automaton
+///
+/// The keywords are compiled into Aho-Corasick automata over case folded UTF-8 bytes. Keywords
+/// seeded since the last search get an automaton of their own, which is merged with the previous
+/// automata as long as those are not larger than it. Adding a few topics to a long list therefore
+/// only rebuilds a small automaton, every keyword is rebuilt O(log n) times in total and a search
+/// has at most O(log n) automata to run.
 template <typename string_t, typename value_t>
 class KeywordSearch
 {
@@ -30,41 +37,52 @@ public:
     {
         if (keyword.empty())
             return;
-        seed_impl  (/*std::move*/ (keyword), /*std::move*/ (value), 0, mRoot);
+
+        std::vector<unsigned char> folded;
+        fold (keyword, folded);
+
+        for (typename std::vector<Automaton>::const_iterator it = mAutomata.begin(); it != mAutomata.end(); ++it)
+        {
+            size_t node = it->find (folded);
+            if (node == 0 || !it->mNodes[node].mTerminal)
+                continue;
+
+            if (keyword == it->mNodes[node].mKeyword)
+                throw std::runtime_error ("duplicate keyword inserted");
+
+            // Same keyword with a different case; the first one wins
+            return;
+        }
+
+        if (mAutomata.empty() || mAutomata.back().mCompiled)
+            mAutomata.push_back (Automaton());
+
+        mAutomata.back().insert (folded, keyword, value);
     }
 
     void clear ()
     {
-        mRoot.mChildren.clear ();
-        mRoot.mKeyword.clear ();
+        mAutomata.clear ();
     }
 
     bool containsKeyword (string_t keyword, value_t& value)
     {
-        typename Entry::childen_t::iterator current;
-        typename Entry::childen_t::iterator next;
-
-        current = mRoot.mChildren.find (std::tolower (*keyword.begin(), mLocale));
-        if (current == mRoot.mChildren.end())
+        if (keyword.empty())
             return false;
-        else if (current->second.mKeyword.size() && Misc::StringUtils::ciEqual(current->second.mKeyword, keyword))
-        {
-            value = current->second.mValue;
-            return true;
-        }
 
-        for (Point i = ++keyword.begin(); i != keyword.end(); ++i)
+        std::vector<unsigned char> folded;
+        fold (keyword, folded);
+
+        for (typename std::vector<Automaton>::const_iterator it = mAutomata.begin(); it != mAutomata.end(); ++it)
         {
-            next = current->second.mChildren.find(std::tolower (*i, mLocale));
-            if (next == current->second.mChildren.end())
-                return false;
-            if (Misc::StringUtils::ciEqual(next->second.mKeyword, keyword))
+            size_t node = it->find (folded);
+            if (node != 0 && it->mNodes[node].mTerminal)
             {
-                value = next->second.mValue;
+                value = it->mNodes[node].mValue;
                 return true;
             }
-            current = next;
         }
+
         return false;
     }
 
@@ -75,94 +93,77 @@ public:
 
     void highlightKeywords (Point beg, Point end, std::vector<Match>& out)
     {
-        std::vector<Match> matches;
-        for (Point i = beg; i != end; ++i)
-        {
-            // check if previous character marked start of new word
-            if (i != beg)
-            {
-                Point prev = i;
-                --prev;
-                if(isalpha(*prev))
-                    continue;
-            }
-
-
-            // check first character
-            typename Entry::childen_t::iterator candidate = mRoot.mChildren.find (std::tolower (*i, mLocale));
-
-            // no match, on to next character
-            if (candidate == mRoot.mChildren.end ())
-                continue;
+        compile ();
 
-            // see how far the match goes
-            Point j = i;
+        // Fold the text once for all automata. Every folded byte remembers the character it was
+        // folded from, since folding may change the length of a character.
+        std::vector<unsigned char> folded;
+        std::vector<size_t> charBegin;
+        std::vector<size_t> charEnd;
 
-            // some keywords might be longer variations of other keywords, so we definitely need a list of candidates
-            // the first element in the pair is length of the match, i.e. depth from the first character on
-            std::vector< typename std::pair<int, typename Entry::childen_t::iterator> > candidates;
+        for (Point i = beg; i != end;)
+        {
+            size_t first = i - beg;
+            unsigned char bytes[2];
+            size_t count = fold (i, end, bytes);
 
-            while ((j + 1) != end)
+            for (size_t j = 0; j < count; ++j)
             {
-                typename Entry::childen_t::iterator next = candidate->second.mChildren.find (std::tolower (*++j, mLocale));
-
-                if (next == candidate->second.mChildren.end ())
-                {
-                    if (candidate->second.mKeyword.size() > 0)
-                        candidates.push_back(std::make_pair((j-i), candidate));
-                    break;
-                }
-
-                candidate = next;
-
-                if (candidate->second.mKeyword.size() > 0)
-                    candidates.push_back(std::make_pair((j-i), candidate));
+                folded.push_back (bytes[j]);
+                charBegin.push_back (first);
+                charEnd.push_back (i - beg);
             }
+        }
 
-            if (candidates.empty())
-                continue; // didn't match enough to disambiguate, on to next character
+        // Longest keyword starting at each word start
+        std::vector<Match> matches;
+        std::vector<size_t> startMatch (end - beg, size_t (-1));
 
-            // shorter candidates will be added to the vector first. however, we want to check against longer candidates first
-            std::reverse(candidates.begin(), candidates.end());
+        for (typename std::vector<Automaton>::const_iterator automaton = mAutomata.begin(); automaton != mAutomata.end(); ++automaton)
+        {
+            const std::vector<Node>& nodes = automaton->mNodes;
 
-            for (typename std::vector< std::pair<int, typename Entry::childen_t::iterator> >::iterator it = candidates.begin();
-                 it != candidates.end(); ++it)
+            size_t state = 0;
+            for (size_t offset = 0; offset < folded.size(); ++offset)
             {
-                candidate = it->second;
-                // try to match the rest of the keyword
-                Point k = i + it->first;
-                typename string_t::const_iterator t = candidate->second.mKeyword.begin () + (k - i);
+                state = automaton->next (state, folded[offset]);
 
-
-                while (k != end && t != candidate->second.mKeyword.end ())
+                for (size_t hit = nodes[state].mTerminal ? state : nodes[state].mOutput; hit != 0;
+                     hit = nodes[hit].mOutput)
                 {
-                    if (std::tolower (*k, mLocale) != std::tolower (*t, mLocale))
-                        break;
-
-                    ++k, ++t;
+                    const Node& found = nodes[hit];
+                    size_t start = charBegin[offset + 1 - found.mDepth];
+                    size_t stop = charEnd[offset];
+
+                    // keywords have to start at the beginning of a word
+                    if (start != 0 && isalpha (static_cast<unsigned char> (*(beg + (start - 1)))))
+                        continue;
+
+                    if (startMatch[start] == size_t (-1))
+                    {
+                        startMatch[start] = matches.size();
+                        matches.push_back (Match());
+                    }
+                    else if (size_t (matches[startMatch[start]].mEnd - matches[startMatch[start]].mBeg) >= stop - start)
+                        continue;
+
+                    Match& match = matches[startMatch[start]];
+                    match.mBeg = beg + start;
+                    match.mEnd = beg + stop;
+                    match.mValue = found.mValue;
                 }
-
-                // didn't match full keyword, try the next candidate
-                if (t != candidate->second.mKeyword.end ())
-                    continue;
-
-                // found a keyword, but there might still be longer keywords that start somewhere _within_ this keyword
-                // we will resolve these overlapping keywords later, choosing the longest one in case of conflict
-                Match match;
-                match.mValue = candidate->second.mValue;
-                match.mBeg = i;
-                match.mEnd = k;
-                matches.push_back(match);
-                break;
             }
         }
 
+        std::sort (matches.begin(), matches.end(), sortMatches);
+
         // resolve overlapping keywords
-        while (matches.size())
+        std::list<Match> remaining (matches.begin(), matches.end());
+        while (remaining.size())
         {
             int longestKeywordSize = 0;
-            typename std::vector<Match>::iterator longestKeyword = matches.begin();
-            for (typename std::vector<Match>::iterator it = matches.begin(); it != matches.end(); ++it)
+            typename std::list<Match>::iterator longestKeyword = remaining.begin();
+            for (typename std::list<Match>::iterator it = remaining.begin(); it != remaining.end(); ++it)
             {
                 int size = it->mEnd - it->mBeg;
                 if (size > longestKeywordSize)
@@ -171,10 +172,10 @@ public:
                     longestKeyword = it;
                 }
 
-                typename std::vector<Match>::iterator next = it;
+                typename std::list<Match>::iterator next = it;
                 ++next;
 
-                if (next == matches.end())
+                if (next == remaining.end())
                     break;
 
                 if (it->mEnd <= next->mBeg)
@@ -184,13 +185,14 @@ public:
             }
 
             Match keyword = *longestKeyword;
-            matches.erase(longestKeyword);
+            remaining.erase(longestKeyword);
             out.push_back(keyword);
-            // erase anything that overlaps with the keyword we just added to the output
-            for (typename std::vector<Match>::iterator it = matches.begin(); it != matches.end();)
+            // erase anything that overlaps with the keyword we just added to the output; the
+            // matches are sorted by start, so none past the keyword's end can overlap it
+            for (typename std::list<Match>::iterator it = remaining.begin(); it != remaining.end() && it->mBeg < keyword.mEnd;)
             {
-                if (it->mBeg < keyword.mEnd && it->mEnd > keyword.mBeg)
-                    it = matches.erase(it);
+                if (it->mEnd > keyword.mBeg)
+                    it = remaining.erase(it);
                 else
                     ++it;
             }
@@ -201,55 +203,207 @@ public:
 
 private:
 
-    struct Entry
+    struct Node
     {
-        typedef std::map <wchar_t, Entry> childen_t;
+        typedef std::map<unsigned char, size_t> children_t;
+
+        children_t mChildren;
+        size_t mFail;   // longest proper suffix that is also in the trie
+        size_t mOutput; // longest proper suffix that is a keyword, 0 if none
+        size_t mDepth;  // length in bytes
+        bool mTerminal;
 
         string_t mKeyword;
         value_t mValue;
-        childen_t mChildren;
+
+        Node () : mFail (0), mOutput (0), mDepth (0), mTerminal (false), mValue () {}
     };
 
-    void seed_impl (string_t keyword, value_t value, size_t depth, Entry  & entry)
+    struct Automaton
     {
-        int ch = tolower (keyword.at (depth), mLocale);
+        std::vector<Node> mNodes; // mNodes[0] is the root
+        size_t mRootChildren[256];
+        size_t mKeywords;
+        bool mCompiled;
+
+        Automaton () : mNodes (1), mKeywords (0), mCompiled (false)
+        {
+            std::fill (mRootChildren, mRootChildren + 256, size_t (0));
+        }
 
-        typename Entry::childen_t::iterator j = entry.mChildren.find (ch);
+        size_t getChild (size_t node, unsigned char ch) const
+        {
+            if (node == 0)
+                return mRootChildren[ch];
+
+            typename Node::children_t::const_iterator iter = mNodes[node].mChildren.find (ch);
+            return iter != mNodes[node].mChildren.end() ? iter->second : 0;
+        }
 
-        if (j == entry.mChildren.end ())
+        void setChild (size_t node, unsigned char ch, size_t child)
         {
-            entry.mChildren [ch].mValue = /*std::move*/ (value);
-            entry.mChildren [ch].mKeyword = /*std::move*/ (keyword);
+            if (node == 0)
+                mRootChildren[ch] = child;
+            mNodes[node].mChildren[ch] = child;
         }
-        else
+
+        size_t next (size_t state, unsigned char ch) const
         {
-            if (j->second.mKeyword.size () > 0)
+            while (state != 0)
             {
-                if (keyword == j->second.mKeyword)
-                    throw std::runtime_error ("duplicate keyword inserted");
+                size_t child = getChild (state, ch);
+                if (child != 0)
+                    return child;
+                state = mNodes[state].mFail;
+            }
+            return mRootChildren[ch];
+        }
 
-                value_t pushValue = /*std::move*/ (j->second.mValue);
-                string_t pushKeyword = /*std::move*/ (j->second.mKeyword);
+        /// \return Node reached by the folded keyword, 0 if there is none
+        size_t find (const std::vector<unsigned char>& folded) const
+        {
+            size_t node = 0;
+            for (size_t i = 0; i < folded.size(); ++i)
+            {
+                node = getChild (node, folded[i]);
+                if (node == 0)
+                    break;
+            }
+            return node;
+        }
 
-                if (depth >= pushKeyword.size ())
-                    throw std::runtime_error ("unexpected");
+        /// Adds a keyword to the trie; the caller has made sure it is not in there yet
+        void insert (const std::vector<unsigned char>& folded, const string_t& keyword, const value_t& value)
+        {
+            size_t node = 0;
+            for (size_t i = 0; i < folded.size(); ++i)
+            {
+                size_t next = getChild (node, folded[i]);
+                if (next == 0)
+                {
+                    next = mNodes.size();
+                    mNodes.push_back (Node());
+                    mNodes.back().mDepth = mNodes[node].mDepth + 1;
+                    setChild (node, folded[i], next);
+                }
+                node = next;
+            }
 
-                if (depth+1 < pushKeyword.size())
+            Node& entry = mNodes[node];
+            entry.mTerminal = true;
+            entry.mKeyword = keyword;
+            entry.mValue = value;
+            ++mKeywords;
+        }
+
+        /// Builds the failure and output links breadth first
+        void compile ()
+        {
+            std::deque<size_t> queue;
+
+            for (typename Node::children_t::const_iterator it = mNodes[0].mChildren.begin(); it != mNodes[0].mChildren.end(); ++it)
+                queue.push_back (it->second);
+
+            while (!queue.empty())
+            {
+                size_t node = queue.front();
+                queue.pop_front();
+
+                for (typename Node::children_t::const_iterator it = mNodes[node].mChildren.begin(); it != mNodes[node].mChildren.end(); ++it)
                 {
-                    seed_impl (/*std::move*/ (pushKeyword), /*std::move*/ (pushValue), depth+1, j->second);
-                    j->second.mKeyword.clear ();
+                    size_t child = it->second;
+                    size_t fail = next (mNodes[node].mFail, it->first);
+
+                    mNodes[child].mFail = fail;
+                    mNodes[child].mOutput = mNodes[fail].mTerminal ? fail : mNodes[fail].mOutput;
+                    queue.push_back (child);
                 }
             }
-            if (depth+1 == keyword.size())
-                j->second.mKeyword = value;
-            else // depth+1 < keyword.size()
-                seed_impl (/*std::move*/ (keyword), /*std::move*/ (value), depth+1, j->second);
+
+            mCompiled = true;
+        }
+    };
+
+    /// Case folds the UTF-8 character at \a i into \a out and advances \a i past it.
+    /// ASCII, Latin-1, Latin Extended-A and Cyrillic letters are folded. Folded characters keep
+    /// their length in bytes, except for U+0130 (capital I with dot above), which folds to 'i'.
+    /// \return Number of bytes written to \a out
+    static size_t fold (Point& i, Point end, unsigned char out[2])
+    {
+        unsigned char lead = static_cast<unsigned char> (*i++);
+
+        if (lead < 0x80)
+        {
+            out[0] = static_cast<unsigned char> (tolower (lead));
+            return 1;
+        }
+
+        if ((lead & 0xe0) != 0xc0 || i == end || (static_cast<unsigned char> (*i) & 0xc0) != 0x80)
+        {
+            out[0] = lead;
+            return 1;
+        }
+
+        unsigned int code = ((lead & 0x1f) << 6) | (static_cast<unsigned char> (*i++) & 0x3f);
+
+        if (code == 0x130)
+        {
+            out[0] = 'i';
+            return 1;
+        }
+
+        if ((code >= 0xc0 && code <= 0xde && code != 0xd7) || (code >= 0x410 && code <= 0x42f))
+            code += 0x20;
+        else if (code >= 0x400 && code <= 0x40f)
+            code += 0x50;
+        else if (code == 0x178)
+            code = 0xff;
+        else if ((code >= 0x100 && code <= 0x12f) || (code >= 0x132 && code <= 0x137) || (code >= 0x14a && code <= 0x177))
+            code |= 1;
+        else if ((code >= 0x139 && code <= 0x148) || (code >= 0x179 && code <= 0x17e))
+            code += (code & 1);
+
+        out[0] = static_cast<unsigned char> (0xc0 | (code >> 6));
+        out[1] = static_cast<unsigned char> (0x80 | (code & 0x3f));
+        return 2;
+    }
+
+    static void fold (const string_t& keyword, std::vector<unsigned char>& out)
+    {
+        for (Point i = keyword.begin(); i != keyword.end();)
+        {
+            unsigned char bytes[2];
+            size_t count = fold (i, keyword.end(), bytes);
+            out.insert (out.end(), bytes, bytes + count);
+        }
+    }
+
+    /// Compiles the keywords seeded since the last search, after merging them with the previous
+    /// automata that are not larger
+    void compile ()
+    {
+        if (mAutomata.empty() || mAutomata.back().mCompiled)
+            return;
+
+        while (mAutomata.size() > 1 && mAutomata[mAutomata.size()-2].mKeywords <= mAutomata.back().mKeywords)
+        {
+            const std::vector<Node>& previous = mAutomata[mAutomata.size()-2].mNodes;
+
+            for (typename std::vector<Node>::const_iterator it = previous.begin(); it != previous.end(); ++it)
+                if (it->mTerminal)
+                {
+                    std::vector<unsigned char> folded;
+                    fold (it->mKeyword, folded);
+                    mAutomata.back().insert (folded, it->mKeyword, it->mValue);
+                }
+
+            mAutomata.erase (mAutomata.end()-2);
         }
 
+        mAutomata.back().compile ();
     }
 
-    Entry mRoot;
-    std::locale mLocale;
+    std::vector<Automaton> mAutomata; // only the last one may be uncompiled
 };
 
 }
@@ -7,6 +7,7 @@
 #include "MyGUI_FactoryManager.h"
 
 #include <stdint.h>
+#include <deque>
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
@@ -92,6 +93,7 @@ struct TypesetBookImpl : TypesetBook
     };
 
     typedef std::vector <Section> Sections;
+    typedef std::deque <Section> MarkedSections;
 
     // Holds "top" and "bottom" vertical coordinates in the source text.
     // A page is basically a "window" into a portion of the source text, similar to a ScrollView.
@@ -100,13 +102,58 @@ struct TypesetBookImpl : TypesetBook
     typedef std::vector <Page> Pages;
 
     Pages mPages;
-    Sections mSections;
+    Sections mSections; // behind the marked sections
+    MyGUI::IntRect mRect;
     Contents mContents;
     Styles mStyles;
-    MyGUI::IntRect mRect;
+
+    // Everything in front of the typesetter's mark is shared by all books completed by it. The
+    // typesetter only appends to it, a book just ignores the sections that were added after it.
+    boost::shared_ptr <MarkedSections> mMarkedSections;
+    size_t mMarkedSectionCount;
+    boost::shared_ptr <Contents> mMarkedContents;
+    boost::shared_ptr <Styles> mMarkedStyles;
+
+    TypesetBookImpl () :
+        mMarkedSections (boost::make_shared <MarkedSections> ()),
+        mMarkedSectionCount (0),
+        mMarkedContents (boost::make_shared <Contents> ()),
+        mMarkedStyles (boost::make_shared <Styles> ())
+    {
+    }
 
     virtual ~TypesetBookImpl () {}
 
+    /// Start a book behind the marked part of \a book
+    void shareMarked (TypesetBookImpl const & book)
+    {
+        mMarkedSections = book.mMarkedSections;
+        mMarkedSectionCount = book.mMarkedSectionCount;
+        mMarkedContents = book.mMarkedContents;
+        mMarkedStyles = book.mMarkedStyles;
+    }
+
+    /// Move the sections, contents and styles of this book to the marked part
+    void mark ()
+    {
+        assert (mMarkedSectionCount == mMarkedSections->size ());
+
+        mMarkedSections->insert (mMarkedSections->end (), mSections.begin (), mSections.end ());
+        mMarkedSectionCount = mMarkedSections->size ();
+        mSections.clear ();
+
+        // splicing keeps the addresses the runs and the typesetter refer to
+        mMarkedContents->splice (mMarkedContents->end (), mContents);
+        mMarkedStyles->splice (mMarkedStyles->end (), mStyles);
+    }
+
+    size_t sectionCount () const { return mMarkedSectionCount + mSections.size (); }
+
+    Section const & getSection (size_t index) const
+    {
+        return index < mMarkedSectionCount ? (*mMarkedSections) [index] : mSections [index - mMarkedSectionCount];
+    }
+
     Range addContent (BookTypesetter::Utf8Span text)
     {
         Contents::iterator i = mContents.insert (mContents.end (), Content (text.first, text.second));
@@ -130,19 +177,21 @@ struct TypesetBookImpl : TypesetBook
     template <typename Visitor>
     void visitRuns (int top, int bottom, MyGUI::IFont* Font, Visitor const & visitor) const
     {
-        for (Sections::const_iterator i = mSections.begin (); i != mSections.end (); ++i)
+        for (size_t s = 0; s < sectionCount (); ++s)
         {
-            if (top >= mRect.bottom || bottom <= i->mRect.top)
+            Section const & i = getSection (s);
+
+            if (top >= mRect.bottom || bottom <= i.mRect.top)
                 continue;
 
-            for (Lines::const_iterator j = i->mLines.begin (); j != i->mLines.end (); ++j)
+            for (Lines::const_iterator j = i.mLines.begin (); j != i.mLines.end (); ++j)
             {
                 if (top >= j->mRect.bottom || bottom <= j->mRect.top)
                     continue;
 
                 for (Runs::const_iterator k = j->mRuns.begin (); k != j->mRuns.end (); ++k)
                     if (!Font || k->mStyle->mFont == Font)
-                        visitor (*i, *j, *k);
+                        visitor (i, *j, *k);
             }
         }
     }
@@ -155,14 +204,16 @@ struct TypesetBookImpl : TypesetBook
 
     StyleImpl * hitTest (int left, int top) const
     {
-        for (Sections::const_iterator i = mSections.begin (); i != mSections.end (); ++i)
+        for (size_t s = 0; s < sectionCount (); ++s)
         {
-            if (top < i->mRect.top || top >= i->mRect.bottom)
+            Section const & i = getSection (s);
+
+            if (top < i.mRect.top || top >= i.mRect.bottom)
                 continue;
 
-            int left1 = left - i->mRect.left;
+            int left1 = left - i.mRect.left;
 
-            for (Lines::const_iterator j = i->mLines.begin (); j != i->mLines.end (); ++j)
+            for (Lines::const_iterator j = i.mLines.begin (); j != i.mLines.end (); ++j)
             {
                 if (top < j->mRect.top || top >= j->mRect.bottom)
                     continue;
@@ -184,12 +235,16 @@ struct TypesetBookImpl : TypesetBook
 
     MyGUI::IFont* affectedFont (StyleImpl* style)
     {
+        for (Styles::iterator i = mMarkedStyles->begin (); i != mMarkedStyles->end (); ++i)
+            if (&*i == style)
+                return i->mFont;
         for (Styles::iterator i = mStyles.begin (); i != mStyles.end (); ++i)
             if (&*i == style)
                 return i->mFont;
         return NULL;
     }
 
+
     struct Typesetter;
 };
 
@@ -225,11 +280,32 @@ struct TypesetBookImpl::Typesetter : BookTypesetter
     Book::Content const * mCurrentContent;
     Alignment mCurrentAlignment;
 
+    // State of the typesetter at the last call to setMark. The sections in front of the mark are
+    // aligned and paginated already, except for the last page.
+    struct Mark
+    {
+        MyGUI::IntRect mRect;
+        Pages mPages;
+        int mPageStart;
+        int mPageStop;
+        Book::Content const * mContent;
+        Alignment mAlignment;
+
+        Mark () :
+            mPageStart (0), mPageStop (0), mContent (NULL), mAlignment (AlignLeft)
+        {
+        }
+    };
+
+    Mark mMark;
+    bool mCompleted; // mBook has been handed out by complete
+
     Typesetter (size_t width, size_t height) :
         mPageWidth (width), mPageHeight(height),
         mSection (NULL), mLine (NULL), mRun (NULL),
         mCurrentContent (NULL),
-        mCurrentAlignment (AlignLeft)
+        mCurrentAlignment (AlignLeft),
+        mCompleted (false)
     {
         mBook = boost::make_shared <Book> ();
     }
@@ -243,9 +319,11 @@ struct TypesetBookImpl::Typesetter : BookTypesetter
         if (strcmp(fontName, "") == 0)
             return createStyle(MyGUI::FontManager::getInstance().getDefaultFont().c_str(), fontColour);
 
-        for (Styles::iterator i = mBook->mStyles.begin (); i != mBook->mStyles.end (); ++i)
-            if (i->match (fontName, fontColour, fontColour, fontColour, 0))
-                return &*i;
+        Styles * styles [] = { mBook->mMarkedStyles.get (), &mBook->mStyles };
+        for (size_t s = 0; s < 2; ++s)
+            for (Styles::iterator i = styles [s]->begin (); i != styles [s]->end (); ++i)
+                if (i->match (fontName, fontColour, fontColour, fontColour, 0))
+                    return &*i;
 
         StyleImpl & style = *mBook->mStyles.insert (mBook->mStyles.end (), StyleImpl ());
 
@@ -263,9 +341,13 @@ struct TypesetBookImpl::Typesetter : BookTypesetter
         StyleImpl* BaseStyle = static_cast <StyleImpl*> (baseStyle);
 
         if (!unique)
-            for (Styles::iterator i = mBook->mStyles.begin (); i != mBook->mStyles.end (); ++i)
-                if (i->match (BaseStyle->mFont, hoverColour, activeColour, normalColour, id))
-                    return &*i;
+        {
+            Styles * styles [] = { mBook->mMarkedStyles.get (), &mBook->mStyles };
+            for (size_t s = 0; s < 2; ++s)
+                for (Styles::iterator i = styles [s]->begin (); i != styles [s]->end (); ++i)
+                    if (i->match (BaseStyle->mFont, hoverColour, activeColour, normalColour, id))
+                        return &*i;
+        }
 
         StyleImpl & style = *mBook->mStyles.insert (mBook->mStyles.end (), StyleImpl ());
 
@@ -330,14 +412,15 @@ struct TypesetBookImpl::Typesetter : BookTypesetter
     {
         add_partial_text();
 
-        if (mBook->mSections.size () > 0)
+        if (mBook->sectionCount () > 0)
         {
             mRun = NULL;
             mLine = NULL;
             mSection = NULL;
 
-            if (mBook->mRect.bottom < (mBook->mSections.back ().mRect.bottom + margin))
-                mBook->mRect.bottom = (mBook->mSections.back ().mRect.bottom + margin);
+            Section const & last = mBook->getSection (mBook->sectionCount () - 1);
+            if (mBook->mRect.bottom < (last.mRect.bottom + margin))
+                mBook->mRect.bottom = (last.mRect.bottom + margin);
         }
     }
 
@@ -350,13 +433,78 @@ struct TypesetBookImpl::Typesetter : BookTypesetter
         mCurrentAlignment = sectionAlignment;
     }
 
-    TypesetBook::Ptr complete ()
+    void setMark ()
     {
-        int curPageStart = 0;
-        int curPageStop  = 0;
+        add_partial_text();
 
+        mRun = NULL;
+        mLine = NULL;
+        mSection = NULL;
+
+        paginate (mMark.mPages, mMark.mPageStart, mMark.mPageStop);
+
+        mBook->mark ();
+        mSectionAlignment.clear ();
+
+        mMark.mRect = mBook->mRect;
+        mMark.mContent = mCurrentContent;
+        mMark.mAlignment = mCurrentAlignment;
+    }
+
+    void rewind ()
+    {
+        mPartialWhitespace.clear();
+        mPartialWord.clear();
+
+        if (mCompleted)
+        {
+            // The completed book may still be shown, it keeps what was added after the mark.
+            BookPtr book = boost::make_shared <Book> ();
+            book->shareMarked (*mBook);
+
+            mBook = book;
+            mCompleted = false;
+        }
+        else
+        {
+            mBook->mSections.clear ();
+            mBook->mContents.clear ();
+            mBook->mStyles.clear ();
+        }
+
+        mBook->mRect = mMark.mRect;
+        mBook->mPages.clear ();
+        mSectionAlignment.clear ();
+
+        mRun = NULL;
+        mLine = NULL;
+        mSection = NULL;
+        mCurrentContent = mMark.mContent;
+        mCurrentAlignment = mMark.mAlignment;
+    }
+
+    TypesetBook::Ptr complete ()
+    {
         add_partial_text();
 
+        Pages pages = mMark.mPages;
+        int curPageStart = mMark.mPageStart;
+        int curPageStop = mMark.mPageStop;
+
+        paginate (pages, curPageStart, curPageStop);
+
+        if (curPageStart != curPageStop)
+            pages.push_back (Page (curPageStart, curPageStop));
+
+        mBook->mPages.swap (pages);
+        mCompleted = true;
+
+        return mBook;
+    }
+
+    // Align the lines of the sections behind the mark and add the pages that are filled by them.
+    void paginate (Pages & pages, int & curPageStart, int & curPageStop)
+    {
         std::vector <Alignment>::iterator sa = mSectionAlignment.begin ();
         for (Sections::iterator i = mBook->mSections.begin (); i != mBook->mSections.end (); ++i, ++sa)
         {
@@ -398,7 +546,7 @@ struct TypesetBookImpl::Typesetter : BookTypesetter
                     // The section won't completely fit on the current page. Finish the current page and start a new one.
                     assert (curPageStart != curPageStop);
 
-                    mBook->mPages.push_back (Page (curPageStart, curPageStop));
+                    pages.push_back (Page (curPageStart, curPageStop));
 
                     curPageStart = i->mRect.top;
                     curPageStop = i->mRect.bottom;
@@ -423,7 +571,7 @@ struct TypesetBookImpl::Typesetter : BookTypesetter
                         }
                     }
 
-                    mBook->mPages.push_back (Page (curPageStart, splitPos));
+                    pages.push_back (Page (curPageStart, splitPos));
                     curPageStart = splitPos;
                     curPageStop = splitPos;
 
@@ -432,11 +580,6 @@ struct TypesetBookImpl::Typesetter : BookTypesetter
                 curPageStop = i->mRect.bottom;
             }
         }
-
-        if (curPageStart != curPageStop)
-            mBook->mPages.push_back (Page (curPageStart, curPageStop));
-
-        return mBook;
     }
 
     void writeImpl (StyleImpl * style, Utf8Stream::Point _begin, Utf8Stream::Point _end)
@@ -91,7 +91,17 @@ namespace MWGui
         /// using the specified style.
         virtual void write (Style * Style, size_t Begin, size_t End) = 0;
 
-        /// Finalize the document layout, and return a pointer to it.
+        /// Remember the current end of the document, so that the typesetter can be
+        /// rewound to it later. This finishes the current section.
+        virtual void setMark () = 0;
+
+        /// Discard everything that was added after the last call to setMark, or
+        /// everything if it was never called. The layout of the document up to
+        /// the mark is kept. Books that have been completed are not affected.
+        virtual void rewind () = 0;
+
+        /// Finalize the document layout, and return a pointer to it. The typesetter
+        /// can be rewound and completed again afterwards.
         virtual TypesetBook::Ptr complete () = 0;
     };
 
@@ -251,6 +251,8 @@ namespace MWGui
         , mServices(0)
         , mEnabled(false)
         , mGoodbye(false)
+        , mHistoryWritten(0)
+        , mHistoryWidth(0)
         , mPersuasionDialog()
     {
         // Centre dialog
@@ -378,6 +380,7 @@ namespace MWGui
             for (std::vector<DialogueText*>::iterator it = mHistoryContents.begin(); it != mHistoryContents.end(); ++it)
                 delete (*it);
             mHistoryContents.clear();
+            mHistoryTypesetter.reset();
         }
 
         for (std::vector<Link*>::iterator it = mLinks.begin(); it != mLinks.end(); ++it)
@@ -406,10 +409,6 @@ namespace MWGui
     void DialogueWindow::setKeywords(std::list<std::string> keyWords)
     {
         mTopicsList->clear();
-        for (std::map<std::string, Link*>::iterator it = mTopicLinks.begin(); it != mTopicLinks.end(); ++it)
-            delete it->second;
-        mTopicLinks.clear();
-        mKeywordSearch.clear();
 
         bool isCompanion = !mPtr.getClass().getScript(mPtr).empty()
                 && mPtr.getRefData().getLocals().getIntVar(mPtr.getClass().getScript(mPtr), "companion");
@@ -448,17 +447,57 @@ namespace MWGui
             mTopicsList->addSeparator();
 
 
+        // Keep the links of topics that are still known, so that the history only has to be
+        // laid out again when the topics have changed.
+        std::map<std::string, Link*> topicLinks;
+        std::vector<std::string> newTopics;
+
         for(std::list<std::string>::iterator it = keyWords.begin(); it != keyWords.end(); ++it)
         {
             mTopicsList->addItem(*it);
 
-            Topic* t = new Topic(*it);
-            mTopicLinks[Misc::StringUtils::lowerCase(*it)] = t;
+            std::string topicId = Misc::StringUtils::lowerCase(*it);
+
+            if (topicLinks.find(topicId) != topicLinks.end())
+                continue;
 
-            mKeywordSearch.seed(Misc::StringUtils::lowerCase(*it), intptr_t(t));
+            std::map<std::string, Link*>::iterator found = mTopicLinks.find(topicId);
+            if (found != mTopicLinks.end())
+            {
+                topicLinks[topicId] = found->second;
+                mTopicLinks.erase(found);
+            }
+            else
+            {
+                topicLinks[topicId] = new Topic(*it);
+                newTopics.push_back(topicId);
+            }
         }
         mTopicsList->adjustSize();
 
+        // Topics that are no longer known are left over in mTopicLinks
+        bool topicsRemoved = !mTopicLinks.empty();
+
+        for (std::map<std::string, Link*>::iterator it = mTopicLinks.begin(); it != mTopicLinks.end(); ++it)
+            delete it->second;
+        mTopicLinks.swap(topicLinks);
+
+        if (topicsRemoved)
+        {
+            mKeywordSearch.clear();
+            for (std::map<std::string, Link*>::iterator it = mTopicLinks.begin(); it != mTopicLinks.end(); ++it)
+                mKeywordSearch.seed(it->first, intptr_t(it->second));
+        }
+        else
+        {
+            // Only seed the new topics, which keeps learning a topic cheap with a long topic list
+            for (std::vector<std::string>::const_iterator it = newTopics.begin(); it != newTopics.end(); ++it)
+                mKeywordSearch.seed(*it, intptr_t(mTopicLinks[*it]));
+        }
+
+        if (topicsRemoved || !newTopics.empty())
+            mHistoryTypesetter.reset();
+
         updateHistory();
     }
 
@@ -475,10 +514,22 @@ namespace MWGui
             mScrollBar->setVisible(true);
         }
 
-        BookTypesetter::Ptr typesetter = BookTypesetter::create (mHistory->getWidth(), std::numeric_limits<int>::max());
+        // Only the entries that have been added since the last update need to be laid out.
+        if (!mHistoryTypesetter || mHistoryWidth != mHistory->getWidth())
+        {
+            mHistoryTypesetter = BookTypesetter::create (mHistory->getWidth(), std::numeric_limits<int>::max());
+            mHistoryWritten = 0;
+            mHistoryWidth = mHistory->getWidth();
+        }
+        else
+            mHistoryTypesetter->rewind();
+
+        BookTypesetter::Ptr typesetter = mHistoryTypesetter;
+
+        for (; mHistoryWritten < mHistoryContents.size(); ++mHistoryWritten)
+            mHistoryContents[mHistoryWritten]->write(typesetter, &mKeywordSearch, mTopicLinks);
 
-        for (std::vector<DialogueText*>::iterator it = mHistoryContents.begin(); it != mHistoryContents.end(); ++it)
-            (*it)->write(typesetter, &mKeywordSearch, mTopicLinks);
+        typesetter->setMark();
 
 
         BookTypesetter::Style* body = typesetter->createStyle("", MyGUI::Colour::White);
@@ -163,6 +163,12 @@ namespace MWGui
 
         KeywordSearchT mKeywordSearch;
 
+        /// The history laid out up to the choices, reused until the history is reset, the topics
+        /// change or the width of the history view changes.
+        BookTypesetter::Ptr mHistoryTypesetter;
+        size_t mHistoryWritten; ///< number of entries of mHistoryContents in mHistoryTypesetter
+        int mHistoryWidth;
+
         BookPage* mHistory;
         Gui::MWList*   mTopicsList;
         MyGUI::ScrollBar* mScrollBar;
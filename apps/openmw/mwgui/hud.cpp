@@ -92,6 +92,8 @@ namespace MWGui
         , mFpsCounter(NULL)
         , mTriangleCounter(NULL)
         , mBatchCounter(NULL)
+        , mSkeletonCounter(NULL)
+        , mBoneCounter(NULL)
         , mHealthManaStaminaBaseLeft(0)
         , mWeapBoxBaseLeft(0)
         , mSpellBoxBaseLeft(0)
@@ -170,6 +172,8 @@ namespace MWGui
 
         getWidget(mTriangleCounter, "TriangleCounter");
         getWidget(mBatchCounter, "BatchCounter");
+        getWidget(mSkeletonCounter, "SkeletonCounter");
+        getWidget(mBoneCounter, "BoneCounter");
 
         LocalMapBase::init(mMinimap, mCompass, Settings::Manager::getInt("local map hud widget size", "Map"));
 
@@ -229,6 +233,16 @@ namespace MWGui
         mBatchCounter->setCaption(MyGUI::utility::toString(count));
     }
 
+    void HUD::setSkeletonCount(unsigned int updated, unsigned int total)
+    {
+        mSkeletonCounter->setCaption(MyGUI::utility::toString(updated) + "/" + MyGUI::utility::toString(total));
+    }
+
+    void HUD::setBoneCount(unsigned int count)
+    {
+        mBoneCounter->setCaption(MyGUI::utility::toString(count));
+    }
+
     void HUD::setValue(const std::string& id, const MWMechanics::DynamicStat<float>& value)
     {
         int current = std::max(0, static_cast<int>(value.getCurrent()));
@@ -25,6 +25,8 @@ namespace MWGui
         void setFPS(float fps);
         void setTriangleCount(unsigned int count);
         void setBatchCount(unsigned int count);
+        void setSkeletonCount(unsigned int updated, unsigned int total);
+        void setBoneCount(unsigned int count);
 
         /// Set time left for the player to start drowning
         /// @param time time left to start drowning
@@ -82,6 +84,8 @@ namespace MWGui
         MyGUI::TextBox* mFpsCounter;
         MyGUI::TextBox* mTriangleCounter;
         MyGUI::TextBox* mBatchCounter;
+        MyGUI::TextBox* mSkeletonCounter;
+        MyGUI::TextBox* mBoneCounter;
 
         // bottom left elements
         int mHealthManaStaminaBaseLeft, mWeapBoxBaseLeft, mSpellBoxBaseLeft, mSneakBoxBaseLeft;
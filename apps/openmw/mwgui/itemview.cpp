@@ -1,5 +1,6 @@
 #include "itemview.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 #include <MyGUI_FactoryManager.h>
@@ -20,6 +21,9 @@ namespace MWGui
 ItemView::ItemView()
     : mModel(NULL)
     , mScrollView(NULL)
+    , mDragArea(NULL)
+    , mItemCount(0)
+    , mRows(1)
 {
 }
 
@@ -44,41 +48,43 @@ void ItemView::initialiseOverride()
         throw std::runtime_error("Item view needs a scroll view");
 
     mScrollView->setCanvasAlign(MyGUI::Align::Left | MyGUI::Align::Top);
+
+    mDragArea = mScrollView->createWidget<MyGUI::Widget>("",0,0,mScrollView->getWidth(),mScrollView->getHeight(),
+                                                         MyGUI::Align::Stretch);
+    mDragArea->setNeedMouseFocus(true);
+    mDragArea->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedBackground);
+    mDragArea->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheel);
+    mDragArea->setVisible(false);
+
+    // the scroll view does not tell when it is scrolled with its scroll bars
+    MyGUI::Gui::getInstance().eventFrameStart += MyGUI::newDelegate(this, &ItemView::onFrame);
+}
+
+void ItemView::shutdownOverride()
+{
+    MyGUI::Gui::getInstance().eventFrameStart -= MyGUI::newDelegate(this, &ItemView::onFrame);
+
+    Base::shutdownOverride();
 }
 
 void ItemView::layoutWidgets()
 {
-    if (!mScrollView->getChildCount())
+    if (!mModel)
         return;
 
-    int x = 0;
-    int y = 0;
-    MyGUI::Widget* dragArea = mScrollView->getChildAt(0);
     int maxHeight = mScrollView->getHeight();
 
     int rows = maxHeight/42;
     rows = std::max(rows, 1);
-    bool showScrollbar = int(std::ceil(dragArea->getChildCount()/float(rows))) > mScrollView->getWidth()/42;
+    bool showScrollbar = int(std::ceil(mItemCount/float(rows))) > mScrollView->getWidth()/42;
     if (showScrollbar)
         maxHeight -= 18;
 
-    for (unsigned int i=0; i<dragArea->getChildCount(); ++i)
-    {
-        MyGUI::Widget* w = dragArea->getChildAt(i);
-
-        w->setPosition(x, y);
-
-        y += 42;
+    mRows = std::max(maxHeight/42, 1);
 
-        if (y > maxHeight-42 && i < dragArea->getChildCount()-1)
-        {
-            x += 42;
-            y = 0;
-        }
-    }
-    x += 42;
+    int columns = std::max((mItemCount + mRows - 1) / mRows, 1);
 
-    MyGUI::IntSize size = MyGUI::IntSize(std::max(mScrollView->getSize().width, x), mScrollView->getSize().height);
+    MyGUI::IntSize size = MyGUI::IntSize(std::max(mScrollView->getSize().width, columns*42), mScrollView->getSize().height);
 
     // Canvas size must be expressed with VScroll disabled, otherwise MyGUI would expand the scroll area when the scrollbar is hidden
     mScrollView->setVisibleVScroll(false);
@@ -86,51 +92,121 @@ void ItemView::layoutWidgets()
     mScrollView->setCanvasSize(size);
     mScrollView->setVisibleVScroll(true);
     mScrollView->setVisibleHScroll(true);
-    dragArea->setSize(size);
+    mDragArea->setSize(size);
+
+    updateVisibleItems();
 }
 
-void ItemView::update()
+ItemWidget* ItemView::getItemWidget(size_t slot)
+{
+    while (mItemWidgets.size() <= slot)
+    {
+        ItemWidget* itemWidget = mDragArea->createWidget<ItemWidget>("MW_ItemIcon",
+            MyGUI::IntCoord(0, 0, 42, 42), MyGUI::Align::Default);
+        itemWidget->setUserString("ToolTipType", "ItemModelIndex");
+        itemWidget->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedItem);
+        itemWidget->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheel);
+
+        mItemWidgets.push_back(itemWidget);
+        mShownItems.push_back(ShownItem());
+    }
+
+    return mItemWidgets[slot];
+}
+
+void ItemView::updateVisibleItems()
 {
-    while (mScrollView->getChildCount())
-        MyGUI::Gui::getInstance().destroyWidget(mScrollView->getChildAt(0));
+    mViewOffset = mScrollView->getViewOffset();
 
-    if (!mModel)
-        return;
+    int firstColumn = std::max(-mViewOffset.left/42 - 1, 0);
+    int lastColumn = (-mViewOffset.left + mScrollView->getWidth())/42 + 1;
 
-    mModel->update();
+    // Items are assigned to slots round robin, so that scrolling leaves the widgets of the
+    // columns that stay in view alone. There are enough slots for two partially visible columns
+    // and the extra column on either side.
+    int slots = (mScrollView->getWidth()/42 + 4) * mRows;
+
+    int first = std::min(firstColumn*mRows, mItemCount);
+    int last = std::min((lastColumn+1)*mRows, mItemCount);
 
-    MyGUI::Widget* dragArea = mScrollView->createWidget<MyGUI::Widget>("",0,0,mScrollView->getWidth(),mScrollView->getHeight(),
-                                                                       MyGUI::Align::Stretch);
-    dragArea->setNeedMouseFocus(true);
-    dragArea->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedBackground);
-    dragArea->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheel);
+    mSlotUsed.assign(mItemWidgets.size(), 0);
 
-    for (ItemModel::ModelIndex i=0; i<static_cast<int>(mModel->getItemCount()); ++i)
+    for (ItemModel::ModelIndex i=first; i<last; ++i)
     {
-        const ItemStack& item = mModel->getItem(i);
+        size_t slot = i % slots;
 
-        ItemWidget* itemWidget = dragArea->createWidget<ItemWidget>("MW_ItemIcon",
-            MyGUI::IntCoord(0, 0, 42, 42), MyGUI::Align::Default);
-        itemWidget->setUserString("ToolTipType", "ItemModelIndex");
+        ItemWidget* itemWidget = getItemWidget(slot);
+        mSlotUsed.resize(mItemWidgets.size(), 0);
+        mSlotUsed[slot] = 1;
+
+        itemWidget->setPosition((i/mRows)*42, (i%mRows)*42);
         itemWidget->setUserData(std::make_pair(i, mModel));
-        ItemWidget::ItemState state = ItemWidget::None;
-        if (item.mType == ItemStack::Type_Barter)
-            state = ItemWidget::Barter;
-        if (item.mType == ItemStack::Type_Equipped)
-            state = ItemWidget::Equip;
-        itemWidget->setItem(item.mBase, state);
-        itemWidget->setCount(item.mCount);
+        itemWidget->setVisible(true);
 
-        itemWidget->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedItem);
-        itemWidget->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheel);
+        const ItemStack& item = mModel->getItem(i);
+
+        ShownItem& shown = mShownItems[slot];
+
+        std::string id = item.mBase.getCellRef().getRefId();
+
+        if (shown.mId != id || shown.mType != item.mType)
+        {
+            ItemWidget::ItemState state = ItemWidget::None;
+            if (item.mType == ItemStack::Type_Barter)
+                state = ItemWidget::Barter;
+            if (item.mType == ItemStack::Type_Equipped)
+                state = ItemWidget::Equip;
+            itemWidget->setItem(item.mBase, state);
+            itemWidget->setCount(item.mCount);
+
+            shown.mId = id;
+            shown.mType = item.mType;
+            shown.mCount = item.mCount;
+        }
+        else if (shown.mCount != item.mCount)
+        {
+            itemWidget->setCount(item.mCount);
+            shown.mCount = item.mCount;
+        }
     }
 
+    for (size_t slot=0; slot<mItemWidgets.size(); ++slot)
+        if (!mSlotUsed[slot])
+            mItemWidgets[slot]->setVisible(false);
+}
+
+void ItemView::update()
+{
+    if (!mModel)
+    {
+        mItemCount = 0;
+
+        mDragArea->setVisible(false);
+        for (size_t slot=0; slot<mItemWidgets.size(); ++slot)
+            mItemWidgets[slot]->setVisible(false);
+
+        return;
+    }
+
+    mModel->update();
+
+    mItemCount = static_cast<int>(mModel->getItemCount());
+
+    mDragArea->setVisible(true);
+
     layoutWidgets();
 }
 
 void ItemView::resetScrollBars()
 {
     mScrollView->setViewOffset(MyGUI::IntPoint(0, 0));
+    updateVisibleItems();
+}
+
+void ItemView::onFrame(float duration)
+{
+    if (mModel && mScrollView->getViewOffset() != mViewOffset)
+        updateVisibleItems();
 }
 
 void ItemView::onSelectedItem(MyGUI::Widget *sender)
@@ -150,6 +226,9 @@ void ItemView::onMouseWheel(MyGUI::Widget *_sender, int _rel)
         mScrollView->setViewOffset(MyGUI::IntPoint(0, 0));
     else
         mScrollView->setViewOffset(MyGUI::IntPoint(static_cast<int>(mScrollView->getViewOffset().left + _rel*0.3f), 0));
+
+    if (mModel)
+        updateVisibleItems();
 }
 
 void ItemView::setSize(const MyGUI::IntSize &_value)
@@ -1,13 +1,21 @@
 #ifndef MWGUI_ITEMVIEW_H
 #define MWGUI_ITEMVIEW_H
 
+#include <string>
+#include <vector>
+
 #include <MyGUI_Widget.h>
 
 #include "itemmodel.hpp"
 
 namespace MWGui
 {
+    class ItemWidget;
 
+    /// @brief Shows the items of an ItemModel as a grid of icons
+    ///
+    /// Widgets are only created for the columns that are visible and reused when the view is
+    /// scrolled or the model changes.
     class ItemView : public MyGUI::Widget
     {
     MYGUI_RTTI_DERIVED(ItemView)
@@ -33,9 +41,30 @@ namespace MWGui
         void resetScrollBars();
 
     private:
+        /// What an item widget currently shows
+        struct ShownItem
+        {
+            std::string mId; ///< empty if nothing has been shown yet
+            ItemStack::Type mType;
+            size_t mCount;
+
+            ShownItem() : mType (ItemStack::Type_Normal), mCount (0) {}
+        };
+
         virtual void initialiseOverride();
+        virtual void shutdownOverride();
 
         void layoutWidgets();
+        ///< Size the canvas for all items and fill the visible part of it.
+
+        void updateVisibleItems();
+        ///< Assign the items in the visible columns (plus one column on either side) to the
+        /// widgets of the pool.
+
+        ItemWidget* getItemWidget (size_t slot);
+        ///< Get the widget from the pool, creating it if necessary.
+
+        void onFrame (float duration);
 
         virtual void setSize(const MyGUI::IntSize& _value);
         virtual void setCoord(const MyGUI::IntCoord& _value);
@@ -46,6 +75,15 @@ namespace MWGui
 
         ItemModel* mModel;
         MyGUI::ScrollView* mScrollView;
+        MyGUI::Widget* mDragArea;
+
+        std::vector<ItemWidget*> mItemWidgets;
+        std::vector<ShownItem> mShownItems; ///< same order as mItemWidgets
+        std::vector<char> mSlotUsed; ///< scratch buffer for updateVisibleItems
+
+        int mItemCount;
+        int mRows; ///< items per column
+        MyGUI::IntPoint mViewOffset; ///< view offset the widgets have been assigned for
 
     };
 
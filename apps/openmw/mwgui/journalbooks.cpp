@@ -1,5 +1,7 @@
 #include "journalbooks.hpp"
 
+#include <sstream>
+
 #include <MyGUI_LanguageManager.h>
 
 namespace
@@ -156,8 +158,30 @@ MWGui::BookTypesetter::Utf8Span to_utf8_span (char const * text)
 typedef TypesetBook::Ptr book;
 
 JournalBooks::JournalBooks (JournalViewModel::Ptr model) :
-    mModel (model)
+    mModel (model), mRevision (0)
+{
+}
+
+book JournalBooks::findBook (const std::string& key)
+{
+    unsigned int revision = mModel->getRevision ();
+
+    if (revision != mRevision)
+    {
+        mBooks.clear ();
+        mRevision = revision;
+        return book ();
+    }
+
+    Books::const_iterator i = mBooks.find (key);
+
+    return i != mBooks.end () ? i->second : book ();
+}
+
+book JournalBooks::addBook (const std::string& key, book newBook)
 {
+    mBooks [key] = newBook;
+    return newBook;
 }
 
 book JournalBooks::createEmptyJournalBook ()
@@ -176,6 +200,9 @@ book JournalBooks::createEmptyJournalBook ()
 
 book JournalBooks::createJournalBook ()
 {
+    if (book cached = findBook ("journal"))
+        return cached;
+
     BookTypesetter::Ptr typesetter = createTypesetter ();
 
     BookTypesetter::Style* header = typesetter->createStyle ("", MyGUI::Colour (0.60f, 0.00f, 0.00f));
@@ -183,11 +210,17 @@ book JournalBooks::createJournalBook ()
 
     mModel->visitJournalEntries ("", AddJournalEntry (typesetter, body, header, true));
 
-    return typesetter->complete ();
+    return addBook ("journal", typesetter->complete ());
 }
 
 book JournalBooks::createTopicBook (uintptr_t topicId)
 {
+    std::ostringstream key;
+    key << "topic " << topicId;
+
+    if (book cached = findBook (key.str ()))
+        return cached;
+
     BookTypesetter::Ptr typesetter = createTypesetter ();
 
     BookTypesetter::Style* header = typesetter->createStyle ("", MyGUI::Colour (0.60f, 0.00f, 0.00f));
@@ -199,11 +232,16 @@ book JournalBooks::createTopicBook (uintptr_t topicId)
 
     mModel->visitTopicEntries (topicId, AddTopicEntry (typesetter, body, header, contentId));
 
-    return typesetter->complete ();
+    return addBook (key.str (), typesetter->complete ());
 }
 
 book JournalBooks::createQuestBook (const std::string& questName)
 {
+    std::string key = "quest " + questName;
+
+    if (book cached = findBook (key))
+        return cached;
+
     BookTypesetter::Ptr typesetter = createTypesetter ();
 
     BookTypesetter::Style* header = typesetter->createStyle ("", MyGUI::Colour (0.60f, 0.00f, 0.00f));
@@ -214,7 +252,7 @@ book JournalBooks::createQuestBook (const std::string& questName)
 
     mModel->visitJournalEntries (questName, AddJournalEntry (typesetter, body, header, false));
 
-    return typesetter->complete ();
+    return addBook (key, typesetter->complete ());
 }
 
 book JournalBooks::createTopicIndexBook ()
@@ -1,6 +1,9 @@
 #ifndef MWGUI_JOURNALBOOKS_HPP
 #define MWGUI_JOURNALBOOKS_HPP
 
+#include <map>
+#include <string>
+
 #include "bookpage.hpp"
 #include "journalviewmodel.hpp"
 
@@ -23,6 +26,17 @@ namespace MWGui
         Book createTopicIndexBook ();
 
     private:
+        typedef std::map <std::string, Book> Books;
+
+        /// books created since the content of the journal last changed
+        Books mBooks;
+        unsigned int mRevision;
+
+        /// returns an empty pointer if the book has to be created
+        Book findBook (const std::string& key);
+
+        Book addBook (const std::string& key, Book book);
+
         BookTypesetter::Ptr createTypesetter ();
     };
 }
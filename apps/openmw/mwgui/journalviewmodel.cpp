@@ -2,11 +2,13 @@
 
 #include <map>
 #include <sstream>
+#include <locale>
 #include <boost/make_shared.hpp>
 
 #include <MyGUI_LanguageManager.h>
 
 #include <components/misc/utf8stream.hpp>
+#include <components/misc/stringops.hpp>
 
 #include <components/translation/translation.hpp>
 
@@ -83,6 +85,11 @@ struct JournalViewModelImpl : JournalViewModel
         return journal->begin () == journal->end ();
     }
 
+    unsigned int getRevision () const
+    {
+        return MWBase::Environment::get().getJournal()->getRevision ();
+    }
+
     template <typename t_iterator, typename Interface>
     struct BaseEntry : Interface
     {
@@ -67,6 +67,10 @@ namespace MWGui
         /// returns true if their are no journal entries to display
         virtual bool isEmpty () const = 0;
 
+        /// returns the revision of the journal, which changes whenever an entry or topic
+        /// response is added or removed
+        virtual unsigned int getRevision () const = 0;
+
         /// walks the active and optionally completed, quests providing the name and completed status
         virtual void visitQuestNames (bool active_only, boost::function <void (const std::string&, bool)> visitor) const = 0;
 
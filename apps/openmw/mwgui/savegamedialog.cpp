@@ -361,8 +361,15 @@ namespace MWGui
 
         mInfoText->setCaptionWithReplacing(text.str());
 
-        // Decode screenshot
-        std::vector<char> data = mCurrentSlot->mProfile.mScreenshot; // MemoryDataStream doesn't work with const data :(
+        // Decode screenshot, only the one of the selected slot is loaded
+        std::vector<char> data = mCurrentCharacter->getScreenshot (mCurrentSlot);
+        if (data.empty())
+        {
+            // still being encoded by a save in progress
+            mScreenshot->setImageTexture("");
+            return;
+        }
+
         Ogre::DataStreamPtr stream(new Ogre::MemoryDataStream(&data[0], data.size()));
         Ogre::Image image;
         image.load(stream, "jpg");
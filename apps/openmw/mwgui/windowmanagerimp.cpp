@@ -174,6 +174,9 @@ namespace MWGui
       , mFPS(0.0f)
       , mTriangleCount(0)
       , mBatchCount(0)
+      , mSkeletonsUpdated(0)
+      , mSkeletonsSkipped(0)
+      , mBonesUpdated(0)
       , mFallbackMap(fallbackMap)
     {
         // Set up the GUI system
@@ -435,6 +438,8 @@ namespace MWGui
         mHud->setFPS(mFPS);
         mHud->setTriangleCount(mTriangleCount);
         mHud->setBatchCount(mBatchCount);
+        mHud->setSkeletonCount(mSkeletonsUpdated, mSkeletonsUpdated + mSkeletonsSkipped);
+        mHud->setBoneCount(mBonesUpdated);
 
         mHud->update();
     }
@@ -1276,6 +1281,14 @@ namespace MWGui
         mBatchCount = batchCount;
     }
 
+    void WindowManager::wmUpdateAnimationStats(unsigned int skeletonsUpdated, unsigned int skeletonsSkipped,
+                                               unsigned int bonesUpdated)
+    {
+        mSkeletonsUpdated = skeletonsUpdated;
+        mSkeletonsSkipped = skeletonsSkipped;
+        mBonesUpdated = bonesUpdated;
+    }
+
     MWGui::DialogueWindow* WindowManager::getDialogueWindow() { return mDialogueWindow;  }
     MWGui::InventoryWindow* WindowManager::getInventoryWindow() { return mInventoryWindow; }
     MWGui::CountDialog* WindowManager::getCountDialog() { return mCountDialog; }
@@ -165,6 +165,9 @@ namespace MWGui
 
     virtual void wmUpdateFps(float fps, unsigned int triangleCount, unsigned int batchCount);
 
+    virtual void wmUpdateAnimationStats(unsigned int skeletonsUpdated, unsigned int skeletonsSkipped,
+                                        unsigned int bonesUpdated);
+
     ///< Set value for the given ID.
     virtual void setValue (const std::string& id, const MWMechanics::AttributeValue& value);
     virtual void setValue (int parSkill, const MWMechanics::SkillValue& value);
@@ -459,6 +462,9 @@ namespace MWGui
     float mFPS;
     unsigned int mTriangleCount;
     unsigned int mBatchCount;
+    unsigned int mSkeletonsUpdated;
+    unsigned int mSkeletonsSkipped;
+    unsigned int mBonesUpdated;
 
     std::map<std::string, std::string> mFallbackMap;
 
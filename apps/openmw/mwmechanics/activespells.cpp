@@ -15,81 +15,122 @@ namespace MWMechanics
 {
     void ActiveSpells::update() const
     {
-        bool rebuild = false;
+        // The expiry times in the queue depend on the time scale.
+        if (MWBase::Environment::get().getWorld()->getTimeScaleFactor()!=mTimeScale)
+            mSpellsChanged = true;
+
+        if (mSpellsChanged)
+        {
+            mSpellsChanged = false;
+            rebuildEffects();
+        }
 
         MWWorld::TimeStamp now = MWBase::Environment::get().getWorld()->getTimeStamp();
 
         // Erase no longer active spells and effects
         if (mLastUpdate!=now)
         {
-            TContainer::iterator iter (mSpells.begin());
-            while (iter!=mSpells.end())
+            while (!mExpiry.empty() && mExpiry.top().mEnd<=now)
             {
-                if (!timeToExpire (iter))
-                {
-                    mSpells.erase (iter++);
-                    rebuild = true;
-                }
-                else
-                {
-                    std::vector<ActiveEffect>& effects = iter->second.mEffects;
-                    for (std::vector<ActiveEffect>::iterator effectIt = effects.begin(); effectIt != effects.end();)
-                    {
-                        MWWorld::TimeStamp start = iter->second.mTimeStamp;
-                        MWWorld::TimeStamp end = start + static_cast<double>(effectIt->mDuration)*MWBase::Environment::get().getWorld()->getTimeScaleFactor()/(60*60);
-                        if (end <= now)
-                        {
-                            effectIt = effects.erase(effectIt);
-                            rebuild = true;
-                        }
-                        else
-                            ++effectIt;
-                    }
-                    ++iter;
-                }
+                std::string id = mExpiry.top().mId;
+                mExpiry.pop();
+                removeExpired (id, now);
             }
 
             mLastUpdate = now;
         }
+    }
 
-        if (mSpellsChanged)
+    void ActiveSpells::removeExpired (const std::string& id, const MWWorld::TimeStamp& now) const
+    {
+        std::pair<TContainer::iterator, TContainer::iterator> range = mSpells.equal_range (id);
+
+        for (TContainer::iterator iter = range.first; iter!=range.second;)
         {
-            mSpellsChanged = false;
-            rebuild = true;
-        }
+            std::vector<ActiveEffect>& effects = iter->second.mEffects;
 
-        if (rebuild)
-            rebuildEffects();
+            for (std::vector<ActiveEffect>::iterator effectIt = effects.begin(); effectIt != effects.end();)
+            {
+                if (getEnd (iter->second.mTimeStamp, effectIt->mDuration) <= now)
+                {
+                    subtractEffect (iter->second, *effectIt);
+                    effectIt = effects.erase(effectIt);
+                }
+                else
+                    ++effectIt;
+            }
+
+            if (effects.empty())
+                mSpells.erase (iter++);
+            else
+                ++iter;
+        }
     }
 
     void ActiveSpells::rebuildEffects() const
     {
-        MWWorld::TimeStamp now = MWBase::Environment::get().getWorld()->getTimeStamp();
-
         mEffects = MagicEffects();
+        mEffectCounts.clear();
+        mExpiry = TExpiryQueue();
+        mTimeScale = MWBase::Environment::get().getWorld()->getTimeScaleFactor();
 
         for (TIterator iter (begin()); iter!=end(); ++iter)
+            addEffects (iter->first, iter->second);
+    }
+
+    MWWorld::TimeStamp ActiveSpells::getEnd (const MWWorld::TimeStamp& start, float duration) const
+    {
+        return start + static_cast<double>(duration)*MWBase::Environment::get().getWorld()->getTimeScaleFactor()/(60*60);
+    }
+
+    void ActiveSpells::addEffects (const std::string& id, const ActiveSpellParams& spell) const
+    {
+        const std::vector<ActiveEffect>& effects = spell.mEffects;
+
+        // a spell without effects is gone with the next update
+        if (effects.empty())
+            mExpiry.push (Expiry (spell.mTimeStamp, id));
+
+        for (std::vector<ActiveEffect>::const_iterator effectIt = effects.begin(); effectIt != effects.end(); ++effectIt)
         {
-            const MWWorld::TimeStamp& start = iter->second.mTimeStamp;
+            MWWorld::TimeStamp end = getEnd (spell.mTimeStamp, effectIt->mDuration);
 
-            const std::vector<ActiveEffect>& effects = iter->second.mEffects;
+            mExpiry.push (Expiry (end, id));
 
-            for (std::vector<ActiveEffect>::const_iterator effectIt = effects.begin(); effectIt != effects.end(); ++effectIt)
+            // must match the test in subtractEffect
+            if (end>spell.mTimeStamp)
             {
-                double duration = effectIt->mDuration;
-                MWWorld::TimeStamp end = start;
-                end += duration * 
-                    MWBase::Environment::get().getWorld()->getTimeScaleFactor()/(60*60);
-
-                if (end>now)
-                    mEffects.add(MWMechanics::EffectKey(effectIt->mEffectId, effectIt->mArg), MWMechanics::EffectParam(effectIt->mMagnitude));
+                EffectKey key (effectIt->mEffectId, effectIt->mArg);
+                mEffects.add(key, MWMechanics::EffectParam(effectIt->mMagnitude));
+                ++mEffectCounts[key];
             }
         }
     }
 
+    void ActiveSpells::subtractEffect (const ActiveSpellParams& spell, const ActiveEffect& effect) const
+    {
+        if (getEnd (spell.mTimeStamp, effect.mDuration)<=spell.mTimeStamp)
+            return; // never added
+
+        EffectKey key (effect.mEffectId, effect.mArg);
+
+        std::map<EffectKey, int>::iterator count = mEffectCounts.find (key);
+        if (count==mEffectCounts.end())
+            return;
+
+        if (--count->second==0)
+        {
+            mEffectCounts.erase (count);
+            mEffects.remove (key);
+        }
+        else
+            mEffects.add (key, MWMechanics::EffectParam(-effect.mMagnitude));
+    }
+
     ActiveSpells::ActiveSpells()
         : mSpellsChanged (false)
         , mLastUpdate (MWBase::Environment::get().getWorld()->getTimeStamp())
+        , mTimeScale (MWBase::Environment::get().getWorld()->getTimeScaleFactor())
     {}
 
     const MagicEffects& ActiveSpells::getMagicEffects() const
@@ -161,6 +202,10 @@ namespace MWMechanics
         if (it == end() || stack)
         {
             mSpells.insert(std::make_pair(id, params));
+
+            // no need for a rebuild, unless one is pending already
+            if (!mSpellsChanged)
+                addEffects(id, params);
         }
         else
         {
@@ -170,9 +215,9 @@ namespace MWMechanics
             // spell effects and add to existing effects of spell
             mergeEffects(params.mEffects, it->second.mEffects);
             it->second = params;
-        }
 
-        mSpellsChanged = true;
+            mSpellsChanged = true;
+        }
     }
 
     void ActiveSpells::mergeEffects(std::vector<ActiveEffect>& addTo, const std::vector<ActiveEffect>& from)
@@ -198,8 +243,17 @@ namespace MWMechanics
 
     void ActiveSpells::removeEffects(const std::string &id)
     {
-        mSpells.erase(Misc::StringUtils::lowerCase(id));
-        mSpellsChanged = true;
+        std::pair<TContainer::iterator, TContainer::iterator> range =
+            mSpells.equal_range(Misc::StringUtils::lowerCase(id));
+
+        // no need to update mEffects if a rebuild is pending
+        if (!mSpellsChanged)
+            for (TContainer::iterator it = range.first; it != range.second; ++it)
+                for (std::vector<ActiveEffect>::const_iterator effectIt = it->second.mEffects.begin();
+                     effectIt != it->second.mEffects.end(); ++effectIt)
+                    subtractEffect(it->second, *effectIt);
+
+        mSpells.erase(range.first, range.second);
     }
 
     void ActiveSpells::visitEffectSources(EffectSourceVisitor &visitor) const
@@ -2,6 +2,7 @@
 #define GAME_MWMECHANICS_ACTIVESPELLS_H
 
 #include <map>
+#include <queue>
 #include <vector>
 #include <string>
 
@@ -46,15 +47,58 @@ namespace MWMechanics
 
         private:
 
+            struct Expiry
+            {
+                MWWorld::TimeStamp mEnd;
+                std::string mId;
+
+                Expiry (const MWWorld::TimeStamp& end, const std::string& id) : mEnd (end), mId (id) {}
+            };
+
+            struct ExpiresLater
+            {
+                bool operator() (const Expiry& left, const Expiry& right) const
+                {
+                    return left.mEnd>right.mEnd;
+                }
+            };
+
+            typedef std::priority_queue<Expiry, std::vector<Expiry>, ExpiresLater> TExpiryQueue;
+
             mutable TContainer mSpells;
             mutable MagicEffects mEffects;
             mutable bool mSpellsChanged;
             mutable MWWorld::TimeStamp mLastUpdate;
 
+            /// End times of the effects in mSpells, earliest first. Entries are not removed along
+            /// with their effects; an entry only means that the spells with that ID need to be
+            /// checked when its time comes.
+            mutable TExpiryQueue mExpiry;
+            mutable float mTimeScale; ///< time scale the entries in mExpiry were calculated with
+
+            /// Number of effects in mSpells that contribute to each entry of mEffects. An entry is
+            /// removed from mEffects once its last effect is gone, instead of subtracting it to 0.
+            mutable std::map<EffectKey, int> mEffectCounts;
+
             void update() const;
-            
+
+            void removeExpired (const std::string& id, const MWWorld::TimeStamp& now) const;
+            ///< Remove the expired effects of the spells with \a id and the spells that have no
+            /// effects left.
+
             void rebuildEffects() const;
 
+            MWWorld::TimeStamp getEnd (const MWWorld::TimeStamp& start, float duration) const;
+
+            void addEffects (const std::string& id, const ActiveSpellParams& spell) const;
+            ///< Add the effects of \a spell to mEffects and queue their end times.
+            ///
+            /// \note Effects without a duration are not added. Other effects that have expired
+            /// already are added and removed again by the next update.
+
+            void subtractEffect (const ActiveSpellParams& spell, const ActiveEffect& effect) const;
+            ///< Take an effect of \a spell that is about to be removed out of mEffects.
+
             /// Add any effects that are in "from" and not in "addTo" to "addTo"
             void mergeEffects(std::vector<ActiveEffect>& addTo, const std::vector<ActiveEffect>& from);
 
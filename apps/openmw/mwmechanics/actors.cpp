@@ -167,7 +167,7 @@ void adjustCommandedActor (const MWWorld::Ptr& actor)
 void getRestorationPerHourOfSleep (const MWWorld::Ptr& ptr, float& health, float& magicka)
 {
     MWMechanics::CreatureStats& stats = ptr.getClass().getCreatureStats (ptr);
-    const MWWorld::Store<ESM::GameSetting>& settings = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
+    const MWWorld::GameSettings& settings = MWBase::Environment::get().getWorld()->getStore().getGameSettings();
 
     bool stunted = stats.getMagicEffects ().get(ESM::MagicEffect::StuntedMagicka).getMagnitude() > 0;
     int endurance = stats.getAttribute (ESM::Attribute::Endurance).getModified ();
@@ -177,7 +177,7 @@ void getRestorationPerHourOfSleep (const MWWorld::Ptr& ptr, float& health, float
     magicka = 0;
     if (!stunted)
     {
-        float fRestMagicMult = settings.find("fRestMagicMult")->getFloat ();
+        float fRestMagicMult = settings.fRestMagicMult;
         magicka = fRestMagicMult * stats.getAttribute(ESM::Attribute::Intelligence).getModified();
     }
 }
@@ -210,7 +210,7 @@ namespace MWMechanics
             if (caster.isEmpty() || !caster.getClass().isActor())
                 return;
 
-            static const float fSoulgemMult = world->getStore().get<ESM::GameSetting>().find("fSoulgemMult")->getFloat();
+            const float fSoulgemMult = world->getStore().getGameSettings().fSoulgemMult;
 
             int creatureSoulValue = mCreature.get<ESM::Creature>()->mBase->mData.mSoul;
             if (creatureSoulValue == 0)
@@ -274,10 +274,8 @@ namespace MWMechanics
     void Actors::updateHeadTracking(const MWWorld::Ptr& actor, const MWWorld::Ptr& targetActor,
                                     MWWorld::Ptr& headTrackTarget, float& sqrHeadTrackDistance)
     {
-        static const float fMaxHeadTrackDistance = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                .find("fMaxHeadTrackDistance")->getFloat();
-        static const float fInteriorHeadTrackMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                .find("fInteriorHeadTrackMult")->getFloat();
+        const float fMaxHeadTrackDistance = MWBase::Environment::get().getWorld()->getStore().getGameSettings().fMaxHeadTrackDistance;
+        const float fInteriorHeadTrackMult = MWBase::Environment::get().getWorld()->getStore().getGameSettings().fInteriorHeadTrackMult;
         float maxDistance = fMaxHeadTrackDistance;
         const ESM::Cell* currentCell = actor.getCell()->getCell();
         if (!currentCell->isExterior() && !(currentCell->mData.mFlags & ESM::Cell::QuasiEx))
@@ -435,9 +433,9 @@ namespace MWMechanics
 
         float base = 1.f;
         if (ptr == MWBase::Environment::get().getWorld()->getPlayerPtr())
-            base = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fPCbaseMagickaMult")->getFloat();
+            base = MWBase::Environment::get().getWorld()->getStore().getGameSettings().fPCbaseMagickaMult;
         else
-            base = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fNPCbaseMagickaMult")->getFloat();
+            base = MWBase::Environment::get().getWorld()->getStore().getGameSettings().fNPCbaseMagickaMult;
 
         double magickaFactor = base +
             creatureStats.getMagicEffects().get (EffectKey (ESM::MagicEffect::FortifyMaximumMagicka)).getMagnitude() * 0.1;
@@ -454,7 +452,7 @@ namespace MWMechanics
             return;
 
         MWMechanics::CreatureStats& stats = ptr.getClass().getCreatureStats (ptr);
-        const MWWorld::Store<ESM::GameSetting>& settings = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
+        const MWWorld::GameSettings& settings = MWBase::Environment::get().getWorld()->getStore().getGameSettings();
 
         if (sleep)
         {
@@ -477,9 +475,9 @@ namespace MWMechanics
             normalizedEncumbrance = 1;
 
         // restore fatigue
-        float fFatigueReturnBase = settings.find("fFatigueReturnBase")->getFloat ();
-        float fFatigueReturnMult = settings.find("fFatigueReturnMult")->getFloat ();
-        float fEndFatigueMult = settings.find("fEndFatigueMult")->getFloat ();
+        float fFatigueReturnBase = settings.fFatigueReturnBase;
+        float fFatigueReturnMult = settings.fFatigueReturnMult;
+        float fEndFatigueMult = settings.fEndFatigueMult;
 
         float x = fFatigueReturnBase + fFatigueReturnMult * (1 - normalizedEncumbrance);
         x *= fEndFatigueMult * endurance;
@@ -499,9 +497,9 @@ namespace MWMechanics
         int endurance = stats.getAttribute (ESM::Attribute::Endurance).getModified ();
 
         // restore fatigue
-        const MWWorld::Store<ESM::GameSetting>& settings = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
-        static const float fFatigueReturnBase = settings.find("fFatigueReturnBase")->getFloat ();
-        static const float fFatigueReturnMult = settings.find("fFatigueReturnMult")->getFloat ();
+        const MWWorld::GameSettings& settings = MWBase::Environment::get().getWorld()->getStore().getGameSettings();
+        const float fFatigueReturnBase = settings.fFatigueReturnBase;
+        const float fFatigueReturnMult = settings.fFatigueReturnMult;
 
         float x = fFatigueReturnBase + fFatigueReturnMult * endurance;
 
@@ -646,8 +644,7 @@ namespace MWMechanics
                 float timeDiff = std::min(7.f, std::max(0.f, std::abs(time - 13)));
                 float damageScale = 1.f - timeDiff / 7.f;
                 // When cloudy, the sun damage effect is halved
-                static float fMagicSunBlockedMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find(
-                            "fMagicSunBlockedMult")->getFloat();
+                const float fMagicSunBlockedMult = MWBase::Environment::get().getWorld()->getStore().getGameSettings().fMagicSunBlockedMult;
 
                 int weather = MWBase::Environment::get().getWorld()->getCurrentWeather();
                 if (weather > 1)
@@ -828,7 +825,7 @@ namespace MWMechanics
             if(timeLeft == 0.0f)
             {
                 // If drowning, apply 3 points of damage per second
-                static const float fSuffocationDamage = world->getStore().get<ESM::GameSetting>().find("fSuffocationDamage")->getFloat();
+                const float fSuffocationDamage = world->getStore().getGameSettings().fSuffocationDamage;
                 ptr.getClass().setActorHealth(ptr, stats.getHealth().getCurrent() - fSuffocationDamage*duration);
 
                 // Play a drowning sound
@@ -842,7 +839,7 @@ namespace MWMechanics
         }
         else
         {
-            static const float fHoldBreathTime = world->getStore().get<ESM::GameSetting>().find("fHoldBreathTime")->getFloat();
+            const float fHoldBreathTime = world->getStore().getGameSettings().fHoldBreathTime;
             stats.setTimeToStartDrowning(fHoldBreathTime);
         }
     }
@@ -959,7 +956,7 @@ namespace MWMechanics
             if (ptr.getClass().isClass(ptr, "Guard") && creatureStats.getAiSequence().getTypeId() != AiPackage::TypeIdPursue && !creatureStats.getAiSequence().isInCombat())
             {
                 const MWWorld::ESMStore& esmStore = MWBase::Environment::get().getWorld()->getStore();
-                int cutoff = esmStore.get<ESM::GameSetting>().find("iCrimeThreshold")->getInt();
+                int cutoff = esmStore.getGameSettings().iCrimeThreshold;
                 // Force dialogue on sight if bounty is greater than the cutoff
                 // In vanilla morrowind, the greeting dialogue is scripted to either arrest the player (< 5000 bounty) or attack (>= 5000 bounty)
                 if (   player.getClass().getNpcStats(player).getBounty() >= cutoff
@@ -967,7 +964,7 @@ namespace MWMechanics
                     && MWBase::Environment::get().getWorld()->getLOS(ptr, player)
                     && MWBase::Environment::get().getMechanicsManager()->awarenessCheck(player, ptr))
                 {
-                    static int iCrimeThresholdMultiplier = esmStore.get<ESM::GameSetting>().find("iCrimeThresholdMultiplier")->getInt();
+                    const int iCrimeThresholdMultiplier = esmStore.getGameSettings().iCrimeThresholdMultiplier;
                     if (player.getClass().getNpcStats(player).getBounty() >= cutoff * iCrimeThresholdMultiplier)
                         MWBase::Environment::get().getMechanicsManager()->startCombat(ptr, player);
                     else
@@ -1213,9 +1210,9 @@ namespace MWMechanics
                 static float sneakSkillTimer = 0.f; // times sneak skill progress from "avoid notice"
 
                 const MWWorld::ESMStore& esmStore = MWBase::Environment::get().getWorld()->getStore();
-                const int radius = esmStore.get<ESM::GameSetting>().find("fSneakUseDist")->getInt();
+                const int radius = static_cast<int>(esmStore.getGameSettings().fSneakUseDist);
 
-                static float fSneakUseDelay = esmStore.get<ESM::GameSetting>().find("fSneakUseDelay")->getFloat();
+                const float fSneakUseDelay = esmStore.getGameSettings().fSneakUseDelay;
 
                 if (sneakTimer >= fSneakUseDelay)
                     sneakTimer = 0.f;
@@ -1456,7 +1453,7 @@ namespace MWMechanics
         std::vector<MWWorld::Ptr> neighbors;
         Ogre::Vector3 position = Ogre::Vector3(actor.getRefData().getPosition().pos);
         getObjectsInRange(position,
-            MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fAlarmRadius")->getFloat(),
+            MWBase::Environment::get().getWorld()->getStore().getGameSettings().fAlarmRadius,
             neighbors); //only care about those within the alarm disance
         for(std::vector<MWWorld::Ptr>::iterator iter(neighbors.begin());iter != neighbors.end();++iter)
         {
@@ -344,7 +344,7 @@ namespace MWMechanics
             if (weaptype == WeapType_HandToHand)
             {
                 static float fHandToHandReach =
-                    world->getStore().get<ESM::GameSetting>().find("fHandToHandReach")->getFloat();
+                    world->getStore().getGameSettings().fHandToHandReach;
                 weapRange = fHandToHandReach;
             }
             else if (weaptype != WeapType_PickProbe && weaptype != WeapType_Spell && weaptype != WeapType_None)
@@ -405,7 +405,7 @@ namespace MWMechanics
                 if (actor.getClass().isNpc())
                 {
                     const MWWorld::ESMStore &store = world->getStore();
-                    int chance = store.get<ESM::GameSetting>().find("iVoiceAttackOdds")->getInt();
+                    int chance = store.getGameSettings().iVoiceAttackOdds;
                     if (Misc::Rng::roll0to99() < chance)
                     {
                         MWBase::Environment::get().getDialogueManager()->say(actor, "attack");
@@ -831,7 +831,6 @@ void getMinMaxAttackDuration(const MWWorld::Ptr& actor, float (*fMinMaxDurations
 
     std::string weapGroup;
     MWMechanics::getWeaponGroup(weaptype, weapGroup);
-    weapGroup = weapGroup + ": ";
 
     bool bRangedWeap = (weaptype >= MWMechanics::WeapType_BowAndArrow && weaptype <= MWMechanics::WeapType_Thrown);
 
@@ -843,7 +842,7 @@ void getMinMaxAttackDuration(const MWWorld::Ptr& actor, float (*fMinMaxDurations
     // get durations for each attack type
     for (int i = 0; i < (bRangedWeap ? 1 : 3); i++)
     {
-        float start1 = anim->getTextKeyTime(weapGroup + (bRangedWeap ? attackType[3] : attackType[i]) + textKey);
+        float start1 = anim->getTextKeyTime(weapGroup, (bRangedWeap ? attackType[3] : attackType[i]) + textKey);
 
         if (start1 < 0) 
         {
@@ -852,12 +851,12 @@ void getMinMaxAttackDuration(const MWWorld::Ptr& actor, float (*fMinMaxDurations
         }
 
         textKey2 = "min attack";
-        float start2 = anim->getTextKeyTime(weapGroup + (bRangedWeap ? attackType[3] : attackType[i]) + textKey2);
+        float start2 = anim->getTextKeyTime(weapGroup, (bRangedWeap ? attackType[3] : attackType[i]) + textKey2);
 
         fMinMaxDurations[i][0] = (start2 - start1) / weapSpeed;
 
         textKey2 = "max attack";
-        start1 = anim->getTextKeyTime(weapGroup + (bRangedWeap ? attackType[3] : attackType[i]) + textKey2);
+        start1 = anim->getTextKeyTime(weapGroup, (bRangedWeap ? attackType[3] : attackType[i]) + textKey2);
 
         fMinMaxDurations[i][1] = fMinMaxDurations[i][0] + (start1 - start2) / weapSpeed;
     }
@@ -872,20 +871,20 @@ Ogre::Vector3 AimDirToMovingTarget(const MWWorld::Ptr& actor, const MWWorld::Ptr
     // get projectile speed (depending on weapon type)
     if (weapType == ESM::Weapon::MarksmanThrown)
     {
-        static float fThrownWeaponMinSpeed = 
-            MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fThrownWeaponMinSpeed")->getFloat();
-        static float fThrownWeaponMaxSpeed = 
-            MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fThrownWeaponMaxSpeed")->getFloat();
+        const float fThrownWeaponMinSpeed = 
+            MWBase::Environment::get().getWorld()->getStore().getGameSettings().fThrownWeaponMinSpeed;
+        const float fThrownWeaponMaxSpeed = 
+            MWBase::Environment::get().getWorld()->getStore().getGameSettings().fThrownWeaponMaxSpeed;
 
         projSpeed = 
             fThrownWeaponMinSpeed + (fThrownWeaponMaxSpeed - fThrownWeaponMinSpeed) * strength;
     }
     else
     {
-        static float fProjectileMinSpeed = 
-            MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fProjectileMinSpeed")->getFloat();
-        static float fProjectileMaxSpeed = 
-            MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find("fProjectileMaxSpeed")->getFloat();
+        const float fProjectileMinSpeed = 
+            MWBase::Environment::get().getWorld()->getStore().getGameSettings().fProjectileMinSpeed;
+        const float fProjectileMaxSpeed = 
+            MWBase::Environment::get().getWorld()->getStore().getGameSettings().fProjectileMaxSpeed;
 
         projSpeed = 
             fProjectileMinSpeed + (fProjectileMaxSpeed - fProjectileMinSpeed) * strength;
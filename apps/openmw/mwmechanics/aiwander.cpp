@@ -326,8 +326,8 @@ namespace MWMechanics
         {
             MWWorld::Ptr player = MWBase::Environment::get().getWorld()->getPlayerPtr();
 
-            static float fVoiceIdleOdds = MWBase::Environment::get().getWorld()->getStore()
-                    .get<ESM::GameSetting>().find("fVoiceIdleOdds")->getFloat();
+            const float fVoiceIdleOdds = MWBase::Environment::get().getWorld()->getStore()
+                    .getGameSettings().fVoiceIdleOdds;
 
             float roll = Misc::Rng::rollProbability() * 10000.0f;
 
@@ -430,7 +430,7 @@ namespace MWMechanics
             int hello = cStats.getAiSetting(CreatureStats::AI_Hello).getModified();
             float helloDistance = static_cast<float>(hello);
             static int iGreetDistanceMultiplier =MWBase::Environment::get().getWorld()->getStore()
-                .get<ESM::GameSetting>().find("iGreetDistanceMultiplier")->getInt();
+                .getGameSettings().iGreetDistanceMultiplier;
 
             helloDistance *= iGreetDistanceMultiplier;
 
@@ -627,8 +627,8 @@ namespace MWMechanics
 
         for(unsigned int counter = 0; counter < mIdle.size(); counter++)
         {
-            static float fIdleChanceMultiplier = MWBase::Environment::get().getWorld()->getStore()
-                .get<ESM::GameSetting>().find("fIdleChanceMultiplier")->getFloat();
+            const float fIdleChanceMultiplier = MWBase::Environment::get().getWorld()->getStore()
+                .getGameSettings().fIdleChanceMultiplier;
 
             unsigned short idleChance = static_cast<unsigned short>(fIdleChanceMultiplier * mIdle[counter]);
             unsigned short randSelect = (int)(Misc::Rng::rollProbability() * int(100 / fIdleChanceMultiplier));
@@ -110,18 +110,18 @@ MWMechanics::CharacterState runStateToWalkState (MWMechanics::CharacterState sta
 float getFallDamage(const MWWorld::Ptr& ptr, float fallHeight)
 {
     MWBase::World *world = MWBase::Environment::get().getWorld();
-    const MWWorld::Store<ESM::GameSetting> &store = world->getStore().get<ESM::GameSetting>();
+    const MWWorld::GameSettings& store = world->getStore().getGameSettings();
 
-    const float fallDistanceMin = store.find("fFallDamageDistanceMin")->getFloat();
+    const float fallDistanceMin = store.fFallDamageDistanceMin;
 
     if (fallHeight >= fallDistanceMin)
     {
         const float acrobaticsSkill = static_cast<float>(ptr.getClass().getSkill(ptr, ESM::Skill::Acrobatics));
         const float jumpSpellBonus = ptr.getClass().getCreatureStats(ptr).getMagicEffects().get(ESM::MagicEffect::Jump).getMagnitude();
-        const float fallAcroBase = store.find("fFallAcroBase")->getFloat();
-        const float fallAcroMult = store.find("fFallAcroMult")->getFloat();
-        const float fallDistanceBase = store.find("fFallDistanceBase")->getFloat();
-        const float fallDistanceMult = store.find("fFallDistanceMult")->getFloat();
+        const float fallAcroBase = store.fFallAcroBase;
+        const float fallAcroMult = store.fFallAcroMult;
+        const float fallDistanceBase = store.fFallDistanceBase;
+        const float fallDistanceMult = store.fFallDistanceMult;
 
         float x = fallHeight - fallDistanceMin;
         x -= (1.5f * acrobaticsSkill) + jumpSpellBonus;
@@ -736,7 +736,7 @@ void CharacterController::updateIdleStormState()
         {
             if (mAnimation->isPlaying("idlestorm"))
             {
-                if (mAnimation->getCurrentTime("idlestorm") < mAnimation->getTextKeyTime("idlestorm: loop stop"))
+                if (mAnimation->getCurrentTime("idlestorm") < mAnimation->getTextKeyTime("idlestorm", "loop stop"))
                 {
                     mAnimation->play("idlestorm", Priority_Storm, MWRender::Animation::Group_RightArm, true,
                                      1.0f, "loop stop", "stop", 0.0f, 0);
@@ -1099,7 +1099,7 @@ bool CharacterController::updateWeaponState()
                 else
                 {
                     if(isWeapon && mPtr == MWBase::Environment::get().getWorld()->getPlayerPtr() &&
-                            Settings::Manager::getBool("best attack", "Game"))
+                            Settings::Manager::getSnapshot().getBool(Settings::Key_BestAttack))
                     {
                         MWWorld::ContainerStoreIterator weapon = mPtr.getClass().getInventoryStore(mPtr).getSlot(MWWorld::InventoryStore::Slot_CarriedRight);
                         mAttackType = getBestAttack(weapon->get<ESM::Weapon>()->mBase);
@@ -1448,16 +1448,16 @@ void CharacterController::update(float duration)
         }
 
         // reduce fatigue
-        const MWWorld::Store<ESM::GameSetting> &gmst = world->getStore().get<ESM::GameSetting>();
+        const MWWorld::GameSettings& gmst = world->getStore().getGameSettings();
         float fatigueLoss = 0;
-        static const float fFatigueRunBase = gmst.find("fFatigueRunBase")->getFloat();
-        static const float fFatigueRunMult = gmst.find("fFatigueRunMult")->getFloat();
-        static const float fFatigueSwimWalkBase = gmst.find("fFatigueSwimWalkBase")->getFloat();
-        static const float fFatigueSwimRunBase = gmst.find("fFatigueSwimRunBase")->getFloat();
-        static const float fFatigueSwimWalkMult = gmst.find("fFatigueSwimWalkMult")->getFloat();
-        static const float fFatigueSwimRunMult = gmst.find("fFatigueSwimRunMult")->getFloat();
-        static const float fFatigueSneakBase = gmst.find("fFatigueSneakBase")->getFloat();
-        static const float fFatigueSneakMult = gmst.find("fFatigueSneakMult")->getFloat();
+        const float fFatigueRunBase = gmst.fFatigueRunBase;
+        const float fFatigueRunMult = gmst.fFatigueRunMult;
+        const float fFatigueSwimWalkBase = gmst.fFatigueSwimWalkBase;
+        const float fFatigueSwimRunBase = gmst.fFatigueSwimRunBase;
+        const float fFatigueSwimWalkMult = gmst.fFatigueSwimWalkMult;
+        const float fFatigueSwimRunMult = gmst.fFatigueSwimRunMult;
+        const float fFatigueSneakBase = gmst.fFatigueSneakBase;
+        const float fFatigueSneakMult = gmst.fFatigueSneakMult;
 
         const float encumbrance = cls.getEncumbrance(mPtr) / cls.getCapacity(mPtr);
         if (encumbrance < 1)
@@ -1502,8 +1502,8 @@ void CharacterController::update(float duration)
             forcestateupdate = (mJumpState != JumpState_InAir);
             mJumpState = JumpState_InAir;
 
-            static const float fJumpMoveBase = gmst.find("fJumpMoveBase")->getFloat();
-            static const float fJumpMoveMult = gmst.find("fJumpMoveMult")->getFloat();
+            const float fJumpMoveBase = gmst.fJumpMoveBase;
+            const float fJumpMoveMult = gmst.fJumpMoveMult;
             float factor = fJumpMoveBase + fJumpMoveMult * mPtr.getClass().getSkill(mPtr, ESM::Skill::Acrobatics)/100.f;
             factor = std::min(1.f, factor);
             vec.x *= factor;
@@ -1529,9 +1529,9 @@ void CharacterController::update(float duration)
                     cls.skillUsageSucceeded(mPtr, ESM::Skill::Acrobatics, 0);
 
                 // decrease fatigue
-                const MWWorld::Store<ESM::GameSetting> &gmst = world->getStore().get<ESM::GameSetting>();
-                const float fatigueJumpBase = gmst.find("fFatigueJumpBase")->getFloat();
-                const float fatigueJumpMult = gmst.find("fFatigueJumpMult")->getFloat();
+                const MWWorld::GameSettings& gmst = world->getStore().getGameSettings();
+                const float fatigueJumpBase = gmst.fFatigueJumpBase;
+                const float fatigueJumpMult = gmst.fFatigueJumpMult;
                 float normalizedEncumbrance = mPtr.getClass().getNormalizedEncumbrance(mPtr);
                 if (normalizedEncumbrance > 1)
                     normalizedEncumbrance = 1;
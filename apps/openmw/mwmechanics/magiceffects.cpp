@@ -2,6 +2,7 @@
 
 #include <cstdlib>
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <components/esm/effectlist.hpp>
@@ -86,18 +87,108 @@ namespace MWMechanics
         return *this;
     }
 
+    MagicEffects::const_iterator::const_iterator (const MagicEffects *effects, int index,
+        std::map<EffectKey, EffectParam>::const_iterator argIter)
+    : mEffects (effects), mIndex (effects->findPresent (index)), mArgIter (argIter), mOnIndex (false)
+    {
+        settle();
+    }
+
+    void MagicEffects::const_iterator::settle()
+    {
+        // merge the two sorted sequences
+        mOnIndex = mIndex<sSize &&
+            (mArgIter==mEffects->mArgEffects.end() || EffectKey (mIndex) < mArgIter->first);
+
+        if (mOnIndex)
+        {
+            mValue.first = EffectKey (mIndex);
+            mValue.second = mEffects->get (mValue.first);
+        }
+        else if (mArgIter!=mEffects->mArgEffects.end())
+            mValue = *mArgIter;
+    }
+
+    MagicEffects::const_iterator& MagicEffects::const_iterator::operator++()
+    {
+        if (mOnIndex)
+            mIndex = mEffects->findPresent (mIndex+1);
+        else
+            ++mArgIter;
+
+        settle();
+        return *this;
+    }
+
+    MagicEffects::const_iterator MagicEffects::const_iterator::operator++ (int)
+    {
+        const_iterator iter (*this);
+        ++*this;
+        return iter;
+    }
+
+    bool MagicEffects::const_iterator::operator== (const const_iterator& iter) const
+    {
+        return mIndex==iter.mIndex && mArgIter==iter.mArgIter;
+    }
+
+    bool MagicEffects::isIndexed (const EffectKey& key)
+    {
+        return key.mArg==-1 && key.mId>=0 && key.mId<sSize;
+    }
+
+    int MagicEffects::findPresent (int index) const
+    {
+        while (index<sSize && !mPresent[index])
+            ++index;
+
+        return index;
+    }
+
+    MagicEffects::MagicEffects()
+    {
+        std::fill (mModifiers, mModifiers+sSize, 0.f);
+        std::fill (mBases, mBases+sSize, 0);
+        std::fill (mPresent, mPresent+sSize, 0);
+    }
+
+    MagicEffects::const_iterator MagicEffects::begin() const
+    {
+        return const_iterator (this, 0, mArgEffects.begin());
+    }
+
+    MagicEffects::const_iterator MagicEffects::end() const
+    {
+        return const_iterator (this, sSize, mArgEffects.end());
+    }
+
     void MagicEffects::remove(const EffectKey &key)
     {
-        mCollection.erase(key);
+        if (isIndexed (key))
+        {
+            mModifiers[key.mId] = 0;
+            mBases[key.mId] = 0;
+            mPresent[key.mId] = 0;
+        }
+        else
+            mArgEffects.erase(key);
     }
 
     void MagicEffects::add (const EffectKey& key, const EffectParam& param)
     {
-        Collection::iterator iter = mCollection.find (key);
+        if (isIndexed (key))
+        {
+            mModifiers[key.mId] += param.getModifier();
+            mBases[key.mId] += param.getBase();
+            mPresent[key.mId] = 1;
+            return;
+        }
+
+        std::map<EffectKey, EffectParam>::iterator iter = mArgEffects.find (key);
 
-        if (iter==mCollection.end())
+        if (iter==mArgEffects.end())
         {
-            mCollection.insert (std::make_pair (key, param));
+            mArgEffects.insert (std::make_pair (key, param));
         }
         else
         {
@@ -107,19 +198,32 @@ namespace MWMechanics
 
     void MagicEffects::modifyBase(const EffectKey &key, int diff)
     {
-        mCollection[key].modifyBase(diff);
+        if (isIndexed (key))
+        {
+            mBases[key.mId] += diff;
+            mPresent[key.mId] = 1;
+        }
+        else
+            mArgEffects[key].modifyBase(diff);
     }
 
     void MagicEffects::setModifiers(const MagicEffects &effects)
     {
-        for (Collection::iterator it = mCollection.begin(); it != mCollection.end(); ++it)
+        // effects that are not present have a modifier of 0
+        for (int i=0; i<sSize; ++i)
+        {
+            mModifiers[i] = effects.mModifiers[i];
+            mPresent[i] |= effects.mPresent[i];
+        }
+
+        for (std::map<EffectKey, EffectParam>::iterator it = mArgEffects.begin(); it != mArgEffects.end(); ++it)
         {
             it->second.setModifier(effects.get(it->first).getModifier());
         }
 
-        for (Collection::const_iterator it = effects.begin(); it != effects.end(); ++it)
+        for (std::map<EffectKey, EffectParam>::const_iterator it = effects.mArgEffects.begin(); it != effects.mArgEffects.end(); ++it)
         {
-            mCollection[it->first].setModifier(it->second.getModifier());
+            mArgEffects[it->first].setModifier(it->second.getModifier());
         }
     }
 
@@ -132,14 +236,25 @@ namespace MWMechanics
             return *this;
         }
 
-        for (Collection::const_iterator iter (effects.begin()); iter!=effects.end(); ++iter)
+        // plain loops over the arrays, so that the compiler can vectorise them
+        for (int i=0; i<sSize; ++i)
+            mModifiers[i] += effects.mModifiers[i];
+
+        for (int i=0; i<sSize; ++i)
+            mBases[i] += effects.mBases[i];
+
+        for (int i=0; i<sSize; ++i)
+            mPresent[i] |= effects.mPresent[i];
+
+        for (std::map<EffectKey, EffectParam>::const_iterator iter (effects.mArgEffects.begin());
+            iter!=effects.mArgEffects.end(); ++iter)
         {
-            Collection::iterator result = mCollection.find (iter->first);
+            std::map<EffectKey, EffectParam>::iterator result = mArgEffects.find (iter->first);
 
-            if (result!=mCollection.end())
+            if (result!=mArgEffects.end())
                 result->second += iter->second;
             else
-                mCollection.insert (*iter);
+                mArgEffects.insert (*iter);
         }
 
         return *this;
@@ -147,9 +262,16 @@ namespace MWMechanics
 
     EffectParam MagicEffects::get (const EffectKey& key) const
     {
-        Collection::const_iterator iter = mCollection.find (key);
+        if (isIndexed (key))
+        {
+            EffectParam param (mModifiers[key.mId]);
+            param.setBase (mBases[key.mId]);
+            return param;
+        }
+
+        std::map<EffectKey, EffectParam>::const_iterator iter = mArgEffects.find (key);
 
-        if (iter==mCollection.end())
+        if (iter==mArgEffects.end())
         {
             return EffectParam();
         }
@@ -163,12 +285,21 @@ namespace MWMechanics
     {
         MagicEffects result;
 
+        // effects that are not present count as 0
+        for (int i=0; i<sSize; ++i)
+        {
+            result.mModifiers[i] = now.mModifiers[i] - prev.mModifiers[i];
+            result.mBases[i] = now.mBases[i] - prev.mBases[i];
+            result.mPresent[i] = now.mPresent[i] | prev.mPresent[i];
+        }
+
         // adding/changing
-        for (Collection::const_iterator iter (now.begin()); iter!=now.end(); ++iter)
+        for (std::map<EffectKey, EffectParam>::const_iterator iter (now.mArgEffects.begin());
+            iter!=now.mArgEffects.end(); ++iter)
         {
-            Collection::const_iterator other = prev.mCollection.find (iter->first);
+            std::map<EffectKey, EffectParam>::const_iterator other = prev.mArgEffects.find (iter->first);
 
-            if (other==prev.end())
+            if (other==prev.mArgEffects.end())
             {
                 // adding
                 result.add (iter->first, iter->second);
@@ -181,10 +312,11 @@ namespace MWMechanics
         }
 
         // removing
-        for (Collection::const_iterator iter (prev.begin()); iter!=prev.end(); ++iter)
+        for (std::map<EffectKey, EffectParam>::const_iterator iter (prev.mArgEffects.begin());
+            iter!=prev.mArgEffects.end(); ++iter)
         {
-            Collection::const_iterator other = now.mCollection.find (iter->first);
-            if (other==now.end())
+            std::map<EffectKey, EffectParam>::const_iterator other = now.mArgEffects.find (iter->first);
+            if (other==now.mArgEffects.end())
             {
                 result.add (iter->first, EffectParam() - iter->second);
             }
@@ -196,7 +328,7 @@ namespace MWMechanics
     void MagicEffects::writeState(ESM::MagicEffects &state) const
     {
         // Don't need to save Modifiers, they are recalculated every frame anyway.
-        for (Collection::const_iterator iter (begin()); iter!=end(); ++iter)
+        for (const_iterator iter (begin()); iter!=end(); ++iter)
         {
             if (iter->second.getBase() != 0)
             {
@@ -210,7 +342,15 @@ namespace MWMechanics
     {
         for (std::map<int, int>::const_iterator it = state.mEffects.begin(); it != state.mEffects.end(); ++it)
         {
-            mCollection[EffectKey(it->first)].setBase(it->second);
+            EffectKey key (it->first);
+
+            if (isIndexed (key))
+            {
+                mBases[key.mId] = it->second;
+                mPresent[key.mId] = 1;
+            }
+            else
+                mArgEffects[key].setBase(it->second);
         }
     }
 }
@@ -4,6 +4,8 @@
 #include <map>
 #include <string>
 
+#include <components/esm/loadmgef.hpp>
+
 namespace ESM
 {
     struct ENAMstruct;
@@ -80,21 +82,67 @@ namespace MWMechanics
     };
 
     /// \brief Effects currently affecting a NPC or creature
+    ///
+    /// Effects without an argument are stored in a fixed size array indexed by effect ID. Effects
+    /// with a skill or attribute argument are kept in a separate map.
     class MagicEffects
     {
         public:
 
-            typedef std::map<EffectKey, EffectParam> Collection;
+            /// \brief Iterates over the effects in EffectKey order
+            class const_iterator
+            {
+                    const MagicEffects *mEffects;
+                    int mIndex; // next effect without an argument that is present
+                    std::map<EffectKey, EffectParam>::const_iterator mArgIter;
+                    bool mOnIndex; // the current effect is the one at mIndex
+                    std::pair<EffectKey, EffectParam> mValue;
+
+                    void settle();
+
+                public:
+
+                    const_iterator (const MagicEffects *effects, int index,
+                        std::map<EffectKey, EffectParam>::const_iterator argIter);
+
+                    const std::pair<EffectKey, EffectParam>& operator*() const { return mValue; }
+
+                    const std::pair<EffectKey, EffectParam> *operator->() const { return &mValue; }
+
+                    const_iterator& operator++();
+
+                    const_iterator operator++ (int);
+
+                    bool operator== (const const_iterator& iter) const;
+
+                    bool operator!= (const const_iterator& iter) const { return !(*this==iter); }
+            };
 
         private:
 
-            Collection mCollection;
+            static const int sSize = ESM::MagicEffect::Length;
+
+            // Effects without an argument. Effects that are not present always have 0 in both
+            // arrays, so that whole effect sets can be combined element by element.
+            float mModifiers[sSize];
+            int mBases[sSize];
+            unsigned char mPresent[sSize];
+
+            std::map<EffectKey, EffectParam> mArgEffects; // all other effects
+
+            static bool isIndexed (const EffectKey& key);
+
+            int findPresent (int index) const;
+            ///< \return Index of the first effect without an argument from \a index onwards
+            /// (sSize if there is none).
 
         public:
 
-            Collection::const_iterator begin() const { return mCollection.begin(); }
+            MagicEffects();
+
+            const_iterator begin() const;
 
-            Collection::const_iterator end() const { return mCollection.end(); }
+            const_iterator end() const;
 
             void readState (const ESM::MagicEffects& state);
             void writeState (ESM::MagicEffects& state) const;
@@ -156,8 +156,7 @@ namespace MWMechanics
             x *= it->mArea * 0.05f * magicEffect->mData.mBaseCost;
             if (it->mRange == ESM::RT_Target)
                 x *= 1.5f;
-            static const float fEffectCostMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>().find(
-                        "fEffectCostMult")->getFloat();
+            const float fEffectCostMult = MWBase::Environment::get().getWorld()->getStore().getGameSettings().fEffectCostMult;
             x *= fEffectCostMult;
 
             float s = 2.0f * actor.getClass().getSkill(actor, spellSchoolToSkill(magicEffect->mData.mSchool));
@@ -812,8 +811,8 @@ namespace MWMechanics
             CreatureStats& stats = mCaster.getClass().getCreatureStats(mCaster);
 
             // Reduce fatigue (note that in the vanilla game, both GMSTs are 0, and there's no fatigue loss)
-            static const float fFatigueSpellBase = store.get<ESM::GameSetting>().find("fFatigueSpellBase")->getFloat();
-            static const float fFatigueSpellMult = store.get<ESM::GameSetting>().find("fFatigueSpellMult")->getFloat();
+            const float fFatigueSpellBase = store.getGameSettings().fFatigueSpellBase;
+            const float fFatigueSpellMult = store.getGameSettings().fFatigueSpellMult;
             DynamicStat<float> fatigue = stats.getFatigue();
             const float normalizedEncumbrance = mCaster.getClass().getNormalizedEncumbrance(mCaster);
             float fatigueLoss = spell->mData.mCost * (fFatigueSpellBase + normalizedEncumbrance * fFatigueSpellMult);
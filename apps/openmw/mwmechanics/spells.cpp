@@ -73,7 +73,7 @@ namespace MWMechanics
             if (mPermanentSpellEffects.find(lower) != mPermanentSpellEffects.end())
             {
                 MagicEffects & effects = mPermanentSpellEffects[lower];
-                for (MagicEffects::Collection::const_iterator effectIt = effects.begin(); effectIt != effects.end();)
+                for (MagicEffects::const_iterator effectIt = effects.begin(); effectIt != effects.end();)
                 {
                     const ESM::MagicEffect * magicEffect = MWBase::Environment::get().getWorld()->getStore().get<ESM::MagicEffect>().find(effectIt->first.mId);
                     if (magicEffect->mData.mFlags & ESM::MagicEffect::Harmful)
@@ -378,7 +378,7 @@ namespace MWMechanics
         for (std::map<std::string, MagicEffects>::const_iterator it = mPermanentSpellEffects.begin(); it != mPermanentSpellEffects.end(); ++it)
         {
             std::vector<ESM::SpellState::PermanentSpellEffectInfo> effectList;
-            for (MagicEffects::Collection::const_iterator effectIt = it->second.begin(); effectIt != it->second.end(); ++effectIt)
+            for (MagicEffects::const_iterator effectIt = it->second.begin(); effectIt != it->second.end(); ++effectIt)
             {
                 ESM::SpellState::PermanentSpellEffectInfo info;
                 info.mId = effectIt->first.mId;
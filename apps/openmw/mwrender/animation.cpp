@@ -14,6 +14,7 @@
 #include <OgreStaticGeometry.h>
 #include <OgreSceneNode.h>
 #include <OgreTechnique.h>
+#include <OgreCamera.h>
 
 #include <components/esm/loadligh.hpp>
 #include <components/esm/loadweap.hpp>
@@ -44,6 +45,9 @@
 namespace MWRender
 {
 
+Animation::LodStats Animation::sFrameStats;
+Animation::LodStats Animation::sLastFrameStats;
+
 Ogre::Real Animation::AnimationTime::getValue() const
 {
     AnimStateMap::const_iterator iter = mAnimation->mStates.find(mAnimationName);
@@ -75,7 +79,24 @@ Animation::Animation(const MWWorld::Ptr &ptr, Ogre::SceneNode *node)
     , mNonAccumCtrl(NULL)
     , mAccumulate(0.0f)
     , mNullAnimationTimePtr(OGRE_NEW NullAnimationTime)
+    , mLodEnabled(Settings::Manager::getBool("animation lod", "Objects"))
+    , mLodFullRateDistance(Settings::Manager::getFloat("animation lod full rate distance", "Objects"))
+    , mLodFullRateSize(Settings::Manager::getFloat("animation lod full rate size", "Objects"))
+    , mLodMaxInterval(0.0f)
+    , mLodOffscreenInterval(0.0f)
+    , mSkeletonUpdateInterval(0.0f)
+    , mSkeletonUpdateTimer(0.0f)
+    , mSkeletonUpdated(true)
+    , mForceSkeletonUpdate(false)
+    , mAccumRootPosition(0.0f)
+    , mAccumRootPending(false)
 {
+    float minRate = Settings::Manager::getFloat("animation lod min rate", "Objects");
+    mLodMaxInterval = (minRate > 0.0f) ? 1.0f / minRate : 0.0f;
+
+    float offscreenRate = Settings::Manager::getFloat("animation lod offscreen rate", "Objects");
+    mLodOffscreenInterval = (offscreenRate > 0.0f) ? 1.0f / offscreenRate : 0.0f;
+
     for(size_t i = 0;i < sNumGroups;i++)
         mAnimationTimePtr[i].bind(OGRE_NEW AnimationTime(this));
 }
@@ -265,6 +286,8 @@ void Animation::addAnimSource(const std::string &model)
     if(animsrc->mTextKeys.empty() || ctrls.empty())
         return;
 
+    indexTextKeys(*animsrc);
+
     mAnimSources.push_back(animsrc);
 
     std::vector<Ogre::Controller<Ogre::Real> > *grpctrls = animsrc->mControllers;
@@ -427,16 +450,43 @@ Ogre::Node* Animation::getNode(int handle)
     return NULL;
 }
 
-NifOgre::TextKeyMap::const_iterator Animation::findGroupStart(const NifOgre::TextKeyMap &keys, const std::string &groupname)
+void Animation::indexTextKeys(AnimSource &source)
 {
-    NifOgre::TextKeyMap::const_iterator iter(keys.begin());
-    for(;iter != keys.end();++iter)
+    source.mGroupKeys.clear();
+
+    const NifOgre::TextKeyMap &keys = source.mTextKeys;
+    for(NifOgre::TextKeyMap::const_iterator iter(keys.begin());iter != keys.end();++iter)
     {
-        if(iter->second.compare(0, groupname.size(), groupname) == 0 &&
-           iter->second.compare(groupname.size(), 2, ": ") == 0)
-            break;
+        std::string::size_type sep = iter->second.find(": ");
+        if(sep == std::string::npos)
+            continue;
+
+        GroupKey key;
+        key.mKey = iter;
+        key.mName = iter->second.substr(sep+2);
+        if(key.mName == "start")
+            key.mType = TextKey_Start;
+        else if(key.mName == "stop")
+            key.mType = TextKey_Stop;
+        else if(key.mName == "loop start")
+            key.mType = TextKey_LoopStart;
+        else if(key.mName == "loop stop")
+            key.mType = TextKey_LoopStop;
+        else if(key.mName == "hit")
+            key.mType = TextKey_Hit;
+        else
+            key.mType = TextKey_Other;
+
+        source.mGroupKeys[iter->second.substr(0, sep)].push_back(key);
     }
-    return iter;
+}
+
+const std::vector<Animation::GroupKey> *Animation::findGroupKeys(const AnimSource &source, const std::string &groupname)
+{
+    GroupKeyMap::const_iterator iter = source.mGroupKeys.find(groupname);
+    if(iter == source.mGroupKeys.end())
+        return NULL;
+    return &iter->second;
 }
 
 
@@ -445,8 +495,7 @@ bool Animation::hasAnimation(const std::string &anim)
     AnimSourceList::const_iterator iter(mAnimSources.begin());
     for(;iter != mAnimSources.end();++iter)
     {
-        const NifOgre::TextKeyMap &keys = (*iter)->mTextKeys;
-        if(findGroupStart(keys, anim) != keys.end())
+        if(findGroupKeys(**iter, anim))
             return true;
     }
 
@@ -466,12 +515,12 @@ void Animation::updatePtr(const MWWorld::Ptr &ptr)
 }
 
 
-float Animation::calcAnimVelocity(const NifOgre::TextKeyMap &keys, NifOgre::NodeTargetValue<Ogre::Real> *nonaccumctrl, const Ogre::Vector3 &accum, const std::string &groupname)
+float Animation::calcAnimVelocity(const AnimSource &source, NifOgre::NodeTargetValue<Ogre::Real> *nonaccumctrl, const Ogre::Vector3 &accum, const std::string &groupname)
 {
-    const std::string start = groupname+": start";
-    const std::string loopstart = groupname+": loop start";
-    const std::string loopstop = groupname+": loop stop";
-    const std::string stop = groupname+": stop";
+    const std::vector<GroupKey> *keys = findGroupKeys(source, groupname);
+    if(!keys)
+        return 0.0f;
+
     float starttime = std::numeric_limits<float>::max();
     float stoptime = 0.0f;
 
@@ -481,24 +530,24 @@ float Animation::calcAnimVelocity(const NifOgre::TextKeyMap &keys, NifOgre::Node
     // but the animation velocity calculation uses the second one.
     // As result the animation velocity calculation is not correct, and this incorrect velocity must be replicated,
     // because otherwise the Creature's Speed (dagoth uthol) would not be sufficient to move fast enough.
-    NifOgre::TextKeyMap::const_reverse_iterator keyiter(keys.rbegin());
-    while(keyiter != keys.rend())
+    std::vector<GroupKey>::const_reverse_iterator keyiter(keys->rbegin());
+    while(keyiter != keys->rend())
     {
-        if(keyiter->second == start || keyiter->second == loopstart)
+        if(keyiter->mType == TextKey_Start || keyiter->mType == TextKey_LoopStart)
         {
-            starttime = keyiter->first;
+            starttime = keyiter->mKey->first;
             break;
         }
         ++keyiter;
     }
-    keyiter = keys.rbegin();
-    while(keyiter != keys.rend())
+    keyiter = keys->rbegin();
+    while(keyiter != keys->rend())
     {
-        if (keyiter->second == stop)
-            stoptime = keyiter->first;
-        else if (keyiter->second == loopstop)
+        if (keyiter->mType == TextKey_Stop)
+            stoptime = keyiter->mKey->first;
+        else if (keyiter->mType == TextKey_LoopStop)
         {
-            stoptime = keyiter->first;
+            stoptime = keyiter->mKey->first;
             break;
         }
         ++keyiter;
@@ -521,15 +570,13 @@ float Animation::getVelocity(const std::string &groupname) const
     AnimSourceList::const_reverse_iterator animsrc(mAnimSources.rbegin());
     for(;animsrc != mAnimSources.rend();++animsrc)
     {
-        const NifOgre::TextKeyMap &keys = (*animsrc)->mTextKeys;
-        if(findGroupStart(keys, groupname) != keys.end())
+        if(findGroupKeys(**animsrc, groupname))
             break;
     }
     if(animsrc == mAnimSources.rend())
         return 0.0f;
 
     float velocity = 0.0f;
-    const NifOgre::TextKeyMap &keys = (*animsrc)->mTextKeys;
     const std::vector<Ogre::Controller<Ogre::Real> >&ctrls = (*animsrc)->mControllers[0];
     for(size_t i = 0;i < ctrls.size();i++)
     {
@@ -537,7 +584,7 @@ float Animation::getVelocity(const std::string &groupname) const
         dstval = static_cast<NifOgre::NodeTargetValue<Ogre::Real>*>(ctrls[i].getDestination().getPointer());
         if(dstval->getNode() == mNonAccumRoot)
         {
-            velocity = calcAnimVelocity(keys, dstval, mAccumulate, groupname);
+            velocity = calcAnimVelocity(**animsrc, dstval, mAccumulate, groupname);
             break;
         }
     }
@@ -551,7 +598,6 @@ float Animation::getVelocity(const std::string &groupname) const
 
         while(!(velocity > 1.0f) && ++animiter != mAnimSources.rend())
         {
-            const NifOgre::TextKeyMap &keys = (*animiter)->mTextKeys;
             const std::vector<Ogre::Controller<Ogre::Real> >&ctrls = (*animiter)->mControllers[0];
             for(size_t i = 0;i < ctrls.size();i++)
             {
@@ -559,7 +605,7 @@ float Animation::getVelocity(const std::string &groupname) const
                 dstval = static_cast<NifOgre::NodeTargetValue<Ogre::Real>*>(ctrls[i].getDestination().getPointer());
                 if(dstval->getNode() == mNonAccumRoot)
                 {
-                    velocity = calcAnimVelocity(keys, dstval, mAccumulate, groupname);
+                    velocity = calcAnimVelocity(**animiter, dstval, mAccumulate, groupname);
                     break;
                 }
             }
@@ -611,62 +657,58 @@ void Animation::updatePosition(float oldtime, float newtime, Ogre::Vector3 &posi
     Ogre::Vector3 off = mNonAccumCtrl->getTranslation(newtime)*mAccumulate;
     position += off - mNonAccumCtrl->getTranslation(oldtime)*mAccumulate;
 
-    /* Translate the accumulation root back to compensate for the move. */
-    mAccumRoot->setPosition(-off);
+    /* Translate the accumulation root back to compensate for the move. This is applied together
+     * with the next skeleton pose (see runAnimation), otherwise actors with a throttled skeleton
+     * would slide. */
+    mAccumRootPosition = -off;
+    mAccumRootPending = true;
 }
 
-bool Animation::reset(AnimState &state, const NifOgre::TextKeyMap &keys, const std::string &groupname, const std::string &start, const std::string &stop, float startpoint, bool loopfallback)
+bool Animation::reset(AnimState &state, const AnimSource &source, const std::string &groupname, const std::string &start, const std::string &stop, float startpoint, bool loopfallback)
 {
+    const std::vector<GroupKey> *keys = findGroupKeys(source, groupname);
+    if(!keys)
+        return false;
+
     // Look for text keys in reverse. This normally wouldn't matter, but for some reason undeadwolf_2.nif has two
     // separate walkforward keys, and the last one is supposed to be used.
-    NifOgre::TextKeyMap::const_reverse_iterator groupend(keys.rbegin());
-    for(;groupend != keys.rend();++groupend)
-    {
-        if(groupend->second.compare(0, groupname.size(), groupname) == 0 &&
-           groupend->second.compare(groupname.size(), 2, ": ") == 0)
-            break;
-    }
-
-    std::string starttag = groupname+": "+start;
-    NifOgre::TextKeyMap::const_reverse_iterator startkey(groupend);
-    while(startkey != keys.rend() && startkey->second != starttag)
+    std::vector<GroupKey>::const_reverse_iterator startkey(keys->rbegin());
+    while(startkey != keys->rend() && startkey->mName != start)
         ++startkey;
-    if(startkey == keys.rend() && start == "loop start")
+    if(startkey == keys->rend() && start == "loop start")
     {
-        starttag = groupname+": start";
-        startkey = groupend;
-        while(startkey != keys.rend() && startkey->second != starttag)
+        startkey = keys->rbegin();
+        while(startkey != keys->rend() && startkey->mType != TextKey_Start)
             ++startkey;
     }
-    if(startkey == keys.rend())
+    if(startkey == keys->rend())
         return false;
 
-    const std::string stoptag = groupname+": "+stop;
-    NifOgre::TextKeyMap::const_reverse_iterator stopkey(groupend);
-    while(stopkey != keys.rend()
+    std::vector<GroupKey>::const_reverse_iterator stopkey(keys->rbegin());
+    while(stopkey != keys->rend()
           // We have to ignore extra garbage at the end.
           // The Scrib's idle3 animation has "Idle3: Stop." instead of "Idle3: Stop".
           // Why, just why? :(
-          && (stopkey->second.size() < stoptag.size() || stopkey->second.substr(0,stoptag.size()) != stoptag))
+          && stopkey->mName.compare(0, stop.size(), stop) != 0)
         ++stopkey;
-    if(stopkey == keys.rend())
+    if(stopkey == keys->rend())
         return false;
 
-    if(startkey->first > stopkey->first)
+    if(startkey->mKey->first > stopkey->mKey->first)
         return false;
 
-    state.mStartTime = startkey->first;
+    state.mStartTime = startkey->mKey->first;
     if (loopfallback)
     {
-        state.mLoopStartTime = startkey->first;
-        state.mLoopStopTime = stopkey->first;
+        state.mLoopStartTime = startkey->mKey->first;
+        state.mLoopStopTime = stopkey->mKey->first;
     }
     else
     {
-        state.mLoopStartTime = startkey->first;
+        state.mLoopStartTime = startkey->mKey->first;
         state.mLoopStopTime = std::numeric_limits<float>::max();
     }
-    state.mStopTime = stopkey->first;
+    state.mStopTime = stopkey->mKey->first;
 
     state.mTime = state.mStartTime + ((state.mStopTime - state.mStartTime) * startpoint);
 
@@ -674,19 +716,16 @@ bool Animation::reset(AnimState &state, const NifOgre::TextKeyMap &keys, const s
     // (see handleTextKey). But if startpoint is already past these keys, we need to assign them now.
     if(state.mTime > state.mStartTime)
     {
-        const std::string loopstarttag = groupname+": loop start";
-        const std::string loopstoptag = groupname+": loop stop";
-
-        NifOgre::TextKeyMap::const_reverse_iterator key(groupend);
-        for (; key != startkey && key != keys.rend(); ++key)
+        std::vector<GroupKey>::const_reverse_iterator key(keys->rbegin());
+        for (; key != startkey && key != keys->rend(); ++key)
         {
-            if (key->first > state.mTime)
+            if (key->mKey->first > state.mTime)
                 continue;
 
-            if (key->second == loopstarttag)
-                state.mLoopStartTime = key->first;
-            else if (key->second == loopstoptag)
-                state.mLoopStopTime = key->first;
+            if (key->mType == TextKey_LoopStart)
+                state.mLoopStartTime = key->mKey->first;
+            else if (key->mType == TextKey_LoopStop)
+                state.mLoopStopTime = key->mKey->first;
         }
     }
 
@@ -701,8 +740,7 @@ void split(const std::string &s, char delim, std::vector<std::string> &elems) {
     }
 }
 
-void Animation::handleTextKey(AnimState &state, const std::string &groupname, const NifOgre::TextKeyMap::const_iterator &key,
-                              const NifOgre::TextKeyMap& textkeys)
+void Animation::handleTextKey(AnimState &state, const std::string &groupname, const NifOgre::TextKeyMap::const_iterator &key)
 {
     //float time = key->first;
     const std::string &evt = key->second;
@@ -779,20 +817,23 @@ void Animation::handleTextKey(AnimState &state, const std::string &groupname, co
     else if (!groupname.empty() && groupname.compare(0, groupname.size()-1, "attack") == 0
              && evt.compare(off, len, "start") == 0)
     {
-        NifOgre::TextKeyMap::const_iterator hitKey = key;
-
         // Not all animations have a hit key defined. If there is none, the hit happens with the start key.
         bool hasHitKey = false;
-        while (hitKey != textkeys.end())
+        if (const std::vector<GroupKey> *keys = findGroupKeys(*state.mSource, groupname))
         {
-            if (hitKey->second == groupname + ": hit")
+            std::vector<GroupKey>::const_iterator hitKey = keys->begin();
+            while (hitKey != keys->end() && hitKey->mKey != key)
+                ++hitKey;
+            for (; hitKey != keys->end(); ++hitKey)
             {
-                hasHitKey = true;
-                break;
+                if (hitKey->mType == TextKey_Hit)
+                {
+                    hasHitKey = true;
+                    break;
+                }
+                if (hitKey->mType == TextKey_Stop)
+                    break;
             }
-            if (hitKey->second == groupname + ": stop")
-                break;
-            ++hitKey;
         }
         if (!hasHitKey)
         {
@@ -896,7 +937,7 @@ void Animation::play(const std::string &groupname, int priority, int groups, boo
     for(;iter != mAnimSources.rend();++iter)
     {
         const NifOgre::TextKeyMap &textkeys = (*iter)->mTextKeys;
-        if(reset(state, textkeys, groupname, start, stop, startpoint, loopfallback))
+        if(reset(state, **iter, groupname, start, stop, startpoint, loopfallback))
         {
             state.mSource = *iter;
             state.mSpeedMult = speedmult;
@@ -912,7 +953,7 @@ void Animation::play(const std::string &groupname, int priority, int groups, boo
             {
                 while(textkey != textkeys.end() && textkey->first <= state.mTime)
                 {
-                    handleTextKey(state, groupname, textkey, textkeys);
+                    handleTextKey(state, groupname, textkey);
                     ++textkey;
                 }
             }
@@ -928,7 +969,7 @@ void Animation::play(const std::string &groupname, int priority, int groups, boo
                 NifOgre::TextKeyMap::const_iterator textkey(textkeys.lower_bound(state.mTime));
                 while(textkey != textkeys.end() && textkey->first <= state.mTime)
                 {
-                    handleTextKey(state, groupname, textkey, textkeys);
+                    handleTextKey(state, groupname, textkey);
                     ++textkey;
                 }
             }
@@ -966,6 +1007,11 @@ bool Animation::isPlaying(const std::string &groupname) const
 
 void Animation::resetActiveGroups()
 {
+    // The active animations change, so pose the skeleton on the next update regardless of the
+    // level of detail. The accumulation root is set directly below.
+    mForceSkeletonUpdate = true;
+    mAccumRootPending = false;
+
     for(size_t grp = 0;grp < sNumGroups;grp++)
     {
         AnimStateMap::const_iterator active = mStates.end();
@@ -1040,25 +1086,33 @@ float Animation::getStartTime(const std::string &groupname) const
 {
     for(AnimSourceList::const_iterator iter(mAnimSources.begin()); iter != mAnimSources.end(); ++iter)
     {
-        const NifOgre::TextKeyMap &keys = (*iter)->mTextKeys;
-
-        NifOgre::TextKeyMap::const_iterator found = findGroupStart(keys, groupname);
-        if(found != keys.end())
-            return found->first;
+        const std::vector<GroupKey> *keys = findGroupKeys(**iter, groupname);
+        if(keys)
+            return keys->front().mKey->first;
     }
     return -1.f;
 }
 
 float Animation::getTextKeyTime(const std::string &textKey) const
+{
+    std::string::size_type sep = textKey.find(": ");
+    if(sep == std::string::npos)
+        return -1.f;
+    return getTextKeyTime(textKey.substr(0, sep), textKey.substr(sep+2));
+}
+
+float Animation::getTextKeyTime(const std::string &groupname, const std::string &key) const
 {
     for(AnimSourceList::const_iterator iter(mAnimSources.begin()); iter != mAnimSources.end(); ++iter)
     {
-        const NifOgre::TextKeyMap &keys = (*iter)->mTextKeys;
+        const std::vector<GroupKey> *keys = findGroupKeys(**iter, groupname);
+        if(!keys)
+            continue;
 
-        for(NifOgre::TextKeyMap::const_iterator iterKey(keys.begin()); iterKey != keys.end(); ++iterKey)
+        for(std::vector<GroupKey>::const_iterator iterKey(keys->begin()); iterKey != keys->end(); ++iterKey)
         {
-            if(iterKey->second.compare(0, textKey.size(), textKey) == 0)
-                return iterKey->first;
+            if(iterKey->mName.compare(0, key.size(), key) == 0)
+                return iterKey->mKey->first;
         }
     }
 
@@ -1120,7 +1174,7 @@ Ogre::Vector3 Animation::runAnimation(float duration)
 
             while(textkey != textkeys.end() && textkey->first <= state.mTime)
             {
-                handleTextKey(state, stateiter->first, textkey, textkeys);
+                handleTextKey(state, stateiter->first, textkey);
                 ++textkey;
             }
 
@@ -1134,7 +1188,7 @@ Ogre::Vector3 Animation::runAnimation(float duration)
                 textkey = textkeys.lower_bound(state.mTime);
                 while(textkey != textkeys.end() && textkey->first <= state.mTime)
                 {
-                    handleTextKey(state, stateiter->first, textkey, textkeys);
+                    handleTextKey(state, stateiter->first, textkey);
                     ++textkey;
                 }
 
@@ -1156,6 +1210,25 @@ Ogre::Vector3 Animation::runAnimation(float duration)
             ++stateiter;
     }
 
+    // Pose the skeleton only as often as the level of detail asks for. The controllers sample
+    // the current animation time, so a throttled actor still lands on the correct pose.
+    mSkeletonUpdateTimer += duration;
+    mSkeletonUpdated = (mForceSkeletonUpdate || mSkeletonUpdateTimer >= mSkeletonUpdateInterval);
+    if(!mSkeletonUpdated)
+    {
+        ++sFrameStats.mSkeletonsSkipped;
+        updateEffects(duration);
+        return movement;
+    }
+    mSkeletonUpdateTimer = 0.0f;
+    mForceSkeletonUpdate = false;
+
+    if(mAccumRootPending && mAccumRoot)
+    {
+        mAccumRoot->setPosition(mAccumRootPosition);
+        mAccumRootPending = false;
+    }
+
     for(size_t i = 0;i < mObjectRoot->mControllers.size();i++)
     {
         if(mObjectRoot->mControllers[i].getSource())
@@ -1179,6 +1252,10 @@ Ogre::Vector3 Animation::runAnimation(float duration)
         // HACK: Dirty the animation state set so that Ogre will apply the
         // transformations to entities this skeleton instance is shared with.
         mSkelBase->getAllAnimationStates()->_notifyDirty();
+
+        ++sFrameStats.mSkeletonsUpdated;
+        if(mSkelBase->hasSkeleton())
+            sFrameStats.mBonesUpdated += mSkelBase->getSkeleton()->getNumBones();
     }
 
     updateEffects(duration);
@@ -1433,6 +1510,50 @@ void Animation::preRender(Ogre::Camera *camera)
         objects->rotateBillboardNodes(camera);
     }
     mObjectRoot->rotateBillboardNodes(camera);
+
+    updateLod(camera);
+}
+
+void Animation::updateLod(Ogre::Camera *camera)
+{
+    mSkeletonUpdateInterval = 0.0f;
+    if(!mLodEnabled || !mSkelBase || mPtr == MWBase::Environment::get().getWorld()->getPlayerPtr())
+        return;
+
+    Ogre::AxisAlignedBox bounds = getWorldBounds();
+    if(!bounds.isFinite())
+        return;
+
+    if(!camera->isVisible(bounds))
+    {
+        // Still pose offscreen actors now and then, gameplay reads some of their bones
+        mSkeletonUpdateInterval = mLodOffscreenInterval;
+        return;
+    }
+
+    float distance = camera->getRealPosition().distance(bounds.getCenter());
+    if(distance <= mLodFullRateDistance)
+        return;
+
+    // Approximate fraction of the screen height covered by the object
+    float size = bounds.getHalfSize().length() / (distance * Ogre::Math::Tan(camera->getFOVy() * 0.5f));
+    if(size >= mLodFullRateSize)
+        return;
+
+    mSkeletonUpdateInterval = mLodMaxInterval * (1.0f - size / mLodFullRateSize);
+}
+
+void Animation::getLodStats(unsigned int &skeletonsUpdated, unsigned int &skeletonsSkipped, unsigned int &bonesUpdated)
+{
+    skeletonsUpdated = sLastFrameStats.mSkeletonsUpdated;
+    skeletonsSkipped = sLastFrameStats.mSkeletonsSkipped;
+    bonesUpdated = sLastFrameStats.mBonesUpdated;
+}
+
+void Animation::finishLodFrame()
+{
+    sLastFrameStats = sFrameStats;
+    sFrameStats = LodStats();
 }
 
 // TODO: Should not be here
@@ -1494,13 +1615,14 @@ ObjectAnimation::ObjectAnimation(const MWWorld::Ptr& ptr, const std::string &mod
         Ogre::Vector3 extents = getWorldBounds().getSize();
         float size = std::max(std::max(extents.x, extents.y), extents.z);
 
-        bool small = (size < Settings::Manager::getInt("small object size", "Viewing distance")) &&
-                     Settings::Manager::getBool("limit small object distance", "Viewing distance");
+        const Settings::Snapshot& settings = Settings::Manager::getSnapshot();
+        bool small = (size < settings.getInt(Settings::Key_SmallObjectSize)) &&
+                     settings.getBool(Settings::Key_LimitSmallObjectDistance);
         // do not fade out doors. that will cause holes and look stupid
         if(ptr.getTypeName().find("Door") != std::string::npos)
             small = false;
 
-        float dist = small ? Settings::Manager::getInt("small object distance", "Viewing distance") : 0.0f;
+        float dist = small ? settings.getInt(Settings::Key_SmallObjectDistance) : 0.0f;
         Ogre::Vector3 col = getEnchantmentColor(ptr);
         setRenderProperties(mObjectRoot, (mPtr.getTypeName() == typeid(ESM::Static).name()) ?
                                          (small ? RV_StaticsSmall : RV_Statics) : RV_Misc,
@@ -81,8 +81,28 @@ protected:
     };
 
 
+    enum TextKeyType {
+        TextKey_Other,
+        TextKey_Start,
+        TextKey_Stop,
+        TextKey_LoopStart,
+        TextKey_LoopStop,
+        TextKey_Hit
+    };
+
+    /* A "groupname: name" text key, split once when the animation source is loaded so group
+     * lookups don't have to build and compare the full key strings. */
+    struct GroupKey {
+        NifOgre::TextKeyMap::const_iterator mKey;
+        std::string mName;
+        TextKeyType mType;
+    };
+    /* The keys of each group, in text key map order. */
+    typedef std::map<std::string, std::vector<GroupKey> > GroupKeyMap;
+
     struct AnimSource : public Ogre::AnimationAlloc {
         NifOgre::TextKeyMap mTextKeys;
+        GroupKeyMap mGroupKeys;
         std::vector<Ogre::Controller<Ogre::Real> > mControllers[sNumGroups];
     };
     typedef std::vector< Ogre::SharedPtr<AnimSource> > AnimSourceList;
@@ -144,6 +164,39 @@ protected:
 
     ObjectAttachMap mAttachedObjects;
 
+    /* Animation level of detail. Actors that are far away, small on screen or offscreen only have
+     * their skeleton posed every mSkeletonUpdateInterval seconds. Animation time and text keys are
+     * always advanced, the accumulation root is moved together with the skeleton pose. */
+    bool mLodEnabled;
+    float mLodFullRateDistance;
+    float mLodFullRateSize;
+    float mLodMaxInterval;
+    float mLodOffscreenInterval;
+
+    float mSkeletonUpdateInterval; // 0 = every frame
+    float mSkeletonUpdateTimer;
+    bool mSkeletonUpdated; // Was the skeleton posed by the last runAnimation call?
+    bool mForceSkeletonUpdate; // Pose the skeleton on the next runAnimation call
+
+    Ogre::Vector3 mAccumRootPosition; // Accumulation root position for the next skeleton pose
+    bool mAccumRootPending;
+
+    struct LodStats
+    {
+        unsigned int mSkeletonsUpdated;
+        unsigned int mSkeletonsSkipped;
+        unsigned int mBonesUpdated;
+
+        LodStats() : mSkeletonsUpdated(0), mSkeletonsSkipped(0), mBonesUpdated(0)
+        { }
+    };
+    static LodStats sFrameStats;
+    static LodStats sLastFrameStats;
+
+    /// Picks the skeleton update interval for the next frames based on the distance to
+    /// \a camera and the size the object covers on screen.
+    void updateLod(Ogre::Camera *camera);
+
 
     /* Sets the appropriate animations on the bone groups based on priority.
      */
@@ -151,7 +204,7 @@ protected:
 
     static size_t detectAnimGroup(const Ogre::Node *node);
 
-    static float calcAnimVelocity(const NifOgre::TextKeyMap &keys,
+    static float calcAnimVelocity(const AnimSource &source,
                                   NifOgre::NodeTargetValue<Ogre::Real> *nonaccumctrl,
                                   const Ogre::Vector3 &accum,
                                   const std::string &groupname);
@@ -164,19 +217,22 @@ protected:
      * returns the wanted movement vector from the previous time. */
     void updatePosition(float oldtime, float newtime, Ogre::Vector3 &position);
 
-    static NifOgre::TextKeyMap::const_iterator findGroupStart(const NifOgre::TextKeyMap &keys, const std::string &groupname);
+    /* Splits the text keys of \a source into its group key index. */
+    static void indexTextKeys(AnimSource &source);
+
+    /* Returns the keys of the given group in \a source, or NULL if it has no such group. */
+    static const std::vector<GroupKey> *findGroupKeys(const AnimSource &source, const std::string &groupname);
 
     /* Resets the animation to the time of the specified start marker, without
      * moving anything, and set the end time to the specified stop marker. If
      * the marker is not found, or if the markers are the same, it returns
      * false.
      */
-    bool reset(AnimState &state, const NifOgre::TextKeyMap &keys,
+    bool reset(AnimState &state, const AnimSource &source,
                const std::string &groupname, const std::string &start, const std::string &stop,
                float startpoint, bool loopfallback);
 
-    void handleTextKey(AnimState &state, const std::string &groupname, const NifOgre::TextKeyMap::const_iterator &key,
-                       const NifOgre::TextKeyMap& map);
+    void handleTextKey(AnimState &state, const std::string &groupname, const NifOgre::TextKeyMap::const_iterator &key);
 
     /* Sets the root model of the object. If 'baseonly' is true, then any meshes or particle
      * systems in the model are ignored (useful for NPCs, where only the skeleton is needed for
@@ -227,9 +283,18 @@ public:
     void removeEffect (int effectId);
     void getLoopingEffects (std::vector<int>& out);
 
-    /// Prepare this animation for being rendered with \a camera (rotates billboard nodes)
+    /// Prepare this animation for being rendered with \a camera (rotates billboard nodes,
+    /// updates the animation level of detail)
     virtual void preRender (Ogre::Camera* camera);
 
+    /// Returns the number of skeletons posed, skeletons skipped and bones updated in the
+    /// last completed frame.
+    static void getLodStats(unsigned int &skeletonsUpdated, unsigned int &skeletonsSkipped,
+                            unsigned int &bonesUpdated);
+
+    /// Closes the statistics of the current frame. Called once per frame by the RenderingManager.
+    static void finishLodFrame();
+
     virtual void setAlpha(float alpha) {}
     virtual void setVampire(bool vampire) {}
 
@@ -295,6 +360,10 @@ public:
     /// Get the absolute position in the animation track of the text key
     float getTextKeyTime(const std::string &textKey) const;
 
+    /// Get the absolute position in the animation track of the first key of the given group
+    /// whose name starts with \a key.
+    float getTextKeyTime(const std::string &groupname, const std::string &key) const;
+
     /// Get the current absolute position in the animation track for the animation that is currently playing from the given group.
     float getCurrentTime(const std::string& groupname) const;
 
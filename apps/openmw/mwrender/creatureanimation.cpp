@@ -185,6 +185,9 @@ Ogre::Vector3 CreatureWeaponAnimation::runAnimation(float duration)
 {
     Ogre::Vector3 ret = Animation::runAnimation(duration);
 
+    if (!mSkeletonUpdated)
+        return ret;
+
     if (mSkelBase)
         pitchSkeleton(mPtr.getRefData().getPosition().rot[0], mSkelBase->getSkeleton());
 
@@ -14,6 +14,7 @@
 #include <components/settings/settings.hpp>
 
 #include <components/esm/globalmap.hpp>
+#include <components/esmterrain/storage.hpp>
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
@@ -76,15 +77,18 @@ namespace MWRender
             {
                 ESM::Land* land = esmStore.get<ESM::Land>().search (x,y);
 
+                const ESM::Land::LandData *landData = 0;
                 if (land)
                 {
+                    // the terrain may be loading land data in the background
+                    boost::mutex::scoped_lock lock (ESMTerrain::Storage::getLandLoadMutex());
+
                     int mask = ESM::Land::DATA_WNAM;
                     if (!land->isDataLoaded(mask))
                         land->loadData(mask);
-                }
 
-                const ESM::Land::LandData *landData =
-                    land ? land->getLandData (ESM::Land::DATA_WNAM) : 0;
+                    landData = land->getLandData (ESM::Land::DATA_WNAM);
+                }
 
                 for (int cellY=0; cellY<mCellSize; ++cellY)
                 {
@@ -138,7 +142,10 @@ namespace MWRender
                 }
                 loadingListener->increaseProgress();
                 if (land)
+                {
+                    boost::mutex::scoped_lock lock (ESMTerrain::Storage::getLandLoadMutex());
                     land->unloadData();
+                }
             }
         }
 
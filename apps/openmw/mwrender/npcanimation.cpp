@@ -637,6 +637,12 @@ Ogre::Vector3 NpcAnimation::runAnimation(float timepassed)
 
     mHeadAnimationTime->update(timepassed);
 
+    if (!mSkeletonUpdated)
+    {
+        mFirstPersonOffset = 0.f;
+        return ret;
+    }
+
     if (mSkelBase)
     {
         Ogre::SkeletonInstance *baseinst = mSkelBase->getSkeleton();
@@ -86,8 +86,9 @@ void Objects::insertModel(const MWWorld::Ptr &ptr, const std::string &mesh, bool
         extents *= ptr.getRefData().getBaseNode()->getScale();
         float size = std::max(std::max(extents.x, extents.y), extents.z);
 
-        bool small = (size < Settings::Manager::getInt("small object size", "Viewing distance")) &&
-                     Settings::Manager::getBool("limit small object distance", "Viewing distance");
+        const Settings::Snapshot& settings = Settings::Manager::getSnapshot();
+        bool small = (size < settings.getInt(Settings::Key_SmallObjectSize)) &&
+                     settings.getBool(Settings::Key_LimitSmallObjectDistance);
         // do not fade out doors. that will cause holes and look stupid
         if(ptr.getTypeName().find("Door") != std::string::npos)
             small = false;
@@ -97,7 +98,7 @@ void Objects::insertModel(const MWWorld::Ptr &ptr, const std::string &mesh, bool
         mBounds[ptr.getCell()].merge(bounds);
 
         if(batch &&
-           Settings::Manager::getBool("use static geometry", "Objects") &&
+           settings.getBool(Settings::Key_UseStaticGeometry) &&
            anim->canBatch())
         {
             Ogre::StaticGeometry* sg = 0;
@@ -111,7 +112,7 @@ void Objects::insertModel(const MWWorld::Ptr &ptr, const std::string &mesh, bool
                     sg->setOrigin(ptr.getRefData().getBaseNode()->getPosition());
                     mStaticGeometrySmall[ptr.getCell()] = sg;
 
-                    sg->setRenderingDistance(static_cast<Ogre::Real>(Settings::Manager::getInt("small object distance", "Viewing distance")));
+                    sg->setRenderingDistance(static_cast<Ogre::Real>(settings.getInt(Settings::Key_SmallObjectDistance)));
                 }
                 else
                     sg = mStaticGeometrySmall[ptr.getCell()];
@@ -24,6 +24,7 @@
 #include <components/settings/settings.hpp>
 #include <components/terrain/defaultworld.hpp>
 #include <components/terrain/terraingrid.hpp>
+#include <components/terrain/texturecache.hpp>
 
 #include "../mwworld/esmstore.hpp"
 #include "../mwworld/class.hpp"
@@ -59,6 +60,7 @@ RenderingManager::RenderingManager(OEngine::Render::OgreRenderer& _rend, const b
     : mSunEnabled(0)
     , mFallback(fallback)
     , mTerrain(NULL)
+    , mCacheDir(cacheDir)
     , mRendering(_rend)
     , mEffectManager(NULL)
     , mPlayerAnimation(NULL)
@@ -175,6 +177,9 @@ RenderingManager::RenderingManager(OEngine::Render::OgreRenderer& _rend, const b
 
     mWater = new MWRender::Water(mRendering.getCamera(), this, mFallback);
 
+    // all global settings are known now, so the shaders used last time can be prepared in the background
+    mFactory->prewarmShaders();
+
     setMenuTransparency(Settings::Manager::getFloat("menu transparency", "GUI"));
 }
 
@@ -342,6 +347,8 @@ void RenderingManager::update (float duration, bool paused)
         MWBase::StateManager::State_NoGame)
         return;
 
+    Animation::finishLodFrame();
+
     MWBase::World *world = MWBase::Environment::get().getWorld();
 
     MWWorld::Ptr player = world->getPlayerPtr();
@@ -511,7 +518,8 @@ void RenderingManager::configureFog(const MWWorld::CellStore &mCell)
 void RenderingManager::configureFog(const float density, const Ogre::ColourValue& colour)
 {
     mFogColour = colour;
-    float max = Settings::Manager::getFloat("viewing distance", "Viewing distance");
+    const Settings::Snapshot& settings = Settings::Manager::getSnapshot();
+    float max = settings.getFloat(Settings::Key_ViewingDistance);
 
     if (density == 0)
     {
@@ -521,8 +529,8 @@ void RenderingManager::configureFog(const float density, const Ogre::ColourValue
     }
     else
     {
-        mFogStart = max / (density) * Settings::Manager::getFloat("fog start factor", "Viewing distance");
-        mFogEnd = max / (density) * Settings::Manager::getFloat("fog end factor", "Viewing distance");
+        mFogStart = max / (density) * settings.getFloat(Settings::Key_FogStartFactor);
+        mFogEnd = max / (density) * settings.getFloat(Settings::Key_FogEndFactor);
         mRendering.getCamera()->setFarClipDistance (max / density);
     }
 
@@ -878,6 +886,12 @@ void RenderingManager::getTriangleBatchCount(unsigned int &triangles, unsigned i
     triangles = mRendering.getWindow()->getTriangleCount();
 }
 
+void RenderingManager::getAnimationLodStats(unsigned int &skeletonsUpdated, unsigned int &skeletonsSkipped,
+                                            unsigned int &bonesUpdated)
+{
+    Animation::getLodStats(skeletonsUpdated, skeletonsSkipped, bonesUpdated);
+}
+
 void RenderingManager::setupPlayer(const MWWorld::Ptr &ptr)
 {
     ptr.getRefData().setBaseNode(mRendering.getScene()->getSceneNode("player"));
@@ -1038,8 +1052,15 @@ void RenderingManager::enableTerrain(bool enable)
         if (!mTerrain)
         {
             if (Settings::Manager::getBool("distant land", "Terrain"))
-                mTerrain = new Terrain::DefaultWorld(mRendering.getScene(), new MWRender::TerrainStorage(true), RV_Terrain,
+            {
+                MWRender::TerrainStorage* storage = new MWRender::TerrainStorage(true);
+                if (Settings::Manager::getBool("texture cache", "Terrain"))
+                    storage->setTextureCache(new Terrain::TextureCache(mCacheDir / "terrain",
+                        static_cast<boost::uint64_t>(std::max(0, Settings::Manager::getInt("texture cache size", "Terrain"))) * 1024 * 1024));
+
+                mTerrain = new Terrain::DefaultWorld(mRendering.getScene(), storage, RV_Terrain,
                                                 Settings::Manager::getBool("shader", "Terrain"), Terrain::Align_XY, 1, 64);
+            }
             else
                 mTerrain = new Terrain::TerrainGrid(mRendering.getScene(), new MWRender::TerrainStorage(false), RV_Terrain,
                                                 Settings::Manager::getBool("shader", "Terrain"), Terrain::Align_XY);
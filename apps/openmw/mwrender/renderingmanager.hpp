@@ -161,6 +161,11 @@ public:
 
     void getTriangleBatchCount(unsigned int &triangles, unsigned int &batches);
 
+    /// Skeletons posed, skeletons skipped by the animation level of detail and bones updated
+    /// in the last frame
+    void getAnimationLodStats(unsigned int &skeletonsUpdated, unsigned int &skeletonsSkipped,
+                              unsigned int &bonesUpdated);
+
     void setGlare(bool glare);
     void skyEnable ();
     void skyDisable ();
@@ -235,6 +240,9 @@ private:
 
     Terrain::World* mTerrain;
 
+    // Generated terrain textures are cached in a subdirectory of this
+    boost::filesystem::path mCacheDir;
+
     MWRender::Water *mWater;
 
     GlobalMap* mGlobalMap;
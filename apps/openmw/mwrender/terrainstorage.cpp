@@ -2,6 +2,8 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <components/settings/settings.hpp>
+
 #include "../mwbase/world.hpp"
 #include "../mwbase/environment.hpp"
 #include "../mwworld/esmstore.hpp"
@@ -16,6 +18,8 @@ namespace MWRender
             const MWWorld::ESMStore &esmStore =
                 MWBase::Environment::get().getWorld()->getStore();
 
+            boost::mutex::scoped_lock lock (getLandLoadMutex());
+
             MWWorld::Store<ESM::Land>::iterator it = esmStore.get<ESM::Land>().begin();
             for (; it != esmStore.get<ESM::Land>().end(); ++it)
             {
@@ -71,4 +75,11 @@ namespace MWRender
         return esmStore.get<ESM::LandTexture>().search(index, plugin);
     }
 
+    Terrain::TextureCache* TerrainStorage::getTextureCache()
+    {
+        if (!Settings::Manager::getSnapshot().getBool(Settings::Key_TerrainTextureCache))
+            return NULL;
+        return ESMTerrain::Storage::getTextureCache();
+    }
+
 }
@@ -20,6 +20,10 @@ namespace MWRender
 
         /// Get bounds of the whole terrain in cell units
         virtual void getBounds(float& minX, float& maxX, float& minY, float& maxY);
+
+        /// Returns NULL while the "texture cache" setting is off. Called from the terrain worker
+        /// threads as well.
+        virtual Terrain::TextureCache* getTextureCache();
     };
 
 }
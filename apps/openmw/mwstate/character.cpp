@@ -5,39 +5,229 @@
 #include <sstream>
 #include <algorithm>
 #include <stdexcept>
+#include <iostream>
+#include <cstring>
 
+#include <boost/cstdint.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
 
 #include <components/esm/esmreader.hpp>
 #include <components/esm/defs.hpp>
 
 #include <components/misc/stringops.hpp>
 
+namespace
+{
+    const char *sIndexName = "slots.index";
+
+    const char sIndexMagic[4] = { 'O', 'M', 'W', 'I' };
+
+    /// Increase whenever the index format or the fields of ESM::SavedGame change
+    const int sIndexVersion = 2;
+
+    template<typename T>
+    void writeValue (std::ostream& stream, const T& value)
+    {
+        stream.write (reinterpret_cast<const char *> (&value), sizeof (T));
+    }
+
+    template<typename T>
+    void readValue (std::istream& stream, T& value)
+    {
+        stream.read (reinterpret_cast<char *> (&value), sizeof (T));
+    }
+
+    void writeString (std::ostream& stream, const std::string& value)
+    {
+        writeValue (stream, static_cast<boost::uint32_t> (value.size()));
+        stream.write (value.c_str(), value.size());
+    }
+
+    std::string readString (std::istream& stream)
+    {
+        boost::uint32_t size = 0;
+        readValue (stream, size);
+
+        if (!stream || size>(1<<20))
+            throw std::runtime_error ("invalid string");
+
+        std::string value (size, '\0');
+        if (size)
+            stream.read (&value[0], size);
+
+        return value;
+    }
+
+    /// The screenshot is not stored.
+    void writeProfile (std::ostream& stream, const ESM::SavedGame& profile)
+    {
+        writeValue (stream, static_cast<boost::uint32_t> (profile.mContentFiles.size()));
+        for (std::vector<std::string>::const_iterator iter (profile.mContentFiles.begin());
+            iter!=profile.mContentFiles.end(); ++iter)
+            writeString (stream, *iter);
+
+        writeString (stream, profile.mPlayerName);
+        writeValue (stream, profile.mPlayerLevel);
+        writeString (stream, profile.mPlayerClassId);
+        writeString (stream, profile.mPlayerClassName);
+        writeString (stream, profile.mPlayerCell);
+        writeValue (stream, profile.mInGameTime.mGameHour);
+        writeValue (stream, profile.mInGameTime.mDay);
+        writeValue (stream, profile.mInGameTime.mMonth);
+        writeValue (stream, profile.mInGameTime.mYear);
+        writeValue (stream, profile.mTimePlayed);
+        writeString (stream, profile.mDescription);
+    }
+
+    void readProfile (std::istream& stream, ESM::SavedGame& profile)
+    {
+        boost::uint32_t contentFiles = 0;
+        readValue (stream, contentFiles);
+
+        if (!stream || contentFiles>(1<<16))
+            throw std::runtime_error ("invalid content file list");
+
+        for (boost::uint32_t i=0; i<contentFiles; ++i)
+            profile.mContentFiles.push_back (readString (stream));
+
+        profile.mPlayerName = readString (stream);
+        readValue (stream, profile.mPlayerLevel);
+        profile.mPlayerClassId = readString (stream);
+        profile.mPlayerClassName = readString (stream);
+        profile.mPlayerCell = readString (stream);
+        readValue (stream, profile.mInGameTime.mGameHour);
+        readValue (stream, profile.mInGameTime.mDay);
+        readValue (stream, profile.mInGameTime.mMonth);
+        readValue (stream, profile.mInGameTime.mYear);
+        readValue (stream, profile.mTimePlayed);
+        profile.mDescription = readString (stream);
+    }
+
+    /// Key of a saved game file in the index. Changes whenever the file is modified, so that
+    /// entries can be validated without opening the file.
+    std::string getIndexKey (const boost::filesystem::path& path)
+    {
+        std::ostringstream key;
+        key
+            << path.filename().string() << "|" << boost::filesystem::last_write_time (path)
+            << "|" << boost::filesystem::file_size (path);
+        return key.str();
+    }
+
+    void readIndex (const boost::filesystem::path& path, std::map<std::string, ESM::SavedGame>& index,
+        std::set<std::string>& skipped)
+    {
+        if (!boost::filesystem::exists (path))
+            return;
+
+        try
+        {
+            boost::filesystem::ifstream stream (path, std::ios::binary);
+
+            char magic[4];
+            int version = 0;
+            stream.read (magic, sizeof (magic));
+            readValue (stream, version);
+
+            if (!stream || std::memcmp (magic, sIndexMagic, sizeof (magic))!=0 || version!=sIndexVersion)
+                return; // outdated index, will be replaced
+
+            boost::uint32_t count = 0;
+            readValue (stream, count);
+
+            for (boost::uint32_t i=0; i<count && stream; ++i)
+            {
+                std::string key = readString (stream);
+                readProfile (stream, index[key]);
+            }
+
+            count = 0;
+            readValue (stream, count);
+
+            for (boost::uint32_t i=0; i<count && stream; ++i)
+                skipped.insert (readString (stream));
+
+            if (!stream)
+                throw std::runtime_error ("unexpected end of file");
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to read saved game index " << path.string() << ": " << e.what() << std::endl;
+            index.clear();
+            skipped.clear();
+        }
+    }
+
+    ESM::SavedGame readSavedGame (const boost::filesystem::path& path)
+    {
+        ESM::ESMReader reader;
+        reader.open (path.string());
+
+        if (reader.getRecName()!=ESM::REC_SAVE)
+            throw std::runtime_error ("not a saved game file");
+
+        reader.getRecHeader();
+
+        ESM::SavedGame profile;
+        profile.load (reader);
+        return profile;
+    }
+}
+
 bool MWState::operator< (const Slot& left, const Slot& right)
 {
     return left.mTimeStamp<right.mTimeStamp;
 }
 
 
-void MWState::Character::addSlot (const boost::filesystem::path& path, const std::string& game)
+void MWState::Character::addSlot (const boost::filesystem::path& path, const std::string& game,
+    const std::map<std::string, ESM::SavedGame>& index, const std::set<std::string>& skipped,
+    bool& indexChanged)
 {
+    std::string key = getIndexKey (path);
+
+    if (skipped.find (key)!=skipped.end())
+    {
+        mSkipped.push_back (key);
+        return;
+    }
+
     Slot slot;
     slot.mPath = path;
     slot.mTimeStamp = boost::filesystem::last_write_time (path);
+    slot.mScreenshotInFile = true;
 
-    ESM::ESMReader reader;
-    reader.open (slot.mPath.string());
+    std::map<std::string, ESM::SavedGame>::const_iterator found = index.find (key);
 
-    if (reader.getRecName()!=ESM::REC_SAVE)
-        return; // invalid save file -> ignore
+    if (found!=index.end())
+        slot.mProfile = found->second;
+    else
+    {
+        indexChanged = true;
 
-    reader.getRecHeader();
+        try
+        {
+            slot.mProfile = readSavedGame (path);
+        }
+        catch (...)
+        {
+            mSkipped.push_back (key);
+            throw;
+        }
 
-    slot.mProfile.load (reader);
+        // Screenshots are read again when they are displayed
+        std::vector<char>().swap (slot.mProfile.mScreenshot);
+    }
 
-    if (Misc::StringUtils::lowerCase (slot.mProfile.mContentFiles.at (0))!=
+    if (slot.mProfile.mContentFiles.empty() ||
+        Misc::StringUtils::lowerCase (slot.mProfile.mContentFiles[0])!=
         Misc::StringUtils::lowerCase (game))
-        return; // this file is for a different game -> ignore
+    {
+        // this file is for a different game -> ignore
+        mSkipped.push_back (key);
+        return;
+    }
 
     mSlots.push_back (slot);
 }
@@ -72,10 +262,53 @@ void MWState::Character::addSlot (const ESM::SavedGame& profile)
 
     slot.mProfile = profile;
     slot.mTimeStamp = std::time (0);
+    slot.mScreenshotInFile = false;
 
     mSlots.push_back (slot);
 }
 
+void MWState::Character::writeIndex() const
+{
+    boost::filesystem::path path = mPath / sIndexName;
+
+    try
+    {
+        std::vector<std::pair<std::string, const ESM::SavedGame *> > entries;
+
+        for (std::vector<Slot>::const_iterator iter (mSlots.begin()); iter!=mSlots.end(); ++iter)
+        {
+            // Slots that are still being saved would be associated with the wrong file
+            if (iter->mScreenshotInFile && boost::filesystem::exists (iter->mPath))
+                entries.push_back (std::make_pair (getIndexKey (iter->mPath), &iter->mProfile));
+        }
+
+        boost::filesystem::ofstream stream (path, std::ios::binary);
+
+        stream.write (sIndexMagic, sizeof (sIndexMagic));
+        writeValue (stream, sIndexVersion);
+        writeValue (stream, static_cast<boost::uint32_t> (entries.size()));
+
+        for (std::vector<std::pair<std::string, const ESM::SavedGame *> >::const_iterator iter (entries.begin());
+            iter!=entries.end(); ++iter)
+        {
+            writeString (stream, iter->first);
+            writeProfile (stream, *iter->second);
+        }
+
+        writeValue (stream, static_cast<boost::uint32_t> (mSkipped.size()));
+
+        for (std::vector<std::string>::const_iterator iter (mSkipped.begin()); iter!=mSkipped.end(); ++iter)
+            writeString (stream, *iter);
+
+        if (!stream)
+            throw std::runtime_error ("write operation failed");
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to write saved game index " << path.string() << ": " << e.what() << std::endl;
+    }
+}
+
 MWState::Character::Character (const boost::filesystem::path& saves, const std::string& game)
 : mPath (saves)
 {
@@ -85,19 +318,35 @@ MWState::Character::Character (const boost::filesystem::path& saves, const std::
     }
     else
     {
+        std::map<std::string, ESM::SavedGame> index;
+        std::set<std::string> skipped;
+        readIndex (mPath / sIndexName, index, skipped);
+
+        bool indexChanged = false;
+
         for (boost::filesystem::directory_iterator iter (mPath);
             iter!=boost::filesystem::directory_iterator(); ++iter)
         {
             boost::filesystem::path slotPath = *iter;
 
+            if (slotPath.extension() == ".tmp")
+                continue; // left behind by an interrupted save
+
+            if (slotPath.filename() == sIndexName)
+                continue;
+
             try
             {
-                addSlot (slotPath, game);
+                addSlot (slotPath, game, index, skipped, indexChanged);
             }
             catch (...) {} // ignoring bad saved game files for now
         }
 
         std::sort (mSlots.begin(), mSlots.end());
+
+        // also drop the entries of files that were removed
+        if (indexChanged || index.size()!=mSlots.size() || skipped.size()!=mSkipped.size())
+            writeIndex();
     }
 }
 
@@ -108,6 +357,9 @@ void MWState::Character::cleanup()
         // All slots are gone, no need to keep the empty directory
         if (boost::filesystem::is_directory (mPath))
         {
+            boost::system::error_code error;
+            boost::filesystem::remove (mPath / sIndexName, error);
+
             // Extra safety check to make sure the directory is empty (e.g. slots failed to parse header)
             boost::filesystem::directory_iterator it(mPath);
             if (it == boost::filesystem::directory_iterator())
@@ -136,6 +388,8 @@ void MWState::Character::deleteSlot (const Slot *slot)
     boost::filesystem::remove(slot->mPath);
 
     mSlots.erase (mSlots.begin()+index);
+
+    writeIndex();
 }
 
 const MWState::Slot *MWState::Character::updateSlot (const Slot *slot, const ESM::SavedGame& profile)
@@ -151,6 +405,7 @@ const MWState::Slot *MWState::Character::updateSlot (const Slot *slot, const ESM
     Slot newSlot = *slot;
     newSlot.mProfile = profile;
     newSlot.mTimeStamp = std::time (0);
+    newSlot.mScreenshotInFile = false;
 
     mSlots.erase (mSlots.begin()+index);
 
@@ -159,6 +414,38 @@ const MWState::Slot *MWState::Character::updateSlot (const Slot *slot, const ESM
     return &mSlots.back();
 }
 
+void MWState::Character::setScreenshot (const Slot *slot, const std::vector<char>& screenshot)
+{
+    int index = slot - &mSlots[0];
+
+    if (index<0 || index>=static_cast<int> (mSlots.size()))
+    {
+        // sanity check; not entirely reliable
+        throw std::logic_error ("slot not found");
+    }
+
+    mSlots[index].mProfile.mScreenshot = screenshot;
+    mSlots[index].mScreenshotInFile = true;
+
+    writeIndex();
+}
+
+std::vector<char> MWState::Character::getScreenshot (const Slot *slot) const
+{
+    if (!slot->mProfile.mScreenshot.empty() || !slot->mScreenshotInFile)
+        return slot->mProfile.mScreenshot;
+
+    try
+    {
+        return readSavedGame (slot->mPath).mScreenshot;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to read screenshot from " << slot->mPath.string() << ": " << e.what() << std::endl;
+        return std::vector<char>();
+    }
+}
+
 MWState::Character::SlotIterator MWState::Character::begin() const
 {
     return mSlots.rbegin();
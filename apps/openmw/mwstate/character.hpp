@@ -1,6 +1,9 @@
 #ifndef GAME_STATE_CHARACTER_H
 #define GAME_STATE_CHARACTER_H
 
+#include <map>
+#include <set>
+
 #include <boost/filesystem/path.hpp>
 
 #include <components/esm/savedgame.hpp>
@@ -10,8 +13,9 @@ namespace MWState
     struct Slot
     {
         boost::filesystem::path mPath;
-        ESM::SavedGame mProfile;
+        ESM::SavedGame mProfile; ///< \note The screenshot is only kept in memory for slots saved in this session.
         std::time_t mTimeStamp;
+        bool mScreenshotInFile; ///< Read the screenshot from the saved game file when it is needed.
     };
 
     bool operator< (const Slot& left, const Slot& right);
@@ -26,11 +30,19 @@ namespace MWState
 
             boost::filesystem::path mPath;
             std::vector<Slot> mSlots;
+            std::vector<std::string> mSkipped; ///< index keys of the files that are not saved games of this game
 
-            void addSlot (const boost::filesystem::path& path, const std::string& game);
+            void addSlot (const boost::filesystem::path& path, const std::string& game,
+                const std::map<std::string, ESM::SavedGame>& index, const std::set<std::string>& skipped,
+                bool& indexChanged);
 
             void addSlot (const ESM::SavedGame& profile);
 
+            void writeIndex() const;
+            ///< Write the headers of all slots that are saved completely to the index file, so
+            /// that the saved game files don't need to be read next time. Files that were skipped
+            /// are listed too, so that they are not read again either.
+
         public:
 
             Character (const boost::filesystem::path& saves, const std::string& game);
@@ -53,6 +65,18 @@ namespace MWState
             ///
             /// \attention The \a slot pointer will be invalidated by this call.
 
+            void setScreenshot (const Slot *slot, const std::vector<char>& screenshot);
+            ///< Set the encoded screenshot of a slot once the save has been written.
+            ///
+            /// \note Slot must belong to this character. Unlike updateSlot, this does not reorder
+            /// the slots.
+
+            std::vector<char> getScreenshot (const Slot *slot) const;
+            ///< Return the encoded screenshot of a slot, reading it from the saved game file if
+            /// necessary. Empty if the screenshot is not available (yet).
+            ///
+            /// \note Slot must belong to this character.
+
             SlotIterator begin() const;
             ///<  Any call to createSlot and updateSlot can invalidate the returned iterator.
 
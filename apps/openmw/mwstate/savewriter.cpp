@@ -0,0 +1,135 @@
+#include "savewriter.hpp"
+
+#include <stdexcept>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <components/esm/esmwriter.hpp>
+#include <components/esm/defs.hpp>
+
+MWState::SaveWriter::SaveWriter()
+: mRunning (false), mFinished (false), mRecordCount (0)
+{}
+
+MWState::SaveWriter::~SaveWriter()
+{
+    wait();
+}
+
+void MWState::SaveWriter::start (const boost::filesystem::path& path, const ESM::SavedGame& profile,
+    const Ogre::Image& screenshot, std::string& records, int recordCount)
+{
+    wait();
+
+    mResult.mPath = path;
+    mResult.mProfile = profile;
+    mResult.mError.clear();
+    mScreenshot = screenshot;
+    mRecords.clear();
+    mRecords.swap (records);
+    mRecordCount = recordCount;
+
+    {
+        boost::mutex::scoped_lock lock (mMutex);
+        mRunning = true;
+        mFinished = false;
+    }
+
+    mThread = boost::thread (&SaveWriter::run, this);
+}
+
+bool MWState::SaveWriter::isPending() const
+{
+    boost::mutex::scoped_lock lock (mMutex);
+    return mRunning || mFinished;
+}
+
+void MWState::SaveWriter::wait()
+{
+    if (mThread.joinable())
+        mThread.join();
+}
+
+bool MWState::SaveWriter::getResult (Result& result)
+{
+    {
+        boost::mutex::scoped_lock lock (mMutex);
+        if (mRunning || !mFinished)
+            return false;
+
+        mFinished = false;
+    }
+
+    wait();
+
+    result = mResult;
+    return true;
+}
+
+std::string MWState::SaveWriter::getTempPath (const boost::filesystem::path& path)
+{
+    return path.string() + ".tmp";
+}
+
+void MWState::SaveWriter::run()
+{
+    const boost::filesystem::path tempPath = getTempPath (mResult.mPath);
+
+    try
+    {
+        ESM::SavedGame& profile = mResult.mProfile;
+
+        Ogre::DataStreamPtr encoded = mScreenshot.encode ("jpg");
+        profile.mScreenshot.resize (encoded->size());
+        encoded->read (&profile.mScreenshot[0], encoded->size());
+
+        boost::filesystem::ofstream stream (tempPath, std::ios::binary);
+
+        ESM::ESMWriter writer;
+
+        for (std::vector<std::string>::const_iterator iter (profile.mContentFiles.begin());
+            iter!=profile.mContentFiles.end(); ++iter)
+            writer.addMaster (*iter, 0); // not using the size information anyway -> use value of 0
+
+        writer.setFormat (ESM::SavedGame::sCurrentFormat);
+
+        // all unused
+        writer.setVersion(0);
+        writer.setType(0);
+        writer.setAuthor("");
+        writer.setDescription("");
+
+        writer.setRecordCount (mRecordCount);
+
+        writer.save (stream);
+
+        writer.startRecord (ESM::REC_SAVE);
+        profile.save (writer);
+        writer.endRecord (ESM::REC_SAVE);
+
+        writer.close();
+
+        stream.write (mRecords.data(), mRecords.size());
+        stream.close();
+
+        if (stream.fail())
+            throw std::runtime_error("Write operation failed");
+
+        boost::filesystem::rename (tempPath, mResult.mPath);
+    }
+    catch (const std::exception& e)
+    {
+        mResult.mError = e.what();
+
+        boost::system::error_code ec;
+        boost::filesystem::remove (tempPath, ec);
+    }
+
+    std::string().swap (mRecords);
+    mScreenshot.freeMemory();
+
+    boost::mutex::scoped_lock lock (mMutex);
+    mRunning = false;
+    mFinished = true;
+}
@@ -0,0 +1,81 @@
+#ifndef GAME_STATE_SAVEWRITER_H
+#define GAME_STATE_SAVEWRITER_H
+
+#include <string>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/thread.hpp>
+
+#include <OgreImage.h>
+
+#include <components/esm/savedgame.hpp>
+
+namespace MWState
+{
+    /// \brief Finishes writing a saved game in a background thread
+    ///
+    /// The game state is serialised into memory on the main thread. Encoding the screenshot and
+    /// writing the file are left to the background thread. The file is written under a temporary
+    /// name and renamed once complete, so a failed save never destroys an existing one.
+    class SaveWriter
+    {
+        public:
+
+            struct Result
+            {
+                boost::filesystem::path mPath;
+                ESM::SavedGame mProfile; ///< Including the encoded screenshot
+                std::string mError; ///< Empty if the save was written successfully
+            };
+
+            SaveWriter();
+
+            ~SaveWriter();
+            ///< Waits for a running save to complete.
+
+            void start (const boost::filesystem::path& path, const ESM::SavedGame& profile,
+                const Ogre::Image& screenshot, std::string& records, int recordCount);
+            ///< Start writing a saved game.
+            ///
+            /// \param records Serialised records following the saved game header. The data is taken
+            /// over and \a records is left empty.
+            /// \param recordCount Number of records in the file, excluding the TES3 header
+            ///
+            /// \note Waits for the previous save to complete first.
+
+            bool isPending() const;
+            ///< Is a save being written or is its result still waiting to be collected?
+
+            void wait();
+            ///< Block until the current save has been written.
+
+            bool getResult (Result& result);
+            ///< Return the result of a completed save. Each result is only returned once.
+            ///
+            /// \return Has a result been returned?
+
+        private:
+
+            SaveWriter (const SaveWriter&);
+            ///< Not implemented
+
+            SaveWriter& operator= (const SaveWriter&);
+            ///< Not implemented
+
+            void run();
+
+            static std::string getTempPath (const boost::filesystem::path& path);
+
+            boost::thread mThread;
+            mutable boost::mutex mMutex;
+            bool mRunning;
+            bool mFinished;
+
+            Result mResult;
+            Ogre::Image mScreenshot;
+            std::string mRecords;
+            int mRecordCount;
+    };
+}
+
+#endif
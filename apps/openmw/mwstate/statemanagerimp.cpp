@@ -85,6 +85,7 @@ std::map<int, int> MWState::StateManager::buildContentFileIndexMap (const ESM::E
 
 MWState::StateManager::StateManager (const boost::filesystem::path& saves, const std::string& game)
 : mQuitRequest (false), mAskLoadRecent(false), mState (State_NoGame), mCharacterManager (saves, game), mTimePlayed (0)
+, mSaveCharacter (0)
 {
 
 }
@@ -152,6 +153,19 @@ void MWState::StateManager::endGame()
 
 void MWState::StateManager::saveGame (const std::string& description, const Slot *slot)
 {
+    if (mSaveWriter.isPending())
+    {
+        // Finishing the previous save can modify the slot list
+        boost::filesystem::path slotPath;
+        if (slot)
+            slotPath = slot->mPath;
+
+        finishSave (true);
+
+        if (slot)
+            slot = findSlot (*getCurrentCharacter(), slotPath);
+    }
+
     try
     {
         ESM::SavedGame profile;
@@ -183,33 +197,18 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
         int screenshotW = 259*2, screenshotH = 133*2; // *2 to get some nice antialiasing
         Ogre::Image screenshot;
         world.screenshot(screenshot, screenshotW, screenshotH);
-        Ogre::DataStreamPtr encoded = screenshot.encode("jpg");
-        profile.mScreenshot.resize(encoded->size());
-        encoded->read(&profile.mScreenshot[0], encoded->size());
 
+        // The screenshot is encoded by the save writer; the slot receives it once the file is written
         if (!slot)
             slot = getCurrentCharacter()->createSlot (profile);
         else
             slot = getCurrentCharacter()->updateSlot (slot, profile);
 
-        boost::filesystem::ofstream stream (slot->mPath, std::ios::binary);
+        // Serialise into memory; encoding the screenshot and writing the file happen in the background
+        std::ostringstream stream (std::ios::binary);
 
         ESM::ESMWriter writer;
-
-        const std::vector<std::string>& current =
-            MWBase::Environment::get().getWorld()->getContentFiles();
-
-        for (std::vector<std::string>::const_iterator iter (current.begin()); iter!=current.end();
-            ++iter)
-            writer.addMaster (*iter, 0); // not using the size information anyway -> use value of 0
-
-        writer.setFormat (ESM::SavedGame::sCurrentFormat);
-
-        // all unused
-        writer.setVersion(0);
-        writer.setType(0);
-        writer.setAuthor("");
-        writer.setDescription("");
+        writer.setStream (stream);
 
         int recordCount =         1 // saved game header
                 +MWBase::Environment::get().getJournal()->countSavedGameRecords()
@@ -218,9 +217,6 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
                 +MWBase::Environment::get().getDialogueManager()->countSavedGameRecords()
                 +MWBase::Environment::get().getWindowManager()->countSavedGameRecords()
                 +MWBase::Environment::get().getMechanicsManager()->countSavedGameRecords();
-        writer.setRecordCount (recordCount);
-
-        writer.save (stream);
 
         Loading::Listener& listener = *MWBase::Environment::get().getWindowManager()->getLoadingScreen();
         // Using only Cells for progress information, since they typically have the largest records by far
@@ -229,10 +225,6 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
 
         Loading::ScopedLoad load(&listener);
 
-        writer.startRecord (ESM::REC_SAVE);
-        slot->mProfile.save (writer);
-        writer.endRecord (ESM::REC_SAVE);
-
         MWBase::Environment::get().getJournal()->write (writer, listener);
         MWBase::Environment::get().getDialogueManager()->write (writer, listener);
         MWBase::Environment::get().getWorld()->write (writer, listener);
@@ -241,14 +233,18 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
         MWBase::Environment::get().getMechanicsManager()->write(writer, listener);
 
         // Ensure we have written the number of records that was estimated
-        if (writer.getRecordCount() != recordCount+1) // 1 extra for TES3 record
-            std::cerr << "Warning: number of written savegame records does not match. Estimated: " << recordCount+1 << ", written: " << writer.getRecordCount() << std::endl;
+        if (writer.getRecordCount() != recordCount-1) // the saved game header is written by mSaveWriter
+            std::cerr << "Warning: number of written savegame records does not match. Estimated: " << recordCount-1 << ", written: " << writer.getRecordCount() << std::endl;
 
         writer.close();
 
         if (stream.fail())
             throw std::runtime_error("Write operation failed");
 
+        std::string records = stream.str();
+        mSaveCharacter = getCurrentCharacter();
+        mSaveWriter.start (slot->mPath, profile, screenshot, records, recordCount);
+
         Settings::Manager::setString ("character", "Saves",
             slot->mPath.parent_path().filename().string());
     }
@@ -269,6 +265,49 @@ void MWState::StateManager::saveGame (const std::string& description, const Slot
     }
 }
 
+void MWState::StateManager::finishSave (bool wait)
+{
+    if (wait)
+        mSaveWriter.wait();
+
+    SaveWriter::Result result;
+    if (!mSaveWriter.getResult (result))
+        return;
+
+    Character *character = mSaveCharacter;
+    mSaveCharacter = 0;
+
+    const Slot *slot = findSlot (*character, result.mPath);
+
+    if (!result.mError.empty())
+    {
+        std::stringstream error;
+        error << "Failed to save game: " << result.mError;
+
+        std::cerr << error.str() << std::endl;
+
+        std::vector<std::string> buttons;
+        buttons.push_back("#{sOk}");
+        MWBase::Environment::get().getWindowManager()->interactiveMessageBox(error.str(), buttons);
+
+        // If no file was written, clean up the slot
+        if (slot && !boost::filesystem::exists(result.mPath))
+            character->deleteSlot(slot);
+    }
+    else if (slot)
+        character->setScreenshot (slot, result.mProfile.mScreenshot);
+}
+
+const MWState::Slot *MWState::StateManager::findSlot (const Character& character,
+    const boost::filesystem::path& path)
+{
+    for (Character::SlotIterator it = character.begin(); it != character.end(); ++it)
+        if (it->mPath == path)
+            return &*it;
+
+    return 0;
+}
+
 void MWState::StateManager::quickSave (std::string name)
 {
     if (!(mState==State_Running &&
@@ -326,6 +365,8 @@ void MWState::StateManager::loadGame(const std::string& filepath)
 
 void MWState::StateManager::loadGame (const Character *character, const std::string& filepath)
 {
+    finishSave (true);
+
     try
     {
         cleanup();
@@ -500,6 +541,18 @@ void MWState::StateManager::quickLoad()
 
 void MWState::StateManager::deleteGame(const MWState::Character *character, const MWState::Slot *slot)
 {
+    if (mSaveWriter.isPending())
+    {
+        // Finishing the previous save can modify the slot list
+        boost::filesystem::path slotPath = slot->mPath;
+
+        finishSave (true);
+
+        slot = findSlot (*character, slotPath);
+        if (!slot)
+            return;
+    }
+
     mCharacterManager.deleteSlot(character, slot);
 }
 
@@ -525,6 +578,8 @@ void MWState::StateManager::update (float duration)
 {
     mTimePlayed += duration;
 
+    finishSave (false);
+
     // Note: It would be nicer to trigger this from InputManager, i.e. the very beginning of the frame update.
     if (mAskLoadRecent)
     {
@@ -8,6 +8,7 @@
 #include <boost/filesystem/path.hpp>
 
 #include "charactermanager.hpp"
+#include "savewriter.hpp"
 
 namespace MWState
 {
@@ -18,11 +19,20 @@ namespace MWState
             State mState;
             CharacterManager mCharacterManager;
             double mTimePlayed;
+            SaveWriter mSaveWriter;
+            Character *mSaveCharacter; // owner of the slot that is being written by mSaveWriter
 
         private:
 
             void cleanup (bool force = false);
 
+            void finishSave (bool wait);
+            ///< Handle the outcome of a save that was written in the background.
+            ///
+            /// \param wait Block until a running save has been written.
+
+            static const Slot *findSlot (const Character& character, const boost::filesystem::path& path);
+
             bool verifyProfile (const ESM::SavedGame& profile) const;
 
             std::map<int, int> buildContentFileIndexMap (const ESM::ESMReader& reader) const;
@@ -1,5 +1,6 @@
 #include "containerstore.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <typeinfo>
 #include <stdexcept>
@@ -37,26 +38,6 @@ namespace
 
         return sum;
     }
-
-    template<typename T>
-    MWWorld::Ptr searchId (MWWorld::CellRefList<T>& list, const std::string& id,
-        MWWorld::ContainerStore *store)
-    {
-        std::string id2 = Misc::StringUtils::lowerCase (id);
-
-        for (typename MWWorld::CellRefList<T>::List::iterator iter (list.mList.begin());
-             iter!=list.mList.end(); ++iter)
-        {
-            if (Misc::StringUtils::ciEqual(iter->mBase->mId, id2))
-            {
-                MWWorld::Ptr ptr (&*iter, 0);
-                ptr.setContainerStore (store);
-                return ptr;
-            }
-        }
-
-        return MWWorld::Ptr();
-    }
 }
 
 template<typename T>
@@ -76,7 +57,63 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::getState (CellRefList<T
     ref.load (state);
     collection.mList.push_back (ref);
 
-    return ContainerStoreIterator (this, --collection.mList.end());
+    ContainerStoreIterator iter (this, --collection.mList.end());
+    addStack (iter);
+    return iter;
+}
+
+template<typename T>
+void MWWorld::ContainerStore::addStacks (CellRefList<T>& collection)
+{
+    for (typename CellRefList<T>::List::iterator iter (collection.mList.begin());
+        iter!=collection.mList.end(); ++iter)
+        addStack (ContainerStoreIterator (this, iter));
+}
+
+void MWWorld::ContainerStore::addStack (const ContainerStoreIterator& iter)
+{
+    mStacks[Misc::StringUtils::lowerCase (iter->getCellRef().getRefId())].push_back (iter);
+}
+
+void MWWorld::ContainerStore::rebuildStacks()
+{
+    mStacks.clear();
+
+    addStacks (potions);
+    addStacks (appas);
+    addStacks (armors);
+    addStacks (books);
+    addStacks (clothes);
+    addStacks (ingreds);
+    addStacks (lights);
+    addStacks (lockpicks);
+    addStacks (miscItems);
+    addStacks (probes);
+    addStacks (repairs);
+    addStacks (weapons);
+}
+
+const std::vector<MWWorld::ContainerStoreIterator> *MWWorld::ContainerStore::getStacks (
+    const std::string& id) const
+{
+    TStacks::const_iterator iter = mStacks.find (Misc::StringUtils::lowerCase (id));
+
+    if (iter==mStacks.end())
+        return 0;
+
+    return &iter->second;
+}
+
+void MWWorld::ContainerStore::setCount (const Ptr& item, int count)
+{
+    RefData& data = item.getRefData();
+
+    // only stacks with a positive count contribute to the weight (see getTotalWeight)
+    if (mWeightUpToDate)
+        mCachedWeight += (std::max (count, 0) - std::max (data.getCount(), 0)) *
+            item.getClass().getWeight (item);
+
+    data.setCount (count);
 }
 
 void MWWorld::ContainerStore::storeEquipmentState(const MWWorld::LiveCellRefBase &ref, int index, ESM::InventoryState &inventory) const
@@ -115,6 +152,42 @@ const std::string MWWorld::ContainerStore::sGoldId = "gold_001";
 
 MWWorld::ContainerStore::ContainerStore() : mCachedWeight (0), mWeightUpToDate (false) {}
 
+MWWorld::ContainerStore::ContainerStore (const ContainerStore& store)
+: potions (store.potions), appas (store.appas), armors (store.armors), books (store.books),
+  clothes (store.clothes), ingreds (store.ingreds), lights (store.lights),
+  lockpicks (store.lockpicks), miscItems (store.miscItems), probes (store.probes),
+  repairs (store.repairs), weapons (store.weapons), mLevelledItemMap (store.mLevelledItemMap),
+  mCachedWeight (store.mCachedWeight), mWeightUpToDate (store.mWeightUpToDate)
+{
+    rebuildStacks();
+}
+
+MWWorld::ContainerStore& MWWorld::ContainerStore::operator= (const ContainerStore& store)
+{
+    if (&store!=this)
+    {
+        potions = store.potions;
+        appas = store.appas;
+        armors = store.armors;
+        books = store.books;
+        clothes = store.clothes;
+        ingreds = store.ingreds;
+        lights = store.lights;
+        lockpicks = store.lockpicks;
+        miscItems = store.miscItems;
+        probes = store.probes;
+        repairs = store.repairs;
+        weapons = store.weapons;
+        mLevelledItemMap = store.mLevelledItemMap;
+        mCachedWeight = store.mCachedWeight;
+        mWeightUpToDate = store.mWeightUpToDate;
+
+        rebuildStacks();
+    }
+
+    return *this;
+}
+
 MWWorld::ContainerStore::~ContainerStore() {}
 
 MWWorld::ContainerStoreIterator MWWorld::ContainerStore::begin (int mask)
@@ -130,9 +203,9 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::end()
 int MWWorld::ContainerStore::count(const std::string &id)
 {
     int total=0;
-    for (MWWorld::ContainerStoreIterator iter (begin()); iter!=end(); ++iter)
-        if (Misc::StringUtils::ciEqual(iter->getCellRef().getRefId(), id))
-            total += iter->getRefData().getCount();
+    if (const std::vector<ContainerStoreIterator> *stacks_ = getStacks (id))
+        for (std::vector<ContainerStoreIterator>::const_iterator iter (stacks_->begin()); iter!=stacks_->end(); ++iter)
+            total += (*iter)->getRefData().getCount();
     return total;
 }
 
@@ -146,26 +219,32 @@ void MWWorld::ContainerStore::unstack(const Ptr &ptr, const Ptr& container)
 
 MWWorld::ContainerStoreIterator MWWorld::ContainerStore::restack(const MWWorld::Ptr& item)
 {
+    // only items with the same refId can stack
+    const std::vector<ContainerStoreIterator> *stacks_ = getStacks (item.getCellRef().getRefId());
+
     MWWorld::ContainerStoreIterator retval = end();
-    for (MWWorld::ContainerStoreIterator iter (begin()); iter != end(); ++iter)
+    if (stacks_)
     {
-        if (item == *iter)
+        for (std::vector<ContainerStoreIterator>::const_iterator iter (stacks_->begin()); iter != stacks_->end(); ++iter)
         {
-            retval = iter;
-            break;
+            if ((*iter)->getRefData().getCount() && item == **iter)
+            {
+                retval = *iter;
+                break;
+            }
         }
     }
 
     if (retval == end())
         throw std::runtime_error("item is not from this container");
 
-    for (MWWorld::ContainerStoreIterator iter (begin()); iter != end(); ++iter)
+    for (std::vector<ContainerStoreIterator>::const_iterator iter (stacks_->begin()); iter != stacks_->end(); ++iter)
     {
-        if (stacks(*iter, item))
+        if ((*iter)->getRefData().getCount() && stacks(**iter, item))
         {
-            iter->getRefData().setCount(iter->getRefData().getCount() + item.getRefData().getCount());
+            (*iter)->getRefData().setCount((*iter)->getRefData().getCount() + item.getRefData().getCount());
             item.getRefData().setCount(0);
-            retval = iter;
+            retval = *iter;
             break;
         }
     }
@@ -291,8 +370,6 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::add (const Ptr& itemPtr
 
 MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addImp (const Ptr& ptr, int count)
 {
-    int type = getType(ptr);
-
     const MWWorld::ESMStore &esmStore =
         MWBase::Environment::get().getWorld()->getStore();
 
@@ -306,13 +383,16 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addImp (const Ptr& ptr,
     {
         int realCount = count * ptr.getClass().getValue(ptr);
 
-        for (MWWorld::ContainerStoreIterator iter (begin(type)); iter!=end(); ++iter)
+        if (const std::vector<ContainerStoreIterator> *stacks_ = getStacks (MWWorld::ContainerStore::sGoldId))
         {
-            if (Misc::StringUtils::ciEqual((*iter).getCellRef().getRefId(), MWWorld::ContainerStore::sGoldId))
+            for (std::vector<ContainerStoreIterator>::const_iterator iter (stacks_->begin()); iter!=stacks_->end(); ++iter)
             {
-                iter->getRefData().setCount(iter->getRefData().getCount() + realCount);
-                flagAsModified();
-                return iter;
+                if ((*iter)->getRefData().getCount())
+                {
+                    setCount(**iter, (*iter)->getRefData().getCount() + realCount);
+                    flagAsModified();
+                    return *iter;
+                }
             }
         }
 
@@ -320,16 +400,19 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addImp (const Ptr& ptr,
         return addNewStack(ref.getPtr(), realCount);
     }
 
-    // determine whether to stack or not
-    for (MWWorld::ContainerStoreIterator iter (begin(type)); iter!=end(); ++iter)
+    // determine whether to stack or not (only items with the same refId can stack)
+    if (const std::vector<ContainerStoreIterator> *stacks_ = getStacks (ptr.getCellRef().getRefId()))
     {
-        if (stacks(*iter, ptr))
+        for (std::vector<ContainerStoreIterator>::const_iterator iter (stacks_->begin()); iter!=stacks_->end(); ++iter)
         {
-            // stack
-            iter->getRefData().setCount( iter->getRefData().getCount() + count );
+            if ((*iter)->getRefData().getCount() && stacks(**iter, ptr))
+            {
+                // stack
+                setCount(**iter, (*iter)->getRefData().getCount() + count);
 
-            flagAsModified();
-            return iter;
+                flagAsModified();
+                return *iter;
+            }
         }
     }
     // if we got here, this means no stacking
@@ -356,7 +439,11 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addNewStack (const Ptr&
         case Type_Weapon: weapons.mList.push_back (*ptr.get<ESM::Weapon>()); it = ContainerStoreIterator(this, --weapons.mList.end()); break;
     }
 
-    it->getRefData().setCount(count);
+    addStack(it);
+
+    // the copy has not been accounted for in the cached weight yet
+    it->getRefData().setCount(0);
+    setCount(*it, count);
 
     flagAsModified();
     return it;
@@ -366,9 +453,17 @@ int MWWorld::ContainerStore::remove(const std::string& itemId, int count, const
 {
     int toRemove = count;
 
-    for (ContainerStoreIterator iter(begin()); iter != end() && toRemove > 0; ++iter)
-        if (Misc::StringUtils::ciEqual(iter->getCellRef().getRefId(), itemId))
+    // removing may add stacks (e.g. when unequipping), so look the stacks up again every time
+    for (std::size_t i = 0; toRemove > 0; ++i)
+    {
+        const std::vector<ContainerStoreIterator> *stacks_ = getStacks (itemId);
+        if (!stacks_ || i >= stacks_->size())
+            break;
+
+        ContainerStoreIterator iter = (*stacks_)[i];
+        if (iter->getRefData().getCount())
             toRemove -= remove(*iter, toRemove, actor);
+    }
 
     flagAsModified();
 
@@ -386,11 +481,11 @@ int MWWorld::ContainerStore::remove(const Ptr& item, int count, const Ptr& actor
     if (itemRef.getCount() <= toRemove)
     {
         toRemove -= itemRef.getCount();
-        itemRef.setCount(0);
+        setCount(item, 0);
     }
     else
     {
-        itemRef.setCount(itemRef.getCount() - toRemove);
+        setCount(item, itemRef.getCount() - toRemove);
         toRemove = 0;
     }
 
@@ -488,12 +583,14 @@ void MWWorld::ContainerStore::clear()
     for (ContainerStoreIterator iter (begin()); iter!=end(); ++iter)
         iter->getRefData().setCount (0);
 
+    mCachedWeight = 0;
+    mWeightUpToDate = true;
+
     flagAsModified();
 }
 
 void MWWorld::ContainerStore::flagAsModified()
 {
-    mWeightUpToDate = false;
 }
 
 float MWWorld::ContainerStore::getWeight() const
@@ -568,79 +665,12 @@ int MWWorld::ContainerStore::getType (const Ptr& ptr)
 
 MWWorld::Ptr MWWorld::ContainerStore::search (const std::string& id)
 {
-    {
-        Ptr ptr = searchId (potions, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId (appas, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId (armors, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId (books, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
+    const std::vector<ContainerStoreIterator> *stacks_ = getStacks (id);
 
-    {
-        Ptr ptr = searchId (clothes, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
+    if (!stacks_ || stacks_->empty())
+        return Ptr();
 
-    {
-        Ptr ptr = searchId (ingreds, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId (lights, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId (lockpicks, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId (miscItems, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId (probes, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId (repairs, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    {
-        Ptr ptr = searchId (weapons, id, this);
-        if (!ptr.isEmpty())
-            return ptr;
-    }
-
-    return Ptr();
+    return *stacks_->front();
 }
 
 void MWWorld::ContainerStore::writeState (ESM::InventoryState& state)
@@ -703,6 +733,9 @@ void MWWorld::ContainerStore::readState (const ESM::InventoryState& inventory)
 
 
     mLevelledItemMap = inventory.mLevelledItemMap;
+
+    // the loaded items have not been accounted for in the cached weight
+    mWeightUpToDate = false;
 }
 
 
@@ -3,6 +3,7 @@
 
 #include <iterator>
 #include <map>
+#include <vector>
 
 #include <components/esm/loadalch.hpp>
 #include <components/esm/loadappa.hpp>
@@ -72,11 +73,31 @@ namespace MWWorld
             ///< Stores result of levelled item spawns. <refId, count>
             /// This is used to remove the spawned item(s) if the levelled item is restocked.
 
+            typedef std::map<std::string, std::vector<ContainerStoreIterator> > TStacks;
+
+            TStacks mStacks;
+            ///< All stacks in this container (including deleted ones) by lower case refId, in the
+            /// order of the underlying lists.
+
             mutable float mCachedWeight;
             mutable bool mWeightUpToDate;
             ContainerStoreIterator addImp (const Ptr& ptr, int count);
             void addInitialItem (const std::string& id, const std::string& owner, int count, bool topLevel=true, const std::string& levItem = "");
 
+            void addStack (const ContainerStoreIterator& iter);
+            ///< Add a stack that has just been appended to one of the lists to mStacks.
+
+            template<typename T>
+            void addStacks (CellRefList<T>& collection);
+
+            void rebuildStacks();
+
+            const std::vector<ContainerStoreIterator> *getStacks (const std::string& id) const;
+            ///< \return 0, if there never was an item with refId \a id in this container.
+
+            void setCount (const Ptr& item, int count);
+            ///< Set the count of an item in this container and update the cached weight.
+
             template<typename T>
             ContainerStoreIterator getState (CellRefList<T>& collection,
                 const ESM::ObjectState& state);
@@ -96,6 +117,10 @@ namespace MWWorld
 
             ContainerStore();
 
+            ContainerStore (const ContainerStore& store);
+
+            ContainerStore& operator= (const ContainerStore& store);
+
             virtual ~ContainerStore();
 
             virtual ContainerStore* clone() { return new ContainerStore(*this); }
@@ -145,6 +170,7 @@ namespace MWWorld
             ///< Add the item to this container (do not try to stack it onto existing items)
 
             virtual void flagAsModified();
+            ///< Called whenever items have been added to or removed from this container.
 
         public:
 
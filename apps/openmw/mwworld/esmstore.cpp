@@ -290,6 +290,8 @@ void ESMStore::setUp()
     mMagicEffects.setUp();
     mAttributes.setUp();
     mDialogs.setUp();
+
+    mGameSettingValues.refresh(mGameSettings);
 }
 
     int ESMStore::countSavedGameRecords() const
@@ -5,6 +5,7 @@
 
 #include <components/esm/records.hpp>
 #include "store.hpp"
+#include "gamesettings.hpp"
 
 namespace ESM4
 {
@@ -58,6 +59,8 @@ namespace MWWorld
         Store<ESM::GameSetting>     mGameSettings;
         Store<ESM::Script>          mScripts;
 
+        GameSettings mGameSettingValues;
+
         // Lists that need special rules
         Store<ESM::Cell>        mCells;
         Store<ESM::Land>        mLands;
@@ -173,6 +176,15 @@ namespace MWWorld
             throw std::runtime_error("Storage for this type not exist");
         }
 
+        /// Values of frequently used game settings, for use in hot code paths
+        ///
+        /// \note Throws if any of them is missing from the content files.
+        const GameSettings& getGameSettings() const
+        {
+            mGameSettingValues.verify();
+            return mGameSettingValues;
+        }
+
         /// Insert a custom record (i.e. with a generated ID that will not clash will pre-existing records)
         template <class T>
         const T *insert(const T &x) {
@@ -0,0 +1,126 @@
+#include "gamesettings.hpp"
+
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    template<typename T>
+    void resolve (const MWWorld::Store<ESM::GameSetting>& store, const std::string& id, T& value,
+        std::vector<std::string>& missing)
+    {
+        value = 0;
+
+        if (const ESM::GameSetting *setting = store.search (id))
+        {
+            try
+            {
+                if (setting->mValue.getType()==ESM::VT_Float)
+                    value = static_cast<T> (setting->getFloat());
+                else
+                    value = static_cast<T> (setting->getInt());
+                return;
+            }
+            catch (const std::exception&) {} // not a number
+        }
+
+        missing.push_back (id);
+    }
+}
+
+MWWorld::GameSettings::GameSettings()
+{
+    // zero all values
+    refresh (Store<ESM::GameSetting>());
+}
+
+void MWWorld::GameSettings::refresh (const Store<ESM::GameSetting>& store)
+{
+    mMissing.clear();
+
+    resolve (store, "fBlockStillBonus", fBlockStillBonus, mMissing);
+    resolve (store, "fCombatAngleXY", fCombatAngleXY, mMissing);
+    resolve (store, "fCombatAngleZ", fCombatAngleZ, mMissing);
+    resolve (store, "fCombatBlockLeftAngle", fCombatBlockLeftAngle, mMissing);
+    resolve (store, "fCombatBlockRightAngle", fCombatBlockRightAngle, mMissing);
+    resolve (store, "fCombatInvisoMult", fCombatInvisoMult, mMissing);
+    resolve (store, "fCombatKODamageMult", fCombatKODamageMult, mMissing);
+    resolve (store, "fDamageStrengthBase", fDamageStrengthBase, mMissing);
+    resolve (store, "fDamageStrengthMult", fDamageStrengthMult, mMissing);
+    resolve (store, "fElementalShieldMult", fElementalShieldMult, mMissing);
+    resolve (store, "fFatigueAttackBase", fFatigueAttackBase, mMissing);
+    resolve (store, "fFatigueAttackMult", fFatigueAttackMult, mMissing);
+    resolve (store, "fFatigueBlockBase", fFatigueBlockBase, mMissing);
+    resolve (store, "fFatigueBlockMult", fFatigueBlockMult, mMissing);
+    resolve (store, "fHandToHandReach", fHandToHandReach, mMissing);
+    resolve (store, "fHandtoHandHealthPer", fHandtoHandHealthPer, mMissing);
+    resolve (store, "fMaxHandToHandMult", fMaxHandToHandMult, mMissing);
+    resolve (store, "fMinHandToHandMult", fMinHandToHandMult, mMissing);
+    resolve (store, "fProjectileMaxSpeed", fProjectileMaxSpeed, mMissing);
+    resolve (store, "fProjectileMinSpeed", fProjectileMinSpeed, mMissing);
+    resolve (store, "fProjectileThrownStoreChance", fProjectileThrownStoreChance, mMissing);
+    resolve (store, "fSwingBlockBase", fSwingBlockBase, mMissing);
+    resolve (store, "fSwingBlockMult", fSwingBlockMult, mMissing);
+    resolve (store, "fThrownWeaponMaxSpeed", fThrownWeaponMaxSpeed, mMissing);
+    resolve (store, "fThrownWeaponMinSpeed", fThrownWeaponMinSpeed, mMissing);
+    resolve (store, "fWeaponDamageMult", fWeaponDamageMult, mMissing);
+    resolve (store, "fWeaponFatigueBlockMult", fWeaponFatigueBlockMult, mMissing);
+    resolve (store, "fWeaponFatigueMult", fWeaponFatigueMult, mMissing);
+    resolve (store, "fWereWolfSilverWeaponDamageMult", fWereWolfSilverWeaponDamageMult, mMissing);
+    resolve (store, "iBlockMaxChance", iBlockMaxChance, mMissing);
+    resolve (store, "iBlockMinChance", iBlockMinChance, mMissing);
+
+    resolve (store, "fFallAcroBase", fFallAcroBase, mMissing);
+    resolve (store, "fFallAcroMult", fFallAcroMult, mMissing);
+    resolve (store, "fFallDamageDistanceMin", fFallDamageDistanceMin, mMissing);
+    resolve (store, "fFallDistanceBase", fFallDistanceBase, mMissing);
+    resolve (store, "fFallDistanceMult", fFallDistanceMult, mMissing);
+    resolve (store, "fFatigueJumpBase", fFatigueJumpBase, mMissing);
+    resolve (store, "fFatigueJumpMult", fFatigueJumpMult, mMissing);
+    resolve (store, "fFatigueRunBase", fFatigueRunBase, mMissing);
+    resolve (store, "fFatigueRunMult", fFatigueRunMult, mMissing);
+    resolve (store, "fFatigueSneakBase", fFatigueSneakBase, mMissing);
+    resolve (store, "fFatigueSneakMult", fFatigueSneakMult, mMissing);
+    resolve (store, "fFatigueSwimRunBase", fFatigueSwimRunBase, mMissing);
+    resolve (store, "fFatigueSwimRunMult", fFatigueSwimRunMult, mMissing);
+    resolve (store, "fFatigueSwimWalkBase", fFatigueSwimWalkBase, mMissing);
+    resolve (store, "fFatigueSwimWalkMult", fFatigueSwimWalkMult, mMissing);
+    resolve (store, "fJumpMoveBase", fJumpMoveBase, mMissing);
+    resolve (store, "fJumpMoveMult", fJumpMoveMult, mMissing);
+    resolve (store, "fStromWalkMult", fStromWalkMult, mMissing);
+    resolve (store, "fSwimHeightScale", fSwimHeightScale, mMissing);
+
+    resolve (store, "fEndFatigueMult", fEndFatigueMult, mMissing);
+    resolve (store, "fFatigueReturnBase", fFatigueReturnBase, mMissing);
+    resolve (store, "fFatigueReturnMult", fFatigueReturnMult, mMissing);
+    resolve (store, "fHoldBreathTime", fHoldBreathTime, mMissing);
+    resolve (store, "fMagicSunBlockedMult", fMagicSunBlockedMult, mMissing);
+    resolve (store, "fNPCbaseMagickaMult", fNPCbaseMagickaMult, mMissing);
+    resolve (store, "fPCbaseMagickaMult", fPCbaseMagickaMult, mMissing);
+    resolve (store, "fRestMagicMult", fRestMagicMult, mMissing);
+    resolve (store, "fSoulgemMult", fSoulgemMult, mMissing);
+    resolve (store, "fSuffocationDamage", fSuffocationDamage, mMissing);
+
+    resolve (store, "fEffectCostMult", fEffectCostMult, mMissing);
+    resolve (store, "fFatigueSpellBase", fFatigueSpellBase, mMissing);
+    resolve (store, "fFatigueSpellMult", fFatigueSpellMult, mMissing);
+
+    resolve (store, "fAlarmRadius", fAlarmRadius, mMissing);
+    resolve (store, "fIdleChanceMultiplier", fIdleChanceMultiplier, mMissing);
+    resolve (store, "fInteriorHeadTrackMult", fInteriorHeadTrackMult, mMissing);
+    resolve (store, "fMaxHeadTrackDistance", fMaxHeadTrackDistance, mMissing);
+    resolve (store, "fSneakUseDelay", fSneakUseDelay, mMissing);
+    resolve (store, "fSneakUseDist", fSneakUseDist, mMissing);
+    resolve (store, "fVoiceIdleOdds", fVoiceIdleOdds, mMissing);
+    resolve (store, "iCrimeThreshold", iCrimeThreshold, mMissing);
+    resolve (store, "iCrimeThresholdMultiplier", iCrimeThresholdMultiplier, mMissing);
+    resolve (store, "iGreetDistanceMultiplier", iGreetDistanceMultiplier, mMissing);
+    resolve (store, "iVoiceAttackOdds", iVoiceAttackOdds, mMissing);
+}
+
+void MWWorld::GameSettings::throwMissing() const
+{
+    std::ostringstream msg;
+    msg << ESM::GameSetting::getRecordType() << " '" << mMissing.front() << "' not found";
+    throw std::runtime_error (msg.str());
+}
@@ -0,0 +1,119 @@
+#ifndef GAME_MWWORLD_GAMESETTINGS_H
+#define GAME_MWWORLD_GAMESETTINGS_H
+
+#include "store.hpp"
+
+namespace MWWorld
+{
+    /// \brief Values of frequently used game settings
+    ///
+    /// Resolved from the GameSetting store by ESMStore::setUp, so that hot code paths can read
+    /// them without a lookup. Settings that are not listed here have to be looked up in the store.
+    struct GameSettings
+    {
+        // Combat
+        float fBlockStillBonus;
+        float fCombatAngleXY;
+        float fCombatAngleZ;
+        float fCombatBlockLeftAngle;
+        float fCombatBlockRightAngle;
+        float fCombatInvisoMult;
+        float fCombatKODamageMult;
+        float fDamageStrengthBase;
+        float fDamageStrengthMult;
+        float fElementalShieldMult;
+        float fFatigueAttackBase;
+        float fFatigueAttackMult;
+        float fFatigueBlockBase;
+        float fFatigueBlockMult;
+        float fHandToHandReach;
+        float fHandtoHandHealthPer;
+        float fMaxHandToHandMult;
+        float fMinHandToHandMult;
+        float fProjectileMaxSpeed;
+        float fProjectileMinSpeed;
+        float fProjectileThrownStoreChance;
+        float fSwingBlockBase;
+        float fSwingBlockMult;
+        float fThrownWeaponMaxSpeed;
+        float fThrownWeaponMinSpeed;
+        float fWeaponDamageMult;
+        float fWeaponFatigueBlockMult;
+        float fWeaponFatigueMult;
+        float fWereWolfSilverWeaponDamageMult;
+        int iBlockMaxChance;
+        int iBlockMinChance;
+
+        // Movement
+        float fFallAcroBase;
+        float fFallAcroMult;
+        float fFallDamageDistanceMin;
+        float fFallDistanceBase;
+        float fFallDistanceMult;
+        float fFatigueJumpBase;
+        float fFatigueJumpMult;
+        float fFatigueRunBase;
+        float fFatigueRunMult;
+        float fFatigueSneakBase;
+        float fFatigueSneakMult;
+        float fFatigueSwimRunBase;
+        float fFatigueSwimRunMult;
+        float fFatigueSwimWalkBase;
+        float fFatigueSwimWalkMult;
+        float fJumpMoveBase;
+        float fJumpMoveMult;
+        float fStromWalkMult;
+        float fSwimHeightScale;
+
+        // Actor updates
+        float fEndFatigueMult;
+        float fFatigueReturnBase;
+        float fFatigueReturnMult;
+        float fHoldBreathTime;
+        float fMagicSunBlockedMult;
+        float fNPCbaseMagickaMult;
+        float fPCbaseMagickaMult;
+        float fRestMagicMult;
+        float fSoulgemMult;
+        float fSuffocationDamage;
+
+        // Spellcasting
+        float fEffectCostMult;
+        float fFatigueSpellBase;
+        float fFatigueSpellMult;
+
+        // AI
+        float fAlarmRadius;
+        float fIdleChanceMultiplier;
+        float fInteriorHeadTrackMult;
+        float fMaxHeadTrackDistance;
+        float fSneakUseDelay;
+        float fSneakUseDist;
+        float fVoiceIdleOdds;
+        int iCrimeThreshold;
+        int iCrimeThresholdMultiplier;
+        int iGreetDistanceMultiplier;
+        int iVoiceAttackOdds;
+
+        GameSettings();
+
+        void refresh (const Store<ESM::GameSetting>& store);
+        ///< Read the values from \a store. Settings missing from \a store are set to 0 and
+        /// remembered for verify().
+
+        void verify() const
+        {
+            if (!mMissing.empty())
+                throwMissing();
+        }
+        ///< Throw, like Store::find, if a setting was missing from the store at the last refresh.
+
+    private:
+
+        void throwMissing() const;
+
+        std::vector<std::string> mMissing;
+    };
+}
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef OPENMW_MWWORLD_GRIDINDEX_H
+#define OPENMW_MWWORLD_GRIDINDEX_H
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace MWWorld
+{
+    /// \brief Records indexed by exterior grid position
+    ///
+    /// The grid is split into square chunks, which are only allocated once a record is inserted
+    /// into them. The chunk table is dense over the bounding box of all allocated chunks, so a
+    /// lookup is a few index calculations and two array accesses. Positions that would make the
+    /// chunk table unreasonably large are kept in a map instead.
+    ///
+    /// The index does not own the records. Lookups do not modify the index and are therefore
+    /// safe to do from multiple threads, as long as no records are inserted or erased at the same
+    /// time.
+    template <class T>
+    class GridIndex
+    {
+            static const int sChunkSize = 32;
+
+            /// Maximum width and height of the chunk table
+            static const int sMaxChunks = 1024;
+
+            typedef std::vector<T *> Chunk; // empty if not allocated
+            typedef std::map<std::pair<int, int>, T *> Overflow;
+
+            std::vector<Chunk> mChunks; // row major
+            int mChunkX;
+            int mChunkY;
+            int mWidth;
+            int mHeight;
+            Overflow mOverflow;
+
+            static int getChunk (int coordinate)
+            {
+                // round towards negative infinity
+                return coordinate>=0 ? coordinate / sChunkSize : -((-(coordinate+1)) / sChunkSize) - 1;
+            }
+
+            static int getOffset (int x, int y)
+            {
+                return (y - getChunk (y) * sChunkSize) * sChunkSize + (x - getChunk (x) * sChunkSize);
+            }
+
+            /// \return Chunk for the given chunk coordinates, 0 if outside of the chunk table
+            Chunk *findChunk (int chunkX, int chunkY)
+            {
+                if (chunkX<mChunkX || chunkY<mChunkY || chunkX>=mChunkX+mWidth || chunkY>=mChunkY+mHeight)
+                    return 0;
+
+                return &mChunks[(chunkY-mChunkY) * mWidth + (chunkX-mChunkX)];
+            }
+
+            /// Grow the chunk table to include the given chunk.
+            ///
+            /// \return Could the chunk table be grown?
+            bool grow (int chunkX, int chunkY)
+            {
+                int left = chunkX;
+                int bottom = chunkY;
+                int right = chunkX+1;
+                int top = chunkY+1;
+
+                if (mWidth>0)
+                {
+                    left = std::min (left, mChunkX);
+                    bottom = std::min (bottom, mChunkY);
+                    right = std::max (right, mChunkX+mWidth);
+                    top = std::max (top, mChunkY+mHeight);
+                }
+
+                if (right-left>sMaxChunks || top-bottom>sMaxChunks)
+                    return false;
+
+                std::vector<Chunk> chunks ((right-left) * (top-bottom));
+
+                for (int y=0; y<mHeight; ++y)
+                    for (int x=0; x<mWidth; ++x)
+                        chunks[(mChunkY+y-bottom) * (right-left) + (mChunkX+x-left)].swap (
+                            mChunks[y * mWidth + x]);
+
+                mChunks.swap (chunks);
+                mChunkX = left;
+                mChunkY = bottom;
+                mWidth = right-left;
+                mHeight = top-bottom;
+
+                // move records from the overflow map that are now covered by the chunk table
+                for (typename Overflow::iterator iter (mOverflow.begin()); iter!=mOverflow.end();)
+                {
+                    int x = iter->first.first;
+                    int y = iter->first.second;
+
+                    if (Chunk *chunk = findChunk (getChunk (x), getChunk (y)))
+                    {
+                        if (chunk->empty())
+                            chunk->resize (sChunkSize*sChunkSize, 0);
+
+                        (*chunk)[getOffset (x, y)] = iter->second;
+                        mOverflow.erase (iter++);
+                    }
+                    else
+                        ++iter;
+                }
+
+                return true;
+            }
+
+        public:
+
+            GridIndex() : mChunkX (0), mChunkY (0), mWidth (0), mHeight (0) {}
+
+            T *search (int x, int y) const
+            {
+                int chunkX = getChunk (x);
+                int chunkY = getChunk (y);
+
+                if (chunkX>=mChunkX && chunkY>=mChunkY && chunkX<mChunkX+mWidth && chunkY<mChunkY+mHeight)
+                {
+                    const Chunk& chunk = mChunks[(chunkY-mChunkY) * mWidth + (chunkX-mChunkX)];
+                    return chunk.empty() ? 0 : chunk[getOffset (x, y)];
+                }
+
+                if (mOverflow.empty())
+                    return 0;
+
+                typename Overflow::const_iterator iter = mOverflow.find (std::make_pair (x, y));
+                return iter!=mOverflow.end() ? iter->second : 0;
+            }
+
+            /// Insert or replace the record at the given position.
+            void insert (int x, int y, T *record)
+            {
+                int chunkX = getChunk (x);
+                int chunkY = getChunk (y);
+
+                Chunk *chunk = findChunk (chunkX, chunkY);
+
+                if (!chunk && grow (chunkX, chunkY))
+                    chunk = findChunk (chunkX, chunkY);
+
+                if (!chunk)
+                {
+                    mOverflow[std::make_pair (x, y)] = record;
+                    return;
+                }
+
+                if (chunk->empty())
+                    chunk->resize (sChunkSize*sChunkSize, 0);
+
+                (*chunk)[getOffset (x, y)] = record;
+            }
+
+            void erase (int x, int y)
+            {
+                if (Chunk *chunk = findChunk (getChunk (x), getChunk (y)))
+                {
+                    if (!chunk->empty())
+                        (*chunk)[getOffset (x, y)] = 0;
+                }
+                else
+                    mOverflow.erase (std::make_pair (x, y));
+            }
+
+            void clear()
+            {
+                mChunks.clear();
+                mChunkX = mChunkY = mWidth = mHeight = 0;
+                mOverflow.clear();
+            }
+    };
+}
+
+#endif
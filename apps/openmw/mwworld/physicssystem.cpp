@@ -303,8 +303,7 @@ namespace MWWorld
             Ogre::Vector3 halfExtents = physicActor->getHalfExtents();
             position.z += halfExtents.z;
 
-            static const float fSwimHeightScale = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                    .find("fSwimHeightScale")->getFloat();
+            const float fSwimHeightScale = MWBase::Environment::get().getWorld()->getStore().getGameSettings().fSwimHeightScale;
             float swimlevel = waterlevel + halfExtents.z - (halfExtents.z * 2 * fSwimHeightScale);
 
             OEngine::Physic::ActorTracer tracer;
@@ -334,8 +333,7 @@ namespace MWWorld
             {
                 Ogre::Vector3 stormDirection = MWBase::Environment::get().getWorld()->getStormDirection();
                 Ogre::Degree angle = stormDirection.angleBetween(velocity);
-                static const float fStromWalkMult = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>()
-                        .find("fStromWalkMult")->getFloat();
+                const float fStromWalkMult = MWBase::Environment::get().getWorld()->getStore().getGameSettings().fStromWalkMult;
                 velocity *= 1.f-(fStromWalkMult * (angle.valueDegrees()/180.f));
             }
 
@@ -576,11 +574,11 @@ namespace MWWorld
                                                                       const Ogre::Quaternion &orient,
                                                                       float queryDistance)
     {
-        const MWWorld::Store<ESM::GameSetting> &store = MWBase::Environment::get().getWorld()->getStore().get<ESM::GameSetting>();
+        const MWWorld::GameSettings& store = MWBase::Environment::get().getWorld()->getStore().getGameSettings();
 
-        btConeShape shape(Ogre::Degree(store.find("fCombatAngleXY")->getFloat()/2.0f).valueRadians(),
+        btConeShape shape(Ogre::Degree(store.fCombatAngleXY/2.0f).valueRadians(),
                           queryDistance);
-        shape.setLocalScaling(btVector3(1, 1, Ogre::Degree(store.find("fCombatAngleZ")->getFloat()/2.0f).valueRadians() /
+        shape.setLocalScaling(btVector3(1, 1, Ogre::Degree(store.fCombatAngleZ/2.0f).valueRadians() /
                                               shape.getRadius()));
 
         // The shape origin is its center, so we have to move it forward by half the length. The
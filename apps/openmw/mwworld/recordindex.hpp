@@ -0,0 +1,148 @@
+#ifndef OPENMW_MWWORLD_RECORDINDEX_H
+#define OPENMW_MWWORLD_RECORDINDEX_H
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+namespace MWWorld
+{
+    /// \brief Case insensitive hash table of records, keyed by the lower case IDs of a record map
+    ///
+    /// Looking up an ID does not allocate. The keys are not copied, so they must stay valid for as
+    /// long as they are in the index (which is the case for the keys of a std::map).
+    template <class T>
+    class RecordIndex
+    {
+            struct Entry
+            {
+                size_t mHash;
+                const std::string *mKey; // 0 for an empty entry
+                T *mRecord;
+            };
+
+            std::vector<Entry> mEntries; // size is 0 or a power of 2
+            size_t mSize;
+
+            /// FNV-1a over the lower case characters of \a id
+            static size_t hashId (const std::string& id)
+            {
+                size_t hash = 2166136261u;
+
+                for (std::string::const_iterator iter (id.begin()); iter!=id.end(); ++iter)
+                {
+                    hash ^= static_cast<unsigned char> (tolower (static_cast<unsigned char> (*iter)));
+                    hash *= 16777619u;
+                }
+
+                return hash;
+            }
+
+            /// Index of the entry for \a id, or of the empty entry where it would have to be inserted
+            size_t findEntry (const std::string& id, size_t hash) const
+            {
+                size_t mask = mEntries.size()-1;
+                size_t index = hash & mask;
+
+                while (mEntries[index].mKey && !(mEntries[index].mHash==hash && equal (*mEntries[index].mKey, id)))
+                    index = (index+1) & mask;
+
+                return index;
+            }
+
+            void grow()
+            {
+                std::vector<Entry> entries (mEntries.empty() ? 64 : mEntries.size()*2, Entry());
+                entries.swap (mEntries);
+
+                for (typename std::vector<Entry>::const_iterator iter (entries.begin()); iter!=entries.end(); ++iter)
+                    if (iter->mKey)
+                        mEntries[findEntry (*iter->mKey, iter->mHash)] = *iter;
+            }
+
+            static bool equal (const std::string& key, const std::string& id)
+            {
+                if (key.size()!=id.size())
+                    return false;
+
+                for (size_t i=0; i<key.size(); ++i)
+                    if (static_cast<unsigned char> (key[i])!=tolower (static_cast<unsigned char> (id[i])))
+                        return false;
+
+                return true;
+            }
+
+        public:
+
+            RecordIndex() : mSize (0) {}
+
+            /// \param key Lower case ID
+            void insert (const std::string& key, T *record)
+            {
+                if ((mSize+1)*2>mEntries.size())
+                    grow();
+
+                size_t hash = hashId (key);
+                Entry& entry = mEntries[findEntry (key, hash)];
+
+                if (!entry.mKey)
+                    ++mSize;
+
+                entry.mHash = hash;
+                entry.mKey = &key;
+                entry.mRecord = record;
+            }
+
+            void erase (const std::string& id)
+            {
+                if (mEntries.empty())
+                    return;
+
+                size_t mask = mEntries.size()-1;
+                size_t index = findEntry (id, hashId (id));
+
+                if (!mEntries[index].mKey)
+                    return;
+
+                // Move back following entries of the same cluster that would otherwise become
+                // unreachable, so that no tombstones are needed
+                size_t next = index;
+                while (true)
+                {
+                    next = (next+1) & mask;
+
+                    if (!mEntries[next].mKey)
+                        break;
+
+                    size_t home = mEntries[next].mHash & mask;
+
+                    // can the entry at next be moved into the gap at index?
+                    if (((next-home) & mask) >= ((next-index) & mask))
+                    {
+                        mEntries[index] = mEntries[next];
+                        index = next;
+                    }
+                }
+
+                mEntries[index] = Entry();
+                --mSize;
+            }
+
+            void clear()
+            {
+                mEntries.clear();
+                mSize = 0;
+            }
+
+            T *search (const std::string& id) const
+            {
+                if (mSize==0)
+                    return 0;
+
+                const Entry& entry = mEntries[findEntry (id, hashId (id))];
+                return entry.mKey ? entry.mRecord : 0;
+            }
+    };
+}
+
+#endif
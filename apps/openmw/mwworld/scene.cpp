@@ -4,6 +4,7 @@
 
 #include <components/nif/niffile.hpp>
 #include <components/misc/resourcehelpers.hpp>
+#include <components/esmterrain/storage.hpp>
 
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
@@ -237,7 +238,12 @@ namespace MWWorld
                     // Load everything now to reduce IO overhead.
                     const int flags = ESM::Land::DATA_VCLR|ESM::Land::DATA_VHGT|ESM::Land::DATA_VNML|ESM::Land::DATA_VTEX;
 
-                    const ESM::Land::LandData *data = land->getLandData (flags);
+                    const ESM::Land::LandData *data = 0;
+                    {
+                        // the terrain may be loading land data in the background
+                        boost::mutex::scoped_lock lock (ESMTerrain::Storage::getLandLoadMutex());
+                        data = land->getLandData (flags);
+                    }
                     mPhysics->addHeightField (data->mHeights, cell->getCell()->getGridX(), cell->getCell()->getGridY(),
                         0, worldsize / (verts-1), verts);
                 }
@@ -309,7 +315,7 @@ namespace MWWorld
         std::string loadingExteriorText = "#{sLoadingMessage3}";
         loadingListener->setLabel(loadingExteriorText);
 
-        const int halfGridSize = Settings::Manager::getInt("exterior grid size", "Cells")/2;
+        const int halfGridSize = Settings::Manager::getSnapshot().getInt(Settings::Key_ExteriorGridSize)/2;
 
         CellStoreCollection::iterator active = mActiveCells.begin();
         while (active!=mActiveCells.end())
@@ -106,15 +106,28 @@ namespace MWWorld
     template class IndexedStore<ESM::MagicEffect>;
     template class IndexedStore<ESM::Skill>;
 
+    template<typename T>
+    size_t Store<T>::sGenerations = 0;
+
     template<typename T>
     Store<T>::Store()
     {
+        changed();
     }
 
     template<typename T>
     Store<T>::Store(const Store<T>& orig)
         : mStatic(orig.mStatic)
     {
+        for (typename Static::iterator it = mStatic.begin(); it != mStatic.end(); ++it)
+            mStaticIndex.insert(it->first, &it->second);
+        changed();
+    }
+
+    template<typename T>
+    void Store<T>::changed()
+    {
+        mGeneration = ++sGenerations;
     }
 
     template<typename T>
@@ -124,26 +137,17 @@ namespace MWWorld
         assert(mShared.size() >= mStatic.size());
         mShared.erase(mShared.begin() + mStatic.size(), mShared.end());
         mDynamic.clear();
+        mDynamicIndex.clear();
+        changed();
     }
 
     template<typename T>
     const T *Store<T>::search(const std::string &id) const
     {
-        T item;
-        item.mId = Misc::StringUtils::lowerCase(id);
-
-        typename Dynamic::const_iterator dit = mDynamic.find(item.mId);
-        if (dit != mDynamic.end()) {
-            return &dit->second;
-        }
-
-        typename std::map<std::string, T>::const_iterator it = mStatic.find(item.mId);
-
-        if (it != mStatic.end() && Misc::StringUtils::ciEqual(it->second.mId, id)) {
-            return &(it->second);
-        }
+        if (const T *ptr = mDynamicIndex.search(id))
+            return ptr;
 
-        return 0;
+        return mStaticIndex.search(id);
     }
     template<typename T>
     bool Store<T>::isDynamic(const std::string &id) const
@@ -194,10 +198,14 @@ namespace MWWorld
 
         std::pair<typename Static::iterator, bool> inserted = mStatic.insert(std::make_pair(record.mId, record));
         if (inserted.second)
+        {
             mShared.push_back(&inserted.first->second);
+            mStaticIndex.insert(inserted.first->first, &inserted.first->second);
+        }
         else
             inserted.first->second = record;
 
+        changed();
         return RecordId(record.mId, isDeleted);
     }
     template<typename T>
@@ -228,6 +236,11 @@ namespace MWWorld
         return mDynamic.size();
     }
     template<typename T>
+    size_t Store<T>::getGeneration() const
+    {
+        return mGeneration;
+    }
+    template<typename T>
     void Store<T>::listIdentifier(std::vector<std::string> &list) const
     {
         list.reserve(list.size() + getSize());
@@ -245,9 +258,11 @@ namespace MWWorld
         T *ptr = &result.first->second;
         if (result.second) {
             mShared.push_back(ptr);
+            mDynamicIndex.insert(result.first->first, ptr);
         } else {
             *ptr = item;
         }
+        changed();
         return ptr;
     }
     template<typename T>
@@ -259,18 +274,19 @@ namespace MWWorld
         T *ptr = &result.first->second;
         if (result.second) {
             mShared.push_back(ptr);
+            mStaticIndex.insert(result.first->first, ptr);
         } else {
             *ptr = item;
         }
+        changed();
         return ptr;
     }
     template<typename T>
     bool Store<T>::eraseStatic(const std::string &id)
     {
-        T item;
-        item.mId = Misc::StringUtils::lowerCase(id);
+        std::string key = Misc::StringUtils::lowerCase(id);
 
-        typename std::map<std::string, T>::iterator it = mStatic.find(item.mId);
+        typename std::map<std::string, T>::iterator it = mStatic.find(key);
 
         if (it != mStatic.end() && Misc::StringUtils::ciEqual(it->second.mId, id)) {
             // delete from the static part of mShared
@@ -278,13 +294,15 @@ namespace MWWorld
             typename std::vector<T *>::iterator end = sharedIter + mStatic.size();
 
             while (sharedIter != mShared.end() && sharedIter != end) {
-                if((*sharedIter)->mId == item.mId) {
+                if((*sharedIter)->mId == key) {
                     mShared.erase(sharedIter);
                     break;
                 }
                 ++sharedIter;
             }
+            mStaticIndex.erase(key);
             mStatic.erase(it);
+            changed();
         }
 
         return true;
@@ -298,6 +316,7 @@ namespace MWWorld
         if (it == mDynamic.end()) {
             return false;
         }
+        mDynamicIndex.erase(key);
         mDynamic.erase(it);
 
         // have to reinit the whole shared part
@@ -306,6 +325,7 @@ namespace MWWorld
         for (it = mDynamic.begin(); it != mDynamic.end(); ++it) {
             mShared.push_back(&it->second);
         }
+        changed();
         return true;
     }
 
@@ -452,16 +472,7 @@ namespace MWWorld
 
     ESM::Land *Store<ESM::Land>::search(int x, int y) const
     {
-        ESM::Land land;
-        land.mX = x, land.mY = y;
-
-        std::vector<ESM::Land *>::const_iterator it =
-            std::lower_bound(mStatic.begin(), mStatic.end(), &land, Compare());
-
-        if (it != mStatic.end() && (*it)->mX == x && (*it)->mY == y) {
-            return const_cast<ESM::Land *>(*it);
-        }
-        return 0;
+        return mIndex.search(x, y);
     }
 
     ESM::Land *Store<ESM::Land>::find(int x, int y) const
@@ -483,18 +494,14 @@ namespace MWWorld
         ptr->load(esm, isDeleted);
 
         // Same area defined in multiple plugins? -> last plugin wins
-        // Can't use search() because we aren't sorted yet - is there any other way to speed this up?
-        for (std::vector<ESM::Land*>::iterator it = mStatic.begin(); it != mStatic.end(); ++it)
+        if (ESM::Land *old = mIndex.search(ptr->mX, ptr->mY))
         {
-            if ((*it)->mX == ptr->mX && (*it)->mY == ptr->mY)
-            {
-                delete *it;
-                mStatic.erase(it);
-                break;
-            }
+            mStatic.erase(std::find(mStatic.begin(), mStatic.end(), old));
+            delete old;
         }
 
         mStatic.push_back(ptr);
+        mIndex.insert(ptr->mX, ptr->mY, ptr);
 
         return RecordId("", isDeleted);
     }
@@ -566,35 +573,13 @@ namespace MWWorld
 
     const ESM::Cell *Store<ESM::Cell>::search(int x, int y) const
     {
-        ESM::Cell cell;
-        cell.mData.mX = x, cell.mData.mY = y;
-
-        std::pair<int, int> key(x, y);
-        DynamicExt::const_iterator it = mExt.find(key);
-        if (it != mExt.end()) {
-            return &(it->second);
-        }
-
-        DynamicExt::const_iterator dit = mDynamicExt.find(key);
-        if (dit != mDynamicExt.end()) {
-            return &dit->second;
-        }
-
-        return 0;
+        return mExtIndex.search(x, y);
     }
 
     const ESM::Cell *Store<ESM::Cell>::searchOrCreate(int x, int y)
     {
-        std::pair<int, int> key(x, y);
-        DynamicExt::const_iterator it = mExt.find(key);
-        if (it != mExt.end()) {
-            return &(it->second);
-        }
-
-        DynamicExt::const_iterator dit = mDynamicExt.find(key);
-        if (dit != mDynamicExt.end()) {
-            return &dit->second;
-        }
+        if (const ESM::Cell *cell = search(x, y))
+            return cell;
 
         ESM::Cell newCell;
         newCell.mData.mX = x;
@@ -604,7 +589,10 @@ namespace MWWorld
         newCell.mAmbi.mSunlight = 0;
         newCell.mAmbi.mFog = 0;
         newCell.mAmbi.mFogDensity = 0;
-        return &mExt.insert(std::make_pair(key, newCell)).first->second;
+
+        ESM::Cell *ptr = &mExt.insert(std::make_pair(std::make_pair(x, y), newCell)).first->second;
+        mExtIndex.insert(x, y, ptr);
+        return ptr;
     }
 
     const ESM::Cell *Store<ESM::Cell>::find(const std::string &id) const
@@ -726,7 +714,8 @@ namespace MWWorld
                 // push the new references on the list of references to manage
                 cell.postLoad(esm);
 
-                mExt[std::make_pair(cell.mData.mX, cell.mData.mY)] = cell;
+                ESM::Cell *ptr = &(mExt[std::make_pair(cell.mData.mX, cell.mData.mY)] = cell);
+                mExtIndex.insert(cell.mData.mX, cell.mData.mY, ptr);
             }
         }
 
@@ -822,6 +811,7 @@ namespace MWWorld
 
             ptr = &result.first->second;
             mSharedExt.push_back(ptr);
+            mExtIndex.insert(key.first, key.second, ptr);
         } else {
             std::string key = Misc::StringUtils::lowerCase(cell.mName);
 
@@ -873,6 +863,7 @@ namespace MWWorld
             return false;
         }
         mDynamicExt.erase(it);
+        mExtIndex.erase(x, y);
         mSharedExt.erase(
             mSharedExt.begin() + mSharedExt.size(),
             mSharedExt.end()
@@ -923,6 +914,8 @@ namespace MWWorld
             std::pair<Exterior::iterator, bool> ret = mExt.insert(std::make_pair(std::make_pair(pathgrid.mData.mX, pathgrid.mData.mY), pathgrid));
             if (!ret.second)
                 ret.first->second = pathgrid;
+            else
+                mExtIndex.insert(pathgrid.mData.mX, pathgrid.mData.mY, &ret.first->second);
         }
 
         return RecordId("", isDeleted);
@@ -936,10 +929,7 @@ namespace MWWorld
     }
     const ESM::Pathgrid *Store<ESM::Pathgrid>::search(int x, int y) const
     {
-        Exterior::const_iterator it = mExt.find(std::make_pair(x,y));
-        if (it != mExt.end())
-            return &(it->second);
-        return NULL;
+        return mExtIndex.search(x, y);
     }
     const ESM::Pathgrid *Store<ESM::Pathgrid>::search(const std::string& name) const
     {
@@ -1073,6 +1063,7 @@ namespace MWWorld
         for (; it != mStatic.end(); ++it) {
             mShared.push_back(&(it->second));
         }
+        changed();
     }
 
     template <>
@@ -1088,7 +1079,8 @@ namespace MWWorld
         if (found == mStatic.end())
         {
             dialogue.loadData(esm, isDeleted);
-            mStatic.insert(std::make_pair(idLower, dialogue));
+            found = mStatic.insert(std::make_pair(idLower, dialogue)).first;
+            mStaticIndex.insert(found->first, &found->second);
         }
         else
         {
@@ -1096,6 +1088,7 @@ namespace MWWorld
             dialogue = found->second;
         }
 
+        changed();
         return RecordId(dialogue.mId, isDeleted);
     }
 #if 0
@@ -13,6 +13,8 @@
 #include <components/loadinglistener/loadinglistener.hpp>
 
 #include "recordcmp.hpp"
+#include "recordindex.hpp"
+#include "gridindex.hpp"
 
 namespace MWWorld
 {
@@ -148,6 +150,10 @@ namespace MWWorld
         typedef std::map<std::string, T> Dynamic;
         typedef std::map<std::string, T> Static;
 
+        // Case insensitive lookup of the records in mStatic and mDynamic
+        RecordIndex<T> mStaticIndex;
+        RecordIndex<T> mDynamicIndex;
+
         class GetRecords {
             const std::string mFind;
             std::vector<const T*> *mRecords;
@@ -166,6 +172,11 @@ namespace MWWorld
 
         T mLastAddedRecord;
 
+        size_t mGeneration;
+        static size_t sGenerations;
+
+        void changed();
+
         friend class ESMStore;
 
     public:
@@ -200,6 +211,10 @@ namespace MWWorld
         size_t getSize() const;
         int getDynamicSize() const;
 
+        /// Changes whenever records are added, replaced or removed. Never repeats between stores of
+        /// the same type, so it can be used to tell if something built from the records is still valid.
+        size_t getGeneration() const;
+
         /// @note The record identifiers are listed in the order that the records were defined by the content files.
         void listIdentifier(std::vector<std::string> &list) const;
 
@@ -329,6 +344,7 @@ namespace MWWorld
     class Store<ESM::Land> : public StoreBase
     {
         std::vector<ESM::Land *> mStatic;
+        GridIndex<ESM::Land> mIndex;
 
     public:
         typedef SharedIterator<ESM::Land> iterator;
@@ -379,6 +395,9 @@ namespace MWWorld
         DynamicInt mDynamicInt;
         DynamicExt mDynamicExt;
 
+        // The maps above define the iteration order, this is only for lookups
+        GridIndex<ESM::Cell> mExtIndex;
+
         const ESM::Cell *search(const ESM::Cell &cell) const;
         void handleMovedCellRefs(ESM::ESMReader& esm, ESM::Cell* cell);
 
@@ -428,6 +447,7 @@ namespace MWWorld
 
         Interior mInt;
         Exterior mExt;
+        GridIndex<ESM::Pathgrid> mExtIndex;
 
         Store<ESM::Cell>* mCells;
 
@@ -1962,6 +1962,12 @@ namespace MWWorld
         mRendering->getTriangleBatchCount(triangles, batches);
     }
 
+    void World::getAnimationLodStats(unsigned int &skeletonsUpdated, unsigned int &skeletonsSkipped,
+                                     unsigned int &bonesUpdated)
+    {
+        mRendering->getAnimationLodStats(skeletonsUpdated, skeletonsSkipped, bonesUpdated);
+    }
+
     bool World::isFlying(const MWWorld::Ptr &ptr) const
     {
         const MWMechanics::CreatureStats &stats = ptr.getClass().getCreatureStats(ptr);
@@ -3199,7 +3205,7 @@ namespace MWWorld
 
     void World::spawnBloodEffect(const Ptr &ptr, const Vector3 &worldPosition)
     {
-        if (ptr == getPlayerPtr() && Settings::Manager::getBool("hit fader", "GUI"))
+        if (ptr == getPlayerPtr() && Settings::Manager::getSnapshot().getBool(Settings::Key_HitFader))
             return;
 
         int type = ptr.getClass().getBloodTexture(ptr);
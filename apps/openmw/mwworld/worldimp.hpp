@@ -192,6 +192,11 @@ namespace MWWorld
 
             virtual void getTriangleBatchCount(unsigned int &triangles, unsigned int &batches);
 
+            virtual void getAnimationLodStats(unsigned int &skeletonsUpdated, unsigned int &skeletonsSkipped,
+                                              unsigned int &bonesUpdated);
+            ///< Skeletons posed, skeletons skipped by the animation level of detail and bones
+            /// updated in the last frame
+
             virtual const Fallback *getFallback() const;
 
             virtual Player& getPlayer();
@@ -0,0 +1,21 @@
+#ifndef OPENMW_BENCHMARKS_BENCHMARK_H
+#define OPENMW_BENCHMARKS_BENCHMARK_H
+
+#include <ctime>
+#include <string>
+
+namespace Benchmark
+{
+    typedef void (*Function)();
+
+    /// Registers a benchmark under \a name. Meant for static objects at namespace scope.
+    struct Registration
+    {
+        Registration (const std::string& name, Function function);
+    };
+
+    /// Print the processor time spent on \a what since \a start.
+    void report (const std::string& what, std::clock_t start);
+}
+
+#endif
@@ -0,0 +1,109 @@
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include <OgreVector2.h>
+
+#include "components/esmterrain/storage.hpp"
+
+#include "../benchmark.hpp"
+
+namespace
+{
+    // roughly the extent of Vvardenfell in cells
+    const int sMinX = -20;
+    const int sMinY = -16;
+    const int sMaxX = 25;
+    const int sMaxY = 28;
+
+    /// Storage with generated land records for every cell in the area above
+    class BenchmarkStorage : public ESMTerrain::Storage
+    {
+        std::map<std::pair<int, int>, ESM::Land> mLands;
+
+        virtual const ESM::Land* getLand (int cellX, int cellY)
+        {
+            std::map<std::pair<int, int>, ESM::Land>::const_iterator found =
+                mLands.find (std::make_pair (cellX, cellY));
+
+            return found!=mLands.end() ? &found->second : 0;
+        }
+
+        virtual const ESM::LandTexture* getLandTexture (int index, short plugin)
+        {
+            return 0;
+        }
+
+    public:
+
+        BenchmarkStorage()
+        {
+            const int flags = ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX;
+
+            for (int y=sMinY; y<sMaxY; ++y)
+                for (int x=sMinX; x<sMaxX; ++x)
+                {
+                    ESM::Land& land = mLands[std::make_pair (x, y)];
+                    land.mX = x;
+                    land.mY = y;
+                    land.add (flags);
+
+                    ESM::Land::LandData& data = *land.getLandData();
+                    data.mDataTypes = flags;
+
+                    for (int i=0; i<ESM::Land::LAND_NUM_VERTS; ++i)
+                    {
+                        data.mHeights[i] = static_cast<float> (i % 512);
+                        data.mNormals[i*3] = 0;
+                        data.mNormals[i*3+1] = 0;
+                        data.mNormals[i*3+2] = 100;
+                        data.mColours[i*3] = data.mColours[i*3+1] = data.mColours[i*3+2] = 255;
+                    }
+
+                    for (int i=0; i<ESM::Land::LAND_NUM_TEXTURES; ++i)
+                        data.mTextures[i] = 0;
+                }
+        }
+
+        virtual void getBounds (float& minX, float& maxX, float& minY, float& maxY)
+        {
+            minX = sMinX;
+            minY = sMinY;
+            maxX = sMaxX;
+            maxY = sMaxY;
+        }
+    };
+
+    /// Fill the vertex buffers of all chunks of each LOD, as the terrain quad tree does. The land
+    /// cache has the default size, so large chunks need more cells than it holds.
+    void fillVertexBuffers()
+    {
+        BenchmarkStorage storage;
+
+        std::vector<float> positions;
+        std::vector<float> normals;
+        std::vector<Ogre::uint8> colours;
+
+        for (int lod=0; lod<=6; ++lod)
+        {
+            const int size = 1 << lod;
+
+            std::clock_t start = std::clock();
+            int chunkCount = 0;
+
+            for (int y=sMinY; y<sMaxY; y += size)
+                for (int x=sMinX; x<sMaxX; x += size)
+                {
+                    storage.fillVertexBuffers (lod, static_cast<float> (size),
+                        Ogre::Vector2 (x + size/2.f, y + size/2.f), Terrain::Align_XY, positions, normals, colours);
+                    ++chunkCount;
+                }
+
+            std::ostringstream what;
+            what << "LOD " << lod << ", " << chunkCount << " chunks";
+            Benchmark::report (what.str(), start);
+        }
+    }
+
+    Benchmark::Registration sFillVertexBuffers ("esmterrain/fill_vertex_buffers", &fillVertexBuffers);
+}
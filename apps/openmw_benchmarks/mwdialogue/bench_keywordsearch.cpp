@@ -0,0 +1,106 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "apps/openmw/mwdialogue/keywordsearch.hpp"
+
+#include "../benchmark.hpp"
+
+namespace
+{
+    typedef MWDialogue::KeywordSearch<std::string, int> Search;
+
+    std::string makeTopic (unsigned int index)
+    {
+        static const char *syllables[] = { "ald", "bal", "dun", "ebo", "gna", "hla", "ind", "mor",
+                                           "nch", "ran", "sad", "tel", "uvi", "var", "wer", "zai" };
+        std::string topic;
+        do
+        {
+            topic += syllables[index % 16];
+            index /= 16;
+        } while (index);
+        return topic;
+    }
+
+    /// Seed a large topic list at once, then scan dialogue text against it.
+    void scan()
+    {
+        const unsigned int topicCounts[] = { 1000, 5000, 20000 };
+
+        for (unsigned int t = 0; t < sizeof (topicCounts)/sizeof (topicCounts[0]); ++t)
+        {
+            Search search;
+
+            std::ostringstream what;
+            what << topicCounts[t] << " topics";
+
+            std::clock_t start = std::clock();
+
+            for (unsigned int i = 0; i < topicCounts[t]; ++i)
+                search.seed (makeTopic (i), i);
+
+            Benchmark::report (what.str() + ", seed", start);
+
+            std::string text;
+            for (unsigned int i = 0; text.size() < 64*1024; i += 7)
+                text += "Tell me about " + makeTopic (i % (topicCounts[t] * 2)) + ", outlander. ";
+
+            const int passes = 20;
+            size_t found = 0;
+
+            start = std::clock();
+
+            for (int pass = 0; pass < passes; ++pass)
+            {
+                std::vector<Search::Match> matches;
+                search.highlightKeywords (text.begin(), text.end(), matches);
+                found = matches.size();
+            }
+
+            std::ostringstream scanned;
+            scanned << ", scan " << passes << " x " << text.size() / 1024 << " kB (" << found << " matches)";
+            Benchmark::report (what.str() + scanned.str(), start);
+        }
+    }
+
+    /// Learn topics one at a time with a response shown in between, the way the dialogue window does.
+    void learn()
+    {
+        const unsigned int initialTopics = 5000;
+        const unsigned int learnedTopics = 500;
+
+        Search search;
+
+        for (unsigned int i = 0; i < initialTopics; ++i)
+            search.seed (makeTopic (i), i);
+
+        const std::string text = "Tell me about " + makeTopic (3) + " and " + makeTopic (initialTopics - 1) + ", outlander.";
+
+        std::vector<Search::Match> expected;
+        search.highlightKeywords (text.begin(), text.end(), expected);
+
+        bool changed = false;
+        std::clock_t start = std::clock();
+
+        for (unsigned int i = initialTopics; i < initialTopics + learnedTopics; ++i)
+        {
+            search.seed (makeTopic (i), i);
+
+            std::vector<Search::Match> matches;
+            search.highlightKeywords (text.begin(), text.end(), matches);
+            changed = changed || matches.size() != expected.size();
+        }
+
+        std::ostringstream what;
+        what << learnedTopics << " topics learned after " << initialTopics << ", seed and scan";
+        Benchmark::report (what.str(), start);
+
+        if (changed)
+            std::cout << "  error: the learned topics changed the matches" << std::endl;
+    }
+
+    Benchmark::Registration sScan ("mwdialogue/keyword_scan", &scan);
+    Benchmark::Registration sLearn ("mwdialogue/keyword_learn", &learn);
+}
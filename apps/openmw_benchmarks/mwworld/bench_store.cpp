@@ -0,0 +1,75 @@
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <components/esm/loadnpc.hpp>
+#include <components/misc/stringops.hpp>
+
+#include "apps/openmw/mwworld/store.hpp"
+
+#include "../benchmark.hpp"
+
+namespace
+{
+    /// Look up records by ID with Store::search, and the way Store::search used to do it: copy the
+    /// lower case ID into a default constructed record and search the dynamic and static maps.
+    void search()
+    {
+        typedef ESM::NPC RecordType;
+
+        const int recordCount = 10000;
+        const int lookups = 1000000;
+
+        MWWorld::Store<RecordType> store;
+        std::map<std::string, RecordType> staticMap;
+        std::map<std::string, RecordType> dynamicMap;
+
+        std::vector<std::string> ids;
+
+        RecordType record;
+        record.blank();
+
+        for (int i=0; i<recordCount; ++i)
+        {
+            std::ostringstream id;
+            id << "Creature_" << i;
+            record.mId = Misc::StringUtils::lowerCase (id.str());
+            store.insertStatic (record);
+            staticMap.insert (std::make_pair (record.mId, record));
+
+            ids.push_back (id.str());
+        }
+
+        std::ostringstream what;
+        what << lookups << " lookups in " << recordCount << " records";
+
+        int found = 0;
+        std::clock_t start = std::clock();
+
+        for (int i=0; i<lookups; ++i)
+        {
+            RecordType item;
+            item.mId = Misc::StringUtils::lowerCase (ids[i % recordCount]);
+
+            if (dynamicMap.find (item.mId)!=dynamicMap.end() || staticMap.find (item.mId)!=staticMap.end())
+                ++found;
+        }
+
+        Benchmark::report (what.str() + ", record copy and maps", start);
+
+        start = std::clock();
+
+        for (int i=0; i<lookups; ++i)
+            if (store.search (ids[i % recordCount]))
+                ++found;
+
+        Benchmark::report (what.str() + ", Store::search", start);
+
+        if (found!=2*lookups)
+            std::cout << "  error: only " << found << " of " << 2*lookups << " lookups succeeded" << std::endl;
+    }
+
+    Benchmark::Registration sSearch ("mwworld/store_search", &search);
+}
@@ -0,0 +1,68 @@
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <components/esm/loadstat.hpp>
+
+#include "apps/opencs/model/world/collection.hpp"
+#include "apps/opencs/model/world/record.hpp"
+
+#include "../benchmark.hpp"
+
+namespace
+{
+    std::string getId (int index)
+    {
+        std::ostringstream id;
+        id << "static_" << index;
+        return id.str();
+    }
+
+    /// Insert records at random rows of a collection, as merging content files or creating
+    /// records in the middle of a sorted table does, then look all of them up by ID.
+    void insertAtRandomRows()
+    {
+        const int count = 100000;
+
+        std::vector<std::string> ids;
+        ids.reserve (count);
+        for (int i=0; i<count; ++i)
+            ids.push_back (getId (i));
+
+        CSMWorld::Collection<ESM::Static> collection;
+        std::srand (1);
+
+        std::clock_t start = std::clock();
+
+        for (int i=0; i<count; ++i)
+        {
+            ESM::Static record;
+            record.blank();
+            record.mId = ids[i];
+
+            std::unique_ptr<CSMWorld::RecordBase> record2 (
+                new CSMWorld::Record<ESM::Static> (CSMWorld::RecordBase::State_ModifiedOnly, 0, &record));
+
+            collection.insertRecord (std::move (record2), std::rand() % (collection.getSize()+1));
+        }
+
+        std::ostringstream what;
+        what << "insert " << count << " records at random rows";
+        Benchmark::report (what.str(), start);
+
+        start = std::clock();
+
+        int found = 0;
+        for (int i=0; i<count; ++i)
+            if (collection.searchId (ids[i])!=-1)
+                ++found;
+
+        what.str ("");
+        what << "look up the rows of " << found << " records";
+        Benchmark::report (what.str(), start);
+    }
+
+    Benchmark::Registration sInsertAtRandomRows ("opencs/collection_insert", &insertAtRandomRows);
+}
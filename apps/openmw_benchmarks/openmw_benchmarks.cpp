@@ -0,0 +1,40 @@
+#include "benchmark.hpp"
+
+#include <iostream>
+#include <map>
+
+namespace
+{
+    typedef std::map<std::string, Benchmark::Function> Registry;
+
+    Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+}
+
+Benchmark::Registration::Registration (const std::string& name, Function function)
+{
+    getRegistry()[name] = function;
+}
+
+void Benchmark::report (const std::string& what, std::clock_t start)
+{
+    std::cout << "  " << what << ": " << double (std::clock() - start) / CLOCKS_PER_SEC << " s" << std::endl;
+}
+
+/// Runs all benchmarks, or those whose names start with the first argument.
+int main (int argc, char **argv)
+{
+    const std::string filter = argc>1 ? argv[1] : "";
+
+    for (Registry::const_iterator iter (getRegistry().begin()); iter!=getRegistry().end(); ++iter)
+        if (iter->first.compare (0, filter.size(), filter)==0)
+        {
+            std::cout << iter->first << std::endl;
+            iter->second();
+        }
+
+    return 0;
+}
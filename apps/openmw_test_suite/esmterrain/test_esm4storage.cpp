@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include <OgreVector2.h>
+
+#include "components/esmterrain/esm4storage.hpp"
+
+namespace
+{
+    const int sSize = ESM4::Land::VERTS_PER_SIDE;
+
+    /// Storage with flat land records of increasing height, covering 2 x 2 cells
+    class TestStorage : public ESMTerrain::ESM4Storage
+    {
+        std::map<std::pair<int, int>, ESM4::Land> mLands;
+
+        virtual const ESM4::Land* getLand (int cellX, int cellY)
+        {
+            std::map<std::pair<int, int>, ESM4::Land>::const_iterator found =
+                mLands.find (std::make_pair (cellX, cellY));
+
+            return found!=mLands.end() ? &found->second : 0;
+        }
+
+        virtual const ESM4::LandTexture* getLandTexture (ESM4::FormId formId)
+        {
+            return 0;
+        }
+
+    public:
+
+        TestStorage()
+        {
+            for (int y=0; y<2; ++y)
+                for (int x=0; x<2; ++x)
+                {
+                    ESM4::Land& land = mLands[std::make_pair (x, y)];
+                    land.mDataTypes = ESM4::Land::LAND_VHGT;
+                    land.mHeightMap.heightOffset = static_cast<float> (x + y*2);
+
+                    for (int i=0; i<sSize*sSize; ++i)
+                        land.mHeightMap.gradientData[i] = 0;
+                }
+        }
+
+        virtual void getBounds (float& minX, float& maxX, float& minY, float& maxY)
+        {
+            minX = minY = 0;
+            maxX = maxY = 2;
+        }
+    };
+}
+
+TEST(ESMTerrainESM4StorageTest, heights_are_decoded_from_gradients)
+{
+    ESM4::Land::VHGT heightMap;
+    heightMap.heightOffset = 10;
+
+    for (int i=0; i<sSize*sSize; ++i)
+        heightMap.gradientData[i] = static_cast<signed char> ((i*7) % 11 - 5);
+
+    std::vector<float> heights (sSize*sSize);
+    ESMTerrain::decodeHeights (heightMap, &heights[0]);
+
+    // each row starts relative to the start of the previous row, each vertex relative to the previous one
+    float rowStart = heightMap.heightOffset * ESM4::Land::HEIGHT_SCALE;
+    for (int y=0; y<sSize; ++y)
+    {
+        rowStart += heightMap.gradientData[y*sSize] * ESM4::Land::HEIGHT_SCALE;
+
+        float height = rowStart;
+        ASSERT_FLOAT_EQ (height, heights[y*sSize]);
+
+        for (int x=1; x<sSize; ++x)
+        {
+            height += heightMap.gradientData[y*sSize + x] * ESM4::Land::HEIGHT_SCALE;
+            ASSERT_FLOAT_EQ (height, heights[y*sSize + x]);
+        }
+    }
+}
+
+TEST(ESMTerrainESM4StorageTest, quadrant_textures_are_converted_to_cell_layers)
+{
+    ESM4::Land land;
+
+    // the same base texture in the bottom quadrants
+    land.mTextures[0].base.formId = 1;
+    land.mTextures[1].base.formId = 1;
+    land.mTextures[2].base.formId = 2;
+    land.mTextures[3].base.formId = 3;
+
+    ESM4::Land::TxtLayer layer;
+    layer.additional.formId = 4;
+    layer.additional.quadrant = 3;
+    layer.additional.layer = 0;
+
+    ESM4::Land::VTXT point;
+    point.position = 17 + 1; // second vertex of the second row of the quadrant
+    point.opacity = 0.5f;
+    layer.data.push_back (point);
+
+    point.position = 0; // on the border to the neighbouring quadrants
+    point.opacity = 1;
+    layer.data.push_back (point);
+
+    land.mTextures[3].layers.push_back (layer);
+
+    ESMTerrain::ESM4LandObject object (land);
+
+    ASSERT_EQ (4u, object.mLayers.size());
+    ASSERT_EQ (1u, object.mLayers[0]);
+    ASSERT_EQ (2u, object.mLayers[1]);
+    ASSERT_EQ (3u, object.mLayers[2]);
+    ASSERT_EQ (4u, object.mLayers[3]);
+
+    const unsigned char* base = &object.mOpacities[0];
+    const unsigned char* upperLeft = &object.mOpacities[ESM4::Land::LAND_NUM_VERTS];
+    const unsigned char* additional = &object.mOpacities[3*ESM4::Land::LAND_NUM_VERTS];
+
+    ASSERT_EQ (255, base[0]);
+    ASSERT_EQ (255, base[16*sSize + 32]);
+    ASSERT_EQ (0, base[17*sSize]);
+    ASSERT_EQ (255, upperLeft[17*sSize]);
+
+    ASSERT_EQ (128, additional[17*sSize + 17]);
+
+    // border vertices are taken from the quadrant with the lower index
+    ASSERT_EQ (0, additional[16*sSize + 16]);
+}
+
+TEST(ESMTerrainESM4StorageTest, additional_layer_with_base_texture_of_other_quadrant_stays_on_top)
+{
+    ESM4::Land land;
+
+    land.mTextures[0].base.formId = 1;
+    land.mTextures[1].base.formId = 2;
+    land.mTextures[2].base.formId = 3;
+    land.mTextures[3].base.formId = 4;
+
+    // the base texture of quadrant 1 as an additional layer in quadrant 2
+    ESM4::Land::TxtLayer layer;
+    layer.additional.formId = 2;
+    layer.additional.quadrant = 2;
+    layer.additional.layer = 0;
+
+    ESM4::Land::VTXT point;
+    point.position = 17 + 1;
+    point.opacity = 1;
+    layer.data.push_back (point);
+
+    land.mTextures[2].layers.push_back (layer);
+
+    ESMTerrain::ESM4LandObject object (land);
+
+    ASSERT_EQ (5u, object.mLayers.size());
+    ASSERT_EQ (2u, object.mLayers[1]);
+    ASSERT_EQ (3u, object.mLayers[2]);
+    ASSERT_EQ (2u, object.mLayers[4]);
+
+    const int vertex = 17*sSize + 1;
+
+    // the additional layer comes after the base layer of its quadrant
+    ASSERT_EQ (255, object.mOpacities[2*ESM4::Land::LAND_NUM_VERTS + vertex]);
+    ASSERT_EQ (255, object.mOpacities[4*ESM4::Land::LAND_NUM_VERTS + vertex]);
+
+    // the base layer of quadrant 1 is not affected
+    ASSERT_EQ (0, object.mOpacities[1*ESM4::Land::LAND_NUM_VERTS + vertex]);
+}
+
+TEST(ESMTerrainESM4StorageTest, fill_vertex_buffers_spanning_cells)
+{
+    TestStorage storage;
+
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<Ogre::uint8> colours;
+
+    storage.fillVertexBuffers (1, 2, Ogre::Vector2 (1, 1), Terrain::Align_XY, positions, normals, colours);
+
+    const size_t numVerts = sSize;
+    ASSERT_EQ (numVerts*numVerts*3, positions.size());
+
+    const float scale = ESM4::Land::HEIGHT_SCALE;
+
+    // corners of the chunk, the buffers are column major
+    ASSERT_FLOAT_EQ (0, positions[2]);
+    ASSERT_FLOAT_EQ (1*scale, positions[((numVerts-1)*numVerts)*3 + 2]);
+    ASSERT_FLOAT_EQ (2*scale, positions[(numVerts-1)*3 + 2]);
+    ASSERT_FLOAT_EQ (3*scale, positions[((numVerts-1)*numVerts + numVerts-1)*3 + 2]);
+
+    ASSERT_FLOAT_EQ (-ESM4::Land::REAL_SIZE, positions[0]);
+    ASSERT_FLOAT_EQ (ESM4::Land::REAL_SIZE, positions[((numVerts-1)*numVerts)*3]);
+
+    // missing normals point upwards
+    ASSERT_FLOAT_EQ (1, normals[2]);
+
+    float min = 0;
+    float max = 0;
+    ASSERT_TRUE (storage.getMinMaxHeights (1, Ogre::Vector2 (1.5f, 0.5f), min, max));
+    ASSERT_FLOAT_EQ (1*scale, min);
+    ASSERT_FLOAT_EQ (1*scale, max);
+
+    ASSERT_FALSE (storage.getMinMaxHeights (1, Ogre::Vector2 (2.5f, 0.5f), min, max));
+}
@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include <OgreVector2.h>
+
+#include "components/esmterrain/storage.hpp"
+
+namespace
+{
+    const int sGridSize = 4;
+
+    /// Storage with generated land records covering sGridSize x sGridSize cells
+    class TestStorage : public ESMTerrain::Storage
+    {
+        std::map<std::pair<int, int>, ESM::Land> mLands;
+        int mLoadCount;
+
+        virtual const ESM::Land* getLand (int cellX, int cellY)
+        {
+            ++mLoadCount;
+
+            std::map<std::pair<int, int>, ESM::Land>::const_iterator found =
+                mLands.find (std::make_pair (cellX, cellY));
+
+            return found!=mLands.end() ? &found->second : 0;
+        }
+
+        virtual const ESM::LandTexture* getLandTexture (int index, short plugin)
+        {
+            return 0;
+        }
+
+    public:
+
+        TestStorage (size_t landCacheSize)
+            : ESMTerrain::Storage (landCacheSize), mLoadCount (0)
+        {
+            const int flags = ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX;
+
+            for (int y=0; y<sGridSize; ++y)
+                for (int x=0; x<sGridSize; ++x)
+                {
+                    ESM::Land& land = mLands[std::make_pair (x, y)];
+                    land.mX = x;
+                    land.mY = y;
+                    land.add (flags);
+
+                    ESM::Land::LandData& data = *land.getLandData();
+                    data.mDataTypes = flags;
+
+                    for (int i=0; i<ESM::Land::LAND_NUM_VERTS; ++i)
+                    {
+                        data.mHeights[i] = static_cast<float> ((x*7 + y*13 + i) % 512);
+                        data.mNormals[i*3] = static_cast<signed char> ((i+x) % 64 - 32);
+                        data.mNormals[i*3+1] = static_cast<signed char> ((i+y) % 64 - 32);
+                        data.mNormals[i*3+2] = 100;
+                        data.mColours[i*3] = static_cast<unsigned char> (i+x);
+                        data.mColours[i*3+1] = static_cast<unsigned char> (i+y);
+                        data.mColours[i*3+2] = static_cast<unsigned char> (i);
+                    }
+
+                    for (int i=0; i<ESM::Land::LAND_NUM_TEXTURES; ++i)
+                        data.mTextures[i] = 0;
+                }
+        }
+
+        int getLoadCount() const
+        {
+            return mLoadCount;
+        }
+
+        virtual void getBounds (float& minX, float& maxX, float& minY, float& maxY)
+        {
+            minX = minY = 0;
+            maxX = maxY = sGridSize;
+        }
+    };
+
+    struct Buffers
+    {
+        std::vector<float> mPositions;
+        std::vector<float> mNormals;
+        std::vector<Ogre::uint8> mColours;
+
+        bool operator== (const Buffers& buffers) const
+        {
+            return mPositions==buffers.mPositions && mNormals==buffers.mNormals && mColours==buffers.mColours;
+        }
+    };
+
+    struct Chunk
+    {
+        int mLod;
+        float mSize;
+        Ogre::Vector2 mCenter;
+    };
+
+    /// Chunks of different sizes, including ones that reach past the generated land
+    std::vector<Chunk> getChunks()
+    {
+        std::vector<Chunk> chunks;
+
+        for (int y=-1; y<=sGridSize; ++y)
+            for (int x=-1; x<=sGridSize; ++x)
+            {
+                Chunk chunk;
+                chunk.mLod = 0;
+                chunk.mSize = 1;
+                chunk.mCenter = Ogre::Vector2 (x+0.5f, y+0.5f);
+                chunks.push_back (chunk);
+
+                chunk.mSize = 0.5f;
+                chunk.mCenter = Ogre::Vector2 (x+0.25f, y+0.75f);
+                chunks.push_back (chunk);
+
+                chunk.mLod = 2;
+                chunk.mSize = 2;
+                chunk.mCenter = Ogre::Vector2 (static_cast<float> (x+1), static_cast<float> (y+1));
+                chunks.push_back (chunk);
+            }
+
+        return chunks;
+    }
+
+    void fill (ESMTerrain::Storage& storage, const Chunk& chunk, Buffers& buffers)
+    {
+        storage.fillVertexBuffers (chunk.mLod, chunk.mSize, chunk.mCenter, Terrain::Align_XY,
+            buffers.mPositions, buffers.mNormals, buffers.mColours);
+    }
+
+    void fillRepeatedly (ESMTerrain::Storage& storage, const std::vector<Chunk>& chunks,
+        const std::vector<Buffers>& expected, int offset, int& failures)
+    {
+        for (int iteration=0; iteration<20; ++iteration)
+            for (size_t i=0; i<chunks.size(); ++i)
+            {
+                // every thread walks the chunks in a different order
+                size_t index = (i*(offset+1) + offset) % chunks.size();
+
+                Buffers buffers;
+                fill (storage, chunks[index], buffers);
+
+                if (!(buffers==expected[index]))
+                    ++failures;
+            }
+    }
+}
+
+TEST(ESMTerrainStorageTest, land_cache_evicts_least_recently_used)
+{
+    ESMTerrain::LandCache cache (2);
+
+    ESM::Land land;
+    land.add (ESM::Land::DATA_VHGT);
+    land.getLandData()->mDataTypes = ESM::Land::DATA_VHGT;
+
+    ESMTerrain::LandCache::Ptr first (new ESMTerrain::LandObject (land, *land.getLandData()));
+    ESMTerrain::LandCache::Ptr second (new ESMTerrain::LandObject (land, *land.getLandData()));
+
+    cache.insert (0, 0, first);
+    cache.insert (1, 0, second);
+    cache.insert (2, 0, ESMTerrain::LandCache::Ptr());
+
+    ESMTerrain::LandCache::Ptr object;
+    ASSERT_FALSE (cache.search (0, 0, object));
+
+    ASSERT_TRUE (cache.search (2, 0, object));
+    ASSERT_TRUE (!object);
+
+    ASSERT_TRUE (cache.search (1, 0, object));
+    ASSERT_TRUE (object==second);
+
+    // (1, 0) was used more recently than (2, 0)
+    cache.insert (3, 0, first);
+    ASSERT_TRUE (cache.search (1, 0, object));
+    ASSERT_FALSE (cache.search (2, 0, object));
+
+    // evicted objects stay valid while referenced
+    ASSERT_TRUE (first->has (ESM::Land::DATA_VHGT));
+}
+
+TEST(ESMTerrainStorageTest, land_is_loaded_once_while_cached)
+{
+    TestStorage storage (256);
+
+    std::vector<Chunk> chunks = getChunks();
+
+    Buffers buffers;
+    for (std::vector<Chunk>::const_iterator iter (chunks.begin()); iter!=chunks.end(); ++iter)
+        fill (storage, *iter, buffers);
+
+    int loadCount = storage.getLoadCount();
+
+    for (std::vector<Chunk>::const_iterator iter (chunks.begin()); iter!=chunks.end(); ++iter)
+        fill (storage, *iter, buffers);
+
+    // cells without land are cached as well
+    ASSERT_EQ (loadCount, storage.getLoadCount());
+}
+
+TEST(ESMTerrainStorageTest, large_chunks_do_not_flush_the_land_cache)
+{
+    // holds the 3x3 cells needed for a chunk of one cell, but not the 6x6 cells of a chunk of four
+    TestStorage storage (20);
+
+    Chunk small;
+    small.mLod = 0;
+    small.mSize = 1;
+    small.mCenter = Ogre::Vector2 (1.5f, 1.5f);
+
+    Chunk large;
+    large.mLod = 2;
+    large.mSize = 4;
+    large.mCenter = Ogre::Vector2 (2, 2);
+
+    Buffers buffers;
+    fill (storage, small, buffers);
+
+    int loadCount = storage.getLoadCount();
+
+    fill (storage, large, buffers);
+
+    // the cells of the small chunk were taken from the cache
+    ASSERT_EQ (loadCount + 6*6 - 3*3, storage.getLoadCount());
+
+    loadCount = storage.getLoadCount();
+
+    fill (storage, small, buffers);
+
+    ASSERT_EQ (loadCount, storage.getLoadCount());
+}
+
+TEST(ESMTerrainStorageTest, fill_vertex_buffers_from_multiple_threads)
+{
+    std::vector<Chunk> chunks = getChunks();
+
+    std::vector<Buffers> expected (chunks.size());
+    {
+        TestStorage storage (256);
+        for (size_t i=0; i<chunks.size(); ++i)
+            fill (storage, chunks[i], expected[i]);
+    }
+
+    // a cache that is far too small, so that cells are evicted and reloaded all the time
+    TestStorage storage (3);
+
+    const int threadCount = 8;
+    std::vector<int> failures (threadCount, 0);
+
+    boost::thread_group threads;
+    for (int i=0; i<threadCount; ++i)
+        threads.create_thread (boost::bind (&fillRepeatedly, boost::ref (storage), boost::cref (chunks),
+            boost::cref (expected), i, boost::ref (failures[i])));
+
+    threads.join_all();
+
+    for (int i=0; i<threadCount; ++i)
+        ASSERT_EQ (0, failures[i]);
+}
@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+
+#include <sstream>
+
 #include "apps/openmw/mwdialogue/keywordsearch.hpp"
 
 struct KeywordSearchTest : public ::testing::Test
@@ -65,3 +68,111 @@ TEST_F(KeywordSearchTest, keyword_test_conflict_resolution3)
     ASSERT_TRUE (matches.size() == 1);
     ASSERT_TRUE (std::string(matches.front().mBeg, matches.front().mEnd) == "bar lock");
 }
+
+TEST_F(KeywordSearchTest, keyword_test_word_start)
+{
+    // keywords have to start at the beginning of a word, but may end within one
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("bar", 0);
+
+    std::string text = "foobar barn";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+
+    ASSERT_TRUE (matches.size() == 1);
+    ASSERT_TRUE (matches.front().mBeg - text.begin() == 7);
+    ASSERT_TRUE (std::string(matches.front().mBeg, matches.front().mEnd) == "bar");
+}
+
+TEST_F(KeywordSearchTest, keyword_test_incremental_seed)
+{
+    // keywords seeded after a search must be found by the next one
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("dwemer", 1);
+
+    std::string text = "the dwemer ruins";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+    ASSERT_TRUE (matches.size() == 1);
+
+    search.seed("dwemer ruins", 2);
+
+    matches.clear();
+    search.highlightKeywords(text.begin(), text.end(), matches);
+    ASSERT_TRUE (matches.size() == 1);
+    ASSERT_TRUE (matches.front().mValue == 2);
+    ASSERT_TRUE (std::string(matches.front().mBeg, matches.front().mEnd) == "dwemer ruins");
+}
+
+TEST_F(KeywordSearchTest, keyword_test_utf8_case_folding)
+{
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("\xd0\xb4\xd0\xb2\xd0\xb5\xd0\xbc\xd0\xb5\xd1\x80\xd1\x8b", 1); // "двемеры"
+    search.seed("\xc3\xa9tranger", 2); // "étranger"
+
+    // "ДВЕМЕРЫ" and "Étranger"
+    std::string text = "\xd0\x94\xd0\x92\xd0\x95\xd0\x9c\xd0\x95\xd0\xa0\xd0\xab, \xc3\x89tranger";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+
+    ASSERT_TRUE (matches.size() == 2);
+    ASSERT_TRUE (matches.front().mValue == 1);
+    ASSERT_TRUE (matches.front().mEnd - matches.front().mBeg == 14);
+    ASSERT_TRUE (matches.back().mValue == 2);
+    ASSERT_TRUE (std::string(matches.back().mBeg, matches.back().mEnd) == "\xc3\x89tranger");
+
+    int value = 0;
+    ASSERT_TRUE (search.containsKeyword("\xc3\x89TRANGER", value));
+    ASSERT_TRUE (value == 2);
+    ASSERT_FALSE (search.containsKeyword("\xc3\x89trange", value));
+}
+
+TEST_F(KeywordSearchTest, keyword_test_dotted_capital_i)
+{
+    // U+0130 folds to a plain 'i', which is one byte shorter
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("istanbul", 1);
+
+    std::string text = "Old \xc4\xb0STANBUL, not Constantinople";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+
+    ASSERT_TRUE (matches.size() == 1);
+    ASSERT_TRUE (matches.front().mBeg - text.begin() == 4);
+    ASSERT_TRUE (std::string(matches.front().mBeg, matches.front().mEnd) == "\xc4\xb0STANBUL");
+
+    int value = 0;
+    ASSERT_TRUE (search.containsKeyword("\xc4\xb0stanbul", value));
+    ASSERT_TRUE (value == 1);
+}
+
+TEST_F(KeywordSearchTest, keyword_test_seed_between_searches)
+{
+    // keywords learned one at a time end up in automata that get merged; all of them must still be found
+    MWDialogue::KeywordSearch<std::string, int> search;
+
+    std::string text;
+    for (int i = 0; i < 100; ++i)
+    {
+        std::ostringstream topic;
+        topic << "topic " << i << " ";
+        search.seed(topic.str(), i);
+        text += topic.str();
+
+        std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+        search.highlightKeywords(text.begin(), text.end(), matches);
+
+        ASSERT_TRUE (matches.size() == size_t(i + 1));
+        ASSERT_TRUE (matches.back().mValue == i);
+    }
+
+    ASSERT_THROW (search.seed("topic 42 ", 0), std::runtime_error);
+
+    int value = 0;
+    ASSERT_TRUE (search.containsKeyword("TOPIC 17 ", value));
+    ASSERT_TRUE (value == 17);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <sstream>
+
 #include <boost/filesystem/fstream.hpp>
 
 #include <components/files/configurationmanager.hpp>
@@ -313,3 +315,88 @@ TEST_F(StoreTest, overwrite_test)
 
     ASSERT_TRUE (overwrittenRec && overwrittenRec->mModel == "the_new_model");
 }
+
+/// Tests that game settings missing from the content files are reported when they are used.
+TEST_F(StoreTest, missing_game_settings_test)
+{
+    mEsmStore.setUp();
+
+    ASSERT_THROW (mEsmStore.getGameSettings(), std::runtime_error);
+}
+
+/// Tests case insensitive lookup of static and dynamic records.
+TEST_F(StoreTest, search_test)
+{
+    typedef ESM::Apparatus RecordType;
+
+    MWWorld::Store<RecordType> store;
+
+    RecordType record;
+    record.blank();
+
+    for (int i = 0; i < 200; ++i)
+    {
+        std::ostringstream id;
+        id << "Record_" << i;
+        record.mId = id.str();
+        store.insertStatic(record);
+    }
+
+    // dynamic records take precedence
+    record.mId = "record_50";
+    record.mModel = "dynamic";
+    store.insert(record);
+
+    ASSERT_TRUE (store.search("RECORD_7") != NULL);
+    ASSERT_TRUE (store.search("record_199") != NULL);
+    ASSERT_TRUE (store.search("record_200") == NULL);
+    ASSERT_TRUE (store.search("") == NULL);
+    ASSERT_TRUE (store.search("Record_50")->mModel == "dynamic");
+    ASSERT_TRUE (store.search("rEcOrD_51") != NULL);
+
+    // erasing must not hide any of the remaining records
+    for (int i = 0; i < 200; i += 3)
+    {
+        std::ostringstream id;
+        id << "record_" << i;
+        store.eraseStatic(id.str());
+    }
+
+    store.erase("record_50");
+
+    for (int i = 0; i < 200; ++i)
+    {
+        std::ostringstream id;
+        id << "record_" << i;
+        const RecordType* found = store.search(id.str());
+        ASSERT_TRUE ((found != NULL) == (i % 3 != 0));
+        ASSERT_TRUE (!found || found->mModel != "dynamic");
+    }
+
+    store.clearDynamic();
+    ASSERT_TRUE (store.search("record_50") == NULL);
+}
+
+TEST_F(StoreTest, generation_test)
+{
+    typedef ESM::Apparatus RecordType;
+
+    MWWorld::Store<RecordType> store;
+    MWWorld::Store<RecordType> other;
+    ASSERT_TRUE (store.getGeneration() != other.getGeneration());
+
+    RecordType record;
+    record.blank();
+    record.mId = "foobar";
+
+    size_t generation = store.getGeneration();
+    store.insert(record);
+    ASSERT_TRUE (store.getGeneration() != generation);
+
+    generation = store.getGeneration();
+    ASSERT_TRUE (store.search("foobar") != NULL);
+    ASSERT_TRUE (store.getGeneration() == generation);
+
+    store.clearDynamic();
+    ASSERT_TRUE (store.getGeneration() != generation);
+}
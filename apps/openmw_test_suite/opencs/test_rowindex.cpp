@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "apps/opencs/model/world/rowindex.hpp"
+
+struct RowIndexTest : public ::testing::Test
+{
+  protected:
+
+    CSMWorld::RowIndex mIndex;
+
+    // entries in row order, maintained the slow way
+    std::vector<CSMWorld::RowIndex::Handle> mReference;
+
+    virtual void SetUp()
+    {
+        std::srand (1);
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    void insert (int row)
+    {
+        mReference.insert (mReference.begin()+row, mIndex.insert (row));
+    }
+
+    void check()
+    {
+        ASSERT_EQ (static_cast<int> (mReference.size()), mIndex.getSize());
+
+        for (int i=0; i<static_cast<int> (mReference.size()); ++i)
+        {
+            ASSERT_EQ (i, mIndex.getRow (mReference[i]));
+            ASSERT_EQ (mReference[i], mIndex.getHandle (i));
+        }
+    }
+};
+
+TEST_F(RowIndexTest, insert_at_random_rows)
+{
+    for (int i=0; i<1000; ++i)
+        insert (std::rand() % (mIndex.getSize()+1));
+
+    check();
+}
+
+TEST_F(RowIndexTest, erase_range)
+{
+    for (int i=0; i<200; ++i)
+        insert (i);
+
+    mIndex.erase (50, 100);
+    mReference.erase (mReference.begin()+50, mReference.begin()+150);
+
+    check();
+
+    mIndex.erase (0, mIndex.getSize());
+    mReference.clear();
+
+    check();
+}
+
+TEST_F(RowIndexTest, reorder_range)
+{
+    for (int i=0; i<100; ++i)
+        insert (i);
+
+    // reverse rows 10 to 19
+    std::vector<int> order;
+    for (int i=0; i<10; ++i)
+        order.push_back (9-i);
+
+    std::vector<CSMWorld::RowIndex::Handle> reordered (mReference);
+    for (int i=0; i<10; ++i)
+        reordered[10+order[i]] = mReference[10+i];
+
+    mIndex.reorder (10, order);
+    mReference = reordered;
+
+    check();
+}
+
+TEST_F(RowIndexTest, rows_stay_a_permutation_after_many_inserts)
+{
+    const int count = 20000;
+
+    std::vector<CSMWorld::RowIndex::Handle> handles;
+    handles.reserve (count);
+
+    for (int i=0; i<count; ++i)
+        handles.push_back (mIndex.insert (std::rand() % (mIndex.getSize()+1)));
+
+    // the rows of all entries must form a permutation
+    std::vector<char> seen (count, 0);
+
+    for (int i=0; i<count; ++i)
+    {
+        int row = mIndex.getRow (handles[i]);
+        ASSERT_TRUE (row>=0 && row<count);
+        ASSERT_FALSE (seen[row]);
+        seen[row] = 1;
+    }
+}
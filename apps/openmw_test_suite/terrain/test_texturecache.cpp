@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include "components/terrain/texturecache.hpp"
+
+struct TerrainTextureCacheTest : public ::testing::Test
+{
+    boost::filesystem::path mPath;
+
+    virtual void SetUp()
+    {
+        mPath = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    }
+
+    virtual void TearDown()
+    {
+        boost::filesystem::remove_all (mPath);
+    }
+};
+
+TEST_F(TerrainTextureCacheTest, hash_depends_on_order_and_string_boundaries)
+{
+    Terrain::TextureHash first;
+    first.add (std::string ("ab"));
+    first.add (std::string ("c"));
+
+    Terrain::TextureHash second;
+    second.add (std::string ("a"));
+    second.add (std::string ("bc"));
+
+    ASSERT_NE (first.get(), second.get());
+}
+
+TEST_F(TerrainTextureCacheTest, read_returns_written_entry)
+{
+    Terrain::TextureCache cache (mPath, 1<<20);
+
+    std::vector<char> data (1000);
+    for (size_t i=0; i<data.size(); ++i)
+        data[i] = static_cast<char> (i);
+
+    std::vector<char> result;
+    ASSERT_FALSE (cache.read (42, result));
+
+    cache.write (42, data);
+    ASSERT_TRUE (cache.read (42, result));
+    ASSERT_TRUE (result==data);
+
+    // entries persist across sessions
+    Terrain::TextureCache cache2 (mPath, 1<<20);
+    result.clear();
+    ASSERT_TRUE (cache2.read (42, result));
+    ASSERT_TRUE (result==data);
+
+    ASSERT_FALSE (cache2.read (43, result));
+}
+
+TEST_F(TerrainTextureCacheTest, truncated_entry_is_ignored)
+{
+    Terrain::TextureCache cache (mPath, 1<<20);
+
+    cache.write (42, std::vector<char> (1000, 'x'));
+
+    for (boost::filesystem::directory_iterator iter (mPath); iter!=boost::filesystem::directory_iterator(); ++iter)
+        boost::filesystem::resize_file (iter->path(), 500);
+
+    std::vector<char> result;
+    ASSERT_FALSE (cache.read (42, result));
+
+    // and deleted
+    ASSERT_TRUE (boost::filesystem::is_empty (mPath));
+}
+
+TEST_F(TerrainTextureCacheTest, least_recently_used_entries_are_evicted)
+{
+    // room for two entries with their headers, but not for three
+    Terrain::TextureCache cache (mPath, 3000);
+
+    std::vector<char> data (1000, 'x');
+    cache.write (1, data);
+    cache.write (2, data);
+
+    std::vector<char> result;
+    ASSERT_TRUE (cache.read (1, result));
+
+    cache.write (3, data);
+
+    ASSERT_TRUE (cache.read (1, result));
+    ASSERT_FALSE (cache.read (2, result));
+    ASSERT_TRUE (cache.read (3, result));
+}
@@ -1,6 +1,7 @@
 #include "esmwriter.hpp"
 
 #include <cassert>
+#include <cstring>
 #include <fstream>
 #include <stdexcept>
 
@@ -12,7 +13,6 @@ namespace ESM
         : mStream(NULL)
         , mEncoder (0)
         , mRecordCount (0)
-        , mCounting (true)
     {}
 
     unsigned int ESMWriter::getVersion() const
@@ -65,10 +65,7 @@ namespace ESM
 
     void ESMWriter::save(std::ostream& file)
     {
-        mRecordCount = 0;
-        mRecords.clear();
-        mCounting = true;
-        mStream = &file;
+        setStream (file);
 
         startRecord("TES3", 0);
 
@@ -77,10 +74,29 @@ namespace ESM
         endRecord("TES3");
     }
 
+    void ESMWriter::setStream(std::ostream& file)
+    {
+        mRecordCount = 0;
+        mRecords.clear();
+        mBuffer.clear();
+        mStream = &file;
+    }
+
     void ESMWriter::close()
     {
         if (!mRecords.empty())
             throw std::runtime_error ("Unclosed record remaining");
+
+        flush();
+    }
+
+    void ESMWriter::flush()
+    {
+        if (!mBuffer.empty())
+        {
+            mStream->write (&mBuffer[0], mBuffer.size());
+            mBuffer.clear();
+        }
     }
 
     void ESMWriter::startRecord(const std::string& name, uint32_t flags)
@@ -90,7 +106,7 @@ namespace ESM
         writeName(name);
         RecordData rec;
         rec.name = name;
-        rec.position = mStream->tellp();
+        rec.position = mBuffer.size();
         rec.size = 0;
         writeT<uint32_t>(0); // Size goes here
         writeT<uint32_t>(0); // Unused header?
@@ -118,7 +134,7 @@ namespace ESM
         writeName(name);
         RecordData rec;
         rec.name = name;
-        rec.position = mStream->tellp();
+        rec.position = mBuffer.size();
         rec.size = 0;
         writeT<uint32_t>(0); // Size goes here
         mRecords.push_back(rec);
@@ -132,14 +148,11 @@ namespace ESM
         assert(rec.name == name);
         mRecords.pop_back();
 
-        mStream->seekp(rec.position);
-
-        mCounting = false;
-        write (reinterpret_cast<const char*> (&rec.size), sizeof(uint32_t));
-        mCounting = true;
-
-        mStream->seekp(0, std::ios::end);
+        std::memcpy (&mBuffer[rec.position], &rec.size, sizeof(uint32_t));
 
+        // Records are assembled in memory, so the stream is only ever appended to
+        if (mRecords.empty())
+            flush();
     }
 
     void ESMWriter::endRecord (uint32_t name)
@@ -211,13 +224,10 @@ namespace ESM
 
     void ESMWriter::write(const char* data, size_t size)
     {
-        if (mCounting && !mRecords.empty())
-        {
-            for (std::list<RecordData>::iterator it = mRecords.begin(); it != mRecords.end(); ++it)
-                it->size += size;
-        }
+        for (std::list<RecordData>::iterator it = mRecords.begin(); it != mRecords.end(); ++it)
+            it->size += size;
 
-        mStream->write(data, size);
+        mBuffer.insert (mBuffer.end(), data, data + size);
     }
 
     void ESMWriter::setEncoder(ToUTF8::Utf8Encoder* encoder)
@@ -3,6 +3,7 @@
 
 #include <iosfwd>
 #include <list>
+#include <vector>
 
 #include "esmcommon.hpp"
 #include "loadtes3.hpp"
@@ -19,7 +20,7 @@ class ESMWriter
         struct RecordData
         {
             std::string name;
-            std::streampos position;
+            size_t position; // of the size field within mBuffer
             uint32_t size;
         };
 
@@ -52,6 +53,10 @@ class ESMWriter
         void save(std::ostream& file);
         ///< Start saving a file by writing the TES3 header.
 
+        void setStream(std::ostream& file);
+        ///< Start writing records to \a file without a TES3 header, e.g. for records that are going
+        /// to be appended to a file started by a different writer.
+
         void close();
         ///< \note Does not close the stream.
 
@@ -127,12 +132,13 @@ public:
         void write(const char* data, size_t size);
 
     private:
+        void flush();
+
         std::list<RecordData> mRecords;
         std::ostream* mStream;
-        std::streampos mHeaderPos;
+        std::vector<char> mBuffer; // the open top level record, flushed to mStream once complete
         ToUTF8::Utf8Encoder* mEncoder;
         int mRecordCount;
-        bool mCounting;
 
         Header mHeader;
     };
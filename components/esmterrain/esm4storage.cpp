@@ -0,0 +1,486 @@
+#include "esm4storage.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#include <OgreVector2.h>
+#include <OgreVector3.h>
+#include <OgrePlane.h>
+
+#include <components/terrain/quadtreenode.hpp>
+#include <components/misc/stringops.hpp>
+
+namespace
+{
+    const int sSize = ESM4::Land::VERTS_PER_SIDE;
+
+    /// Vertices on one side of a quadrant; neighbouring quadrants share their border vertices
+    const int sQuadSize = ESM4::Land::QUAD_TEXTURE_PER_SIDE + 1;
+
+    /// Index of the quadrant a vertex is taken from. Vertices on a quadrant border belong to the
+    /// quadrant with the lower index.
+    int getQuadrant (int x, int y)
+    {
+        return (y < sQuadSize ? 0 : 2) + (x < sQuadSize ? 0 : 1);
+    }
+
+    size_t addLayer (std::vector<ESM4::FormId>& layers, ESM4::FormId formId)
+    {
+        std::vector<ESM4::FormId>::iterator found = std::find (layers.begin(), layers.end(), formId);
+        if (found != layers.end())
+            return found - layers.begin();
+
+        layers.push_back (formId);
+        return layers.size()-1;
+    }
+
+    bool compareLayerIndex (const ESM4::Land::TxtLayer *left, const ESM4::Land::TxtLayer *right)
+    {
+        return left->additional.layer < right->additional.layer;
+    }
+}
+
+namespace ESMTerrain
+{
+
+    void decodeHeights (const ESM4::Land::VHGT& heightMap, float* heights)
+    {
+        const float scale = static_cast<float> (ESM4::Land::HEIGHT_SCALE);
+        const float offset = heightMap.heightOffset * scale;
+
+        // Each row starts relative to the first vertex of the previous row, and each vertex is relative
+        // to the one before it. The gradients are summed up as integers, so that no rounding errors
+        // accumulate along a row.
+
+        // Running sum of each row, starting with the first column
+        int sums[sSize];
+        int rowStart = 0;
+        for (int y=0; y<sSize; ++y)
+        {
+            rowStart += heightMap.gradientData[y*sSize];
+            sums[y] = rowStart;
+            heights[y*sSize] = offset + rowStart * scale;
+        }
+
+        // The rows are independent of each other, so advance all of them one column at a time. That
+        // leaves no dependency between iterations of the inner loop and lets it be vectorised.
+        for (int x=1; x<sSize; ++x)
+        {
+            for (int y=0; y<sSize; ++y)
+            {
+                sums[y] += heightMap.gradientData[y*sSize + x];
+                heights[y*sSize + x] = offset + sums[y] * scale;
+            }
+        }
+    }
+
+    ESM4LandObject::ESM4LandObject (const ESM4::Land& land)
+        : mDataTypes (land.mDataTypes)
+    {
+        if (has (ESM4::Land::LAND_VHGT))
+            decodeHeights (land.mHeightMap, mHeights);
+
+        if (has (ESM4::Land::LAND_VNML))
+        {
+            for (int i=0; i<ESM4::Land::LAND_NUM_VERTS; ++i)
+            {
+                Ogre::Vector3 normal (land.mVertNorm[i*3], land.mVertNorm[i*3+1], land.mVertNorm[i*3+2]);
+                normal.normalise();
+
+                mNormals[i*3] = normal.x;
+                mNormals[i*3+1] = normal.y;
+                mNormals[i*3+2] = normal.z;
+            }
+        }
+
+        if (has (ESM4::Land::LAND_VCLR))
+            std::memcpy (mColours, land.mVertColr, sizeof (mColours));
+
+        // Convert the per quadrant texture layers into layers for the whole cell. The base textures come
+        // first, so that the base texture of a quadrant covers the base textures of all other quadrants.
+        size_t baseLayers[4];
+        for (int quad=0; quad<4; ++quad)
+            baseLayers[quad] = addLayer (mLayers, land.mTextures[quad].base.formId);
+
+        // Additional layers are blended in the order of their layer index
+        std::vector<const ESM4::Land::TxtLayer*> additional;
+        for (int quad=0; quad<4; ++quad)
+            for (std::vector<ESM4::Land::TxtLayer>::const_iterator iter (land.mTextures[quad].layers.begin());
+                iter!=land.mTextures[quad].layers.end(); ++iter)
+                additional.push_back (&*iter);
+
+        std::stable_sort (additional.begin(), additional.end(), compareLayerIndex);
+
+        // Additional layers get their own slots after all base layers, even if they use the texture of
+        // a base layer. Otherwise the base layers that follow would cover them.
+        std::vector<ESM4::FormId> additionalLayers;
+        for (std::vector<const ESM4::Land::TxtLayer*>::const_iterator iter (additional.begin());
+            iter!=additional.end(); ++iter)
+            addLayer (additionalLayers, (*iter)->additional.formId);
+
+        const size_t firstAdditional = mLayers.size();
+        mLayers.insert (mLayers.end(), additionalLayers.begin(), additionalLayers.end());
+
+        mOpacities.resize (mLayers.size() * ESM4::Land::LAND_NUM_VERTS, 0);
+
+        for (int y=0; y<sSize; ++y)
+            for (int x=0; x<sSize; ++x)
+                mOpacities[baseLayers[getQuadrant (x, y)] * ESM4::Land::LAND_NUM_VERTS + y*sSize + x] = 255;
+
+        for (std::vector<const ESM4::Land::TxtLayer*>::const_iterator iter (additional.begin());
+            iter!=additional.end(); ++iter)
+        {
+            const ESM4::Land::TxtLayer& layer = **iter;
+            int quad = layer.additional.quadrant;
+            if (quad<0 || quad>=4)
+                continue;
+
+            unsigned char* opacities =
+                &mOpacities[(firstAdditional + addLayer (additionalLayers, layer.additional.formId))
+                    * ESM4::Land::LAND_NUM_VERTS];
+
+            for (std::vector<ESM4::Land::VTXT>::const_iterator point (layer.data.begin());
+                point!=layer.data.end(); ++point)
+            {
+                if (point->position >= sQuadSize*sQuadSize)
+                    continue;
+
+                int x = (quad % 2) * (sQuadSize-1) + point->position % sQuadSize;
+                int y = (quad / 2) * (sQuadSize-1) + point->position / sQuadSize;
+
+                if (getQuadrant (x, y)!=quad)
+                    continue;
+
+                float opacity = std::max (0.f, std::min (1.f, point->opacity));
+                unsigned char& value = opacities[y*sSize + x];
+                value = std::max (value, static_cast<unsigned char> (opacity * 255 + 0.5f));
+            }
+        }
+    }
+
+    ESM4Storage::ESM4Storage (size_t landCacheSize)
+        : mLandCache (landCacheSize)
+        , mColourType (Ogre::VertexElement::getBestColourVertexElementType())
+    {
+    }
+
+    ESM4LandCache::Ptr ESM4Storage::getLandObject (int cellX, int cellY)
+    {
+        ESM4LandCache::Ptr object;
+        if (mLandCache.search (cellX, cellY, object))
+            return object;
+
+        boost::mutex::scoped_lock lock (mLandLoadMutex);
+
+        // another thread may have loaded the cell while we were waiting
+        if (mLandCache.search (cellX, cellY, object))
+            return object;
+
+        if (const ESM4::Land *land = getLand (cellX, cellY))
+            object.reset (new ESM4LandObject (*land));
+
+        mLandCache.insert (cellX, cellY, object);
+        return object;
+    }
+
+    bool ESM4Storage::getMinMaxHeights (float size, const Ogre::Vector2& center, float& min, float& max)
+    {
+        assert (size <= 1 && "ESM4Storage::getMinMaxHeights, chunk size should be <= 1 cell");
+
+        Ogre::Vector2 origin = center - Ogre::Vector2(size/2.f, size/2.f);
+
+        int cellX = static_cast<int>(std::floor(origin.x));
+        int cellY = static_cast<int>(std::floor(origin.y));
+
+        int startRow = static_cast<int>((origin.x - cellX) * (sSize-1));
+        int startColumn = static_cast<int>((origin.y - cellY) * (sSize-1));
+
+        int endRow = startRow + static_cast<int>(size * (sSize-1)) + 1;
+        int endColumn = startColumn + static_cast<int>(size * (sSize-1)) + 1;
+
+        ESM4LandCache::Ptr land = getLandObject (cellX, cellY);
+        if (!land || !land->has (ESM4::Land::LAND_VHGT))
+            return false;
+
+        min = std::numeric_limits<float>::max();
+        max = -std::numeric_limits<float>::max();
+        for (int col=startColumn; col<endColumn; ++col)
+        {
+            for (int row=startRow; row<endRow; ++row)
+            {
+                float h = land->mHeights[col*sSize + row];
+                min = std::min (min, h);
+                max = std::max (max, h);
+            }
+        }
+        return true;
+    }
+
+    void ESM4Storage::fillVertexBuffers (int lodLevel, float size, const Ogre::Vector2& center, Terrain::Alignment align,
+                                            std::vector<float>& positions,
+                                            std::vector<float>& normals,
+                                            std::vector<Ogre::uint8>& colours)
+    {
+        // LOD level n means every 2^n-th vertex is kept
+        int increment = 1 << lodLevel;
+
+        Ogre::Vector2 origin = center - Ogre::Vector2(size/2.f, size/2.f);
+
+        int startCellX = static_cast<int>(std::floor(origin.x));
+        int startCellY = static_cast<int>(std::floor(origin.y));
+        int cellCount = static_cast<int>(std::ceil(size));
+
+        size_t numVerts = static_cast<size_t>(size*(sSize - 1) / increment + 1);
+
+        positions.resize(numVerts*numVerts*3);
+        normals.resize(numVerts*numVerts*3);
+        colours.resize(numVerts*numVerts*4);
+
+        const float scale = size * ESM4::Land::REAL_SIZE;
+
+        // Unlike ESM3, the border vertices are stored in both neighbouring cells, so no stitching is needed
+        size_t vertY_ = 0; // of current cell corner
+        for (int cellY = startCellY; cellY < startCellY + cellCount; ++cellY)
+        {
+            size_t vertX_ = 0; // of current cell corner
+            size_t vertY = vertY_;
+
+            for (int cellX = startCellX; cellX < startCellX + cellCount; ++cellX)
+            {
+                ESM4LandCache::Ptr land = getLandObject (cellX, cellY);
+
+                const float *heights = land && land->has (ESM4::Land::LAND_VHGT) ? land->mHeights : 0;
+                const float *cellNormals = land && land->has (ESM4::Land::LAND_VNML) ? land->mNormals : 0;
+                const unsigned char *cellColours = land && land->has (ESM4::Land::LAND_VCLR) ? land->mColours : 0;
+
+                // Skip the first row / column unless we're at a chunk edge,
+                // since this row / column is already contained in a previous cell
+                int rowStart = vertX_ != 0 ? increment : 0;
+                int colStart = vertY_ != 0 ? increment : 0;
+
+                // Only relevant for chunks smaller than (contained in) one cell
+                rowStart += static_cast<int>((origin.x - startCellX) * (sSize-1));
+                colStart += static_cast<int>((origin.y - startCellY) * (sSize-1));
+
+                int rowEnd = std::min(static_cast<int>(rowStart + std::min(1.f, size) * (sSize-1) + 1), sSize);
+                int colEnd = std::min(static_cast<int>(colStart + std::min(1.f, size) * (sSize-1) + 1), sSize);
+
+                size_t vertX = vertX_;
+                vertY = vertY_;
+                for (int col=colStart; col<colEnd; col += increment, ++vertY)
+                {
+                    assert (vertY < numVerts);
+
+                    const float y = (vertY / float(numVerts - 1) - 0.5f) * scale;
+
+                    vertX = vertX_;
+                    for (int row=rowStart; row<rowEnd; row += increment, ++vertX)
+                    {
+                        const size_t vertex = vertX*numVerts + vertY;
+                        const int index = col*sSize + row;
+
+                        positions[vertex*3] = (vertX / float(numVerts - 1) - 0.5f) * scale;
+                        positions[vertex*3+1] = y;
+                        positions[vertex*3+2] = heights ? heights[index] : -2048;
+
+                        if (cellNormals)
+                            std::memcpy (&normals[vertex*3], &cellNormals[index*3], 3*sizeof (float));
+                        else
+                        {
+                            normals[vertex*3] = 0;
+                            normals[vertex*3+1] = 0;
+                            normals[vertex*3+2] = 1;
+                        }
+
+                        Ogre::ColourValue colour = Ogre::ColourValue::White;
+                        if (cellColours)
+                        {
+                            colour.r = cellColours[index*3] / 255.f;
+                            colour.g = cellColours[index*3+1] / 255.f;
+                            colour.b = cellColours[index*3+2] / 255.f;
+                        }
+
+                        Ogre::uint32 rsColour = Ogre::VertexElement::convertColourValue (colour, mColourType);
+                        std::memcpy (&colours[vertex*4], &rsColour, sizeof (Ogre::uint32));
+                    }
+                }
+                vertX_ = vertX;
+
+                assert (vertX_ <= numVerts);
+            }
+            vertY_ = vertY;
+        }
+        assert (vertY_ == numVerts); // Ensure we covered whole area
+    }
+
+    std::string ESM4Storage::getTextureName (ESM4::FormId formId)
+    {
+        if (formId == 0)
+            return getDefaultLayer().mDiffuseMap;
+
+        const ESM4::LandTexture* ltex = getLandTexture (formId);
+
+        // TES5 land textures refer to a texture set instead, which is not supported yet
+        if (!ltex || ltex->mTextureFile.empty())
+        {
+            std::cerr << "Unable to find a texture for land texture " << std::hex << formId << std::dec
+                << ", using default texture instead" << std::endl;
+            return getDefaultLayer().mDiffuseMap;
+        }
+
+        return "textures\\landscape\\" + Misc::StringUtils::lowerCase (ltex->mTextureFile);
+    }
+
+    void ESM4Storage::getBlendmaps (const std::vector<Terrain::QuadTreeNode*>& nodes, std::vector<Terrain::LayerCollection>& out, bool pack)
+    {
+        for (std::vector<Terrain::QuadTreeNode*>::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+        {
+            out.push_back(Terrain::LayerCollection());
+            out.back().mTarget = *it;
+            getBlendmapsImpl(static_cast<float>((*it)->getSize()), (*it)->getCenter(), pack, out.back().mBlendmaps, out.back().mLayers);
+        }
+    }
+
+    void ESM4Storage::getBlendmaps (float chunkSize, const Ogre::Vector2& chunkCenter, bool pack,
+        std::vector<Ogre::PixelBox>& blendmaps, std::vector<Terrain::LayerInfo>& layerList)
+    {
+        getBlendmapsImpl(chunkSize, chunkCenter, pack, blendmaps, layerList);
+    }
+
+    void ESM4Storage::getBlendmapsImpl (float chunkSize, const Ogre::Vector2& chunkCenter, bool pack,
+        std::vector<Ogre::PixelBox>& blendmaps, std::vector<Terrain::LayerInfo>& layerList)
+    {
+        Ogre::Vector2 origin = chunkCenter - Ogre::Vector2(chunkSize/2.f, chunkSize/2.f);
+        int cellX = static_cast<int>(std::floor(origin.x));
+        int cellY = static_cast<int>(std::floor(origin.y));
+
+        // The layers are blended per vertex
+        int rowStart = static_cast<int>((origin.x - cellX) * (sSize-1));
+        int colStart = static_cast<int>((origin.y - cellY) * (sSize-1));
+        const int blendmapSize = static_cast<int>(chunkSize * (sSize-1)) + 1;
+
+        assert (rowStart + blendmapSize <= sSize);
+        assert (colStart + blendmapSize <= sSize);
+
+        ESM4LandCache::Ptr land = getLandObject (cellX, cellY);
+        if (!land || land->mLayers.empty())
+        {
+            layerList.push_back (getDefaultLayer());
+            return;
+        }
+
+        for (std::vector<ESM4::FormId>::const_iterator it = land->mLayers.begin(); it != land->mLayers.end(); ++it)
+            layerList.push_back (mLayerInfoCache.get (getTextureName (*it)));
+
+        int numLayers = static_cast<int>(land->mLayers.size());
+        // numLayers-1 since the base layer doesn't need blending
+        int numBlendmaps = pack ? (numLayers - 1 + 3) / 4 : numLayers - 1;
+
+        int channels = pack ? 4 : 1;
+        Ogre::PixelFormat format = pack ? Ogre::PF_A8B8G8R8 : Ogre::PF_A8;
+
+        for (int i=0; i<numBlendmaps; ++i)
+        {
+            Ogre::uchar* pData =
+                            OGRE_ALLOC_T(Ogre::uchar, blendmapSize*blendmapSize*channels, Ogre::MEMCATEGORY_GENERAL);
+            memset(pData, 0, blendmapSize*blendmapSize*channels);
+
+            // layers packed into this blendmap
+            int firstLayer = 1 + i * (pack ? 4 : 1);
+            int lastLayer = std::min(numLayers, firstLayer + channels);
+
+            for (int layer=firstLayer; layer<lastLayer; ++layer)
+            {
+                const unsigned char* opacities = &land->mOpacities[layer * ESM4::Land::LAND_NUM_VERTS];
+                int channel = layer - firstLayer;
+
+                for (int y=0; y<blendmapSize; ++y)
+                {
+                    const unsigned char* source = &opacities[(colStart + y) * sSize + rowStart];
+                    Ogre::uchar* target = &pData[y*blendmapSize*channels + channel];
+
+                    for (int x=0; x<blendmapSize; ++x)
+                        target[x*channels] = source[x];
+                }
+            }
+
+            blendmaps.push_back(Ogre::PixelBox(blendmapSize, blendmapSize, 1, format, pData));
+        }
+    }
+
+    float ESM4Storage::getHeightAt (const Ogre::Vector3& worldPos)
+    {
+        const float cellSize = static_cast<float> (ESM4::Land::REAL_SIZE);
+
+        int cellX = static_cast<int>(std::floor(worldPos.x / cellSize));
+        int cellY = static_cast<int>(std::floor(worldPos.y / cellSize));
+
+        ESM4LandCache::Ptr land = getLandObject(cellX, cellY);
+        if (!land || !land->has(ESM4::Land::LAND_VHGT))
+            return -2048;
+
+        // Normalized position in the cell
+        float nX = (worldPos.x - (cellX * cellSize))/cellSize;
+        float nY = (worldPos.y - (cellY * cellSize))/cellSize;
+
+        // get left / bottom points (rounded down)
+        float factor = sSize - 1.0f;
+        float invFactor = 1.0f / factor;
+
+        int startX = static_cast<int>(nX * factor);
+        int startY = static_cast<int>(nY * factor);
+        int endX = std::min(startX + 1, sSize-1);
+        int endY = std::min(startY + 1, sSize-1);
+
+        // now get points in terrain space (effectively rounding them to boundaries)
+        float startXTS = startX * invFactor;
+        float startYTS = startY * invFactor;
+        float endXTS = endX * invFactor;
+        float endYTS = endY * invFactor;
+
+        // get parametric from start coord to next point
+        float xParam = (nX - startXTS) * factor;
+        float yParam = (nY - startYTS) * factor;
+
+        // Build all 4 positions in normalized cell space, using point-sampled height
+        Ogre::Vector3 v0 (startXTS, startYTS, land->mHeights[startY*sSize + startX] / cellSize);
+        Ogre::Vector3 v1 (endXTS, startYTS, land->mHeights[startY*sSize + endX] / cellSize);
+        Ogre::Vector3 v2 (endXTS, endYTS, land->mHeights[endY*sSize + endX] / cellSize);
+        Ogre::Vector3 v3 (startXTS, endYTS, land->mHeights[endY*sSize + startX] / cellSize);
+
+        // define this plane in terrain space, with the same triangle alignment as the terrain chunks
+        Ogre::Plane plane;
+        if ((1.0 - yParam) > xParam)
+            plane.redefine(v0, v1, v3);
+        else
+            plane.redefine(v1, v2, v3);
+
+        // Solve plane equation for z
+        return (-plane.normal.x * nX
+                -plane.normal.y * nY
+                - plane.d) / plane.normal.z * cellSize;
+    }
+
+    Terrain::LayerInfo ESM4Storage::getDefaultLayer()
+    {
+        Terrain::LayerInfo info;
+        info.mDiffuseMap = "textures\\landscape\\default.dds";
+        info.mParallax = false;
+        info.mSpecular = false;
+        return info;
+    }
+
+    float ESM4Storage::getCellWorldSize()
+    {
+        return static_cast<float>(ESM4::Land::REAL_SIZE);
+    }
+
+    int ESM4Storage::getCellVertices()
+    {
+        return ESM4::Land::VERTS_PER_SIDE;
+    }
+
+}
@@ -0,0 +1,148 @@
+#ifndef COMPONENTS_ESM_TERRAIN_ESM4STORAGE_H
+#define COMPONENTS_ESM_TERRAIN_ESM4STORAGE_H
+
+#include <boost/thread/mutex.hpp>
+
+#include <components/terrain/storage.hpp>
+
+#include <extern/esm4/land.hpp>
+#include <extern/esm4/ltex.hpp>
+
+#include "landcache.hpp"
+#include "layerinfocache.hpp"
+
+namespace ESMTerrain
+{
+
+    /// Decode the height gradients of an ESM4 VHGT subrecord into heights in world space.
+    /// @param heights ESM4::Land::LAND_NUM_VERTS heights will be written here, row by row
+    void decodeHeights (const ESM4::Land::VHGT& heightMap, float* heights);
+
+    /// @brief Land data of one ESM4 cell, decoded into the form used for rendering.
+    struct ESM4LandObject
+    {
+        explicit ESM4LandObject (const ESM4::Land& land);
+
+        /// Is the given data type (ESM4::Land::LAND_*) available?
+        bool has (int dataType) const { return (mDataTypes & dataType) != 0; }
+
+        int mDataTypes;
+
+        /// Height in world space for each vertex
+        float mHeights[ESM4::Land::LAND_NUM_VERTS];
+
+        /// Normalised normal for each vertex
+        float mNormals[ESM4::Land::LAND_NUM_VERTS * 3];
+
+        /// 24-bit RGB colour for each vertex
+        unsigned char mColours[ESM4::Land::LAND_NUM_VERTS * 3];
+
+        /// Land textures (LTEX form IDs, 0 for the default texture) used by the cell, in splatting
+        /// order. The base textures of the quadrants come first, followed by the additional layers. A
+        /// texture can appear twice, once as a base layer and once as an additional layer.
+        std::vector<ESM4::FormId> mLayers;
+
+        /// Opacity of each layer at each vertex, one block of ESM4::Land::LAND_NUM_VERTS values per layer
+        std::vector<unsigned char> mOpacities;
+    };
+
+    typedef LandObjectCache<ESM4LandObject> ESM4LandCache;
+
+    /// @brief Feeds data from ESM4 terrain records (ESM4::Land, ESM4::LandTexture) of one worldspace
+    ///        into the terrain component, converting it on the fly as needed.
+    class ESM4Storage : public Terrain::Storage
+    {
+    private:
+
+        // Not implemented in this class, because we need different Store implementations for game and editor
+        /// @note Only called with the land loading mutex held, so implementations may load data on demand.
+        virtual const ESM4::Land* getLand (int cellX, int cellY) = 0;
+        virtual const ESM4::LandTexture* getLandTexture (ESM4::FormId formId) = 0;
+
+    protected:
+
+        /// @param landCacheSize Maximum number of cells kept in the land cache
+        explicit ESM4Storage (size_t landCacheSize = 128);
+
+    public:
+
+        /// Return the decoded land data of a cell, loading it first if necessary. Will return a
+        /// 0-pointer if there is no land record for the coordinates \a cellX / \a cellY.
+        /// @note Thread-safe.
+        ESM4LandCache::Ptr getLandObject (int cellX, int cellY);
+
+        // Not implemented in this class, because we need different Store implementations for game and editor
+        /// Get bounds of the whole terrain in cell units
+        virtual void getBounds(float& minX, float& maxX, float& minY, float& maxY) = 0;
+
+        /// Get the minimum and maximum heights of a terrain region.
+        /// @note Will only be called for chunks with size = minBatchSize, i.e. leafs of the quad tree.
+        ///        Larger chunks can simply merge AABB of children.
+        /// @param size size of the chunk in cell units
+        /// @param center center of the chunk in cell units
+        /// @param min min height will be stored here
+        /// @param max max height will be stored here
+        /// @return true if there was data available for this terrain chunk
+        virtual bool getMinMaxHeights (float size, const Ogre::Vector2& center, float& min, float& max);
+
+        /// Fill vertex buffers for a terrain chunk.
+        /// @note May be called from background threads.
+        /// @param lodLevel LOD level, 0 = most detailed
+        /// @param size size of the terrain chunk in cell units
+        /// @param center center of the chunk in cell units
+        /// @param positions buffer to write vertices
+        /// @param normals buffer to write vertex normals
+        /// @param colours buffer to write vertex colours
+        virtual void fillVertexBuffers (int lodLevel, float size, const Ogre::Vector2& center, Terrain::Alignment align,
+                                std::vector<float>& positions,
+                                std::vector<float>& normals,
+                                std::vector<Ogre::uint8>& colours);
+
+        /// Create textures holding layer blend values for a terrain chunk.
+        /// @note The terrain chunk shouldn't be larger than one cell.
+        /// @note May be called from background threads.
+        /// @param chunkSize size of the terrain chunk in cell units
+        /// @param chunkCenter center of the chunk in cell units
+        /// @param pack Whether to pack blend values for up to 4 layers into one texture (one in each channel) -
+        ///        otherwise, each texture contains blend values for one layer only.
+        /// @param blendmaps created blendmaps will be written here
+        /// @param layerList names of the layer textures used will be written here
+        virtual void getBlendmaps (float chunkSize, const Ogre::Vector2& chunkCenter, bool pack,
+                           std::vector<Ogre::PixelBox>& blendmaps,
+                           std::vector<Terrain::LayerInfo>& layerList);
+
+        /// Retrieve pixel data for textures holding layer blend values for terrain chunks and layer texture information.
+        /// @note May be called from background threads.
+        virtual void getBlendmaps (const std::vector<Terrain::QuadTreeNode*>& nodes, std::vector<Terrain::LayerCollection>& out, bool pack);
+
+        virtual float getHeightAt (const Ogre::Vector3& worldPos);
+
+        virtual Terrain::LayerInfo getDefaultLayer();
+
+        /// Get the transformation factor for mapping cell units to world units.
+        virtual float getCellWorldSize();
+
+        /// Get the number of vertices on one side for each cell. Should be (power of two)+1
+        virtual int getCellVertices();
+
+    private:
+        std::string getTextureName (ESM4::FormId formId);
+
+        // Land records may be read through a shared reader, so loading needs to be serialised
+        boost::mutex mLandLoadMutex;
+        ESM4LandCache mLandCache;
+
+        // Format of the vertex colours, as expected by the render system
+        Ogre::VertexElementType mColourType;
+
+        LayerInfoCache mLayerInfoCache;
+
+        // Non-virtual
+        void getBlendmapsImpl (float chunkSize, const Ogre::Vector2& chunkCenter, bool pack,
+                           std::vector<Ogre::PixelBox>& blendmaps,
+                           std::vector<Terrain::LayerInfo>& layerList);
+    };
+
+}
+
+#endif
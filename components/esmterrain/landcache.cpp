@@ -0,0 +1,37 @@
+#include "landcache.hpp"
+
+#include <cstring>
+
+#include <OgreVector3.h>
+
+namespace ESMTerrain
+{
+
+    LandObject::LandObject (const ESM::Land& land, const ESM::Land::LandData& data)
+        : mDataTypes (land.mDataTypes & data.mDataTypes)
+        , mPlugin (land.mPlugin)
+    {
+        if (has (ESM::Land::DATA_VHGT))
+            std::memcpy (mHeights, data.mHeights, sizeof (mHeights));
+
+        if (has (ESM::Land::DATA_VNML))
+        {
+            for (int i=0; i<ESM::Land::LAND_NUM_VERTS; ++i)
+            {
+                Ogre::Vector3 normal (data.mNormals[i*3], data.mNormals[i*3+1], data.mNormals[i*3+2]);
+                normal.normalise();
+
+                mNormals[i*3] = normal.x;
+                mNormals[i*3+1] = normal.y;
+                mNormals[i*3+2] = normal.z;
+            }
+        }
+
+        if (has (ESM::Land::DATA_VCLR))
+            std::memcpy (mColours, data.mColours, sizeof (mColours));
+
+        if (has (ESM::Land::DATA_VTEX))
+            std::memcpy (mTextures, data.mTextures, sizeof (mTextures));
+    }
+
+}
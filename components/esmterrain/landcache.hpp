@@ -0,0 +1,116 @@
+#ifndef COMPONENTS_ESM_TERRAIN_LANDCACHE_H
+#define COMPONENTS_ESM_TERRAIN_LANDCACHE_H
+
+#include <list>
+#include <map>
+#include <utility>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <components/esm/loadland.hpp>
+
+namespace ESMTerrain
+{
+
+    /// @brief Land data of one cell, decoded into the form used for rendering.
+    struct LandObject
+    {
+        /// @param data Land data with all of the data types of \a land loaded
+        LandObject (const ESM::Land& land, const ESM::Land::LandData& data);
+
+        /// Is the given data type (ESM::Land::DATA_*) available?
+        bool has (int dataType) const { return (mDataTypes & dataType) != 0; }
+
+        int mDataTypes;
+        int mPlugin;
+
+        /// Height in world space for each vertex
+        float mHeights[ESM::Land::LAND_NUM_VERTS];
+
+        /// Normalised normal for each vertex
+        float mNormals[ESM::Land::LAND_NUM_VERTS * 3];
+
+        /// 24-bit RGB colour for each vertex
+        unsigned char mColours[ESM::Land::LAND_NUM_VERTS * 3];
+
+        /// Texture indices, see ESM::Land::LandData::mTextures
+        uint16_t mTextures[ESM::Land::LAND_NUM_TEXTURES];
+    };
+
+    /// @brief Reference counted land objects of the most recently used cells.
+    /// @note All functions are thread-safe. Evicted objects stay valid for as long as they are referenced.
+    template <class T>
+    class LandObjectCache
+    {
+    public:
+        typedef boost::shared_ptr<const T> Ptr;
+
+        explicit LandObjectCache (size_t capacity) : mCapacity (capacity) {}
+
+        /// @param object The cached object will be stored here. It is a 0-pointer for cells without land data.
+        /// @return Is the cell in the cache?
+        bool search (int cellX, int cellY, Ptr& object)
+        {
+            boost::mutex::scoped_lock lock (mMutex);
+
+            typename Map::iterator found = mMap.find (std::make_pair (cellX, cellY));
+            if (found == mMap.end())
+                return false;
+
+            mList.splice (mList.begin(), mList, found->second);
+            object = found->second->second;
+            return true;
+        }
+
+        /// Insert the object for a cell, evicting the least recently used cell if the cache is full.
+        /// @param object 0-pointer if the cell has no land data
+        void insert (int cellX, int cellY, const Ptr& object)
+        {
+            boost::mutex::scoped_lock lock (mMutex);
+
+            Key key (cellX, cellY);
+
+            typename Map::iterator found = mMap.find (key);
+            if (found != mMap.end())
+            {
+                found->second->second = object;
+                mList.splice (mList.begin(), mList, found->second);
+                return;
+            }
+
+            mList.push_front (std::make_pair (key, object));
+            mMap.insert (std::make_pair (key, mList.begin()));
+
+            while (mMap.size() > mCapacity)
+            {
+                mMap.erase (mList.back().first);
+                mList.pop_back();
+            }
+        }
+
+        size_t getCapacity() const { return mCapacity; }
+
+        void clear()
+        {
+            boost::mutex::scoped_lock lock (mMutex);
+            mMap.clear();
+            mList.clear();
+        }
+
+    private:
+        typedef std::pair<int, int> Key;
+        typedef std::list<std::pair<Key, Ptr> > List; // most recently used first
+        typedef std::map<Key, typename List::iterator> Map;
+
+        boost::mutex mMutex;
+        size_t mCapacity;
+        List mList;
+        Map mMap;
+    };
+
+    typedef LandObjectCache<LandObject> LandCache;
+
+}
+
+#endif
@@ -0,0 +1,59 @@
+#include "layerinfocache.hpp"
+
+#include <OgreResourceGroupManager.h>
+#include <OgreResourceBackgroundQueue.h>
+
+#include <boost/algorithm/string.hpp>
+
+namespace ESMTerrain
+{
+
+    Terrain::LayerInfo LayerInfoCache::get(const std::string& texture)
+    {
+        boost::mutex::scoped_lock lock(mMutex);
+
+        // Already have this cached?
+        std::map<std::string, Terrain::LayerInfo>::iterator found = mMap.find(texture);
+        if (found != mMap.end())
+            return found->second;
+
+        Terrain::LayerInfo info;
+        info.mParallax = false;
+        info.mSpecular = false;
+        info.mDiffuseMap = texture;
+        std::string texture_ = texture;
+        boost::replace_last(texture_, ".", "_nh.");
+
+        if (Ogre::ResourceGroupManager::getSingleton().resourceExistsInAnyGroup(texture_))
+        {
+            info.mNormalMap = texture_;
+            info.mParallax = true;
+        }
+        else
+        {
+            texture_ = texture;
+            boost::replace_last(texture_, ".", "_n.");
+            if (Ogre::ResourceGroupManager::getSingleton().resourceExistsInAnyGroup(texture_))
+                info.mNormalMap = texture_;
+        }
+
+        texture_ = texture;
+        boost::replace_last(texture_, ".", "_diffusespec.");
+        if (Ogre::ResourceGroupManager::getSingleton().resourceExistsInAnyGroup(texture_))
+        {
+            info.mDiffuseMap = texture_;
+            info.mSpecular = true;
+        }
+
+        // This wasn't cached, so the textures are probably not loaded either.
+        // Background load them so they are hopefully already loaded once we need them!
+        Ogre::ResourceBackgroundQueue::getSingleton().load("Texture", info.mDiffuseMap, "General");
+        if (!info.mNormalMap.empty())
+            Ogre::ResourceBackgroundQueue::getSingleton().load("Texture", info.mNormalMap, "General");
+
+        mMap[texture] = info;
+
+        return info;
+    }
+
+}
@@ -0,0 +1,34 @@
+#ifndef COMPONENTS_ESM_TERRAIN_LAYERINFOCACHE_H
+#define COMPONENTS_ESM_TERRAIN_LAYERINFOCACHE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+#include <OgrePixelFormat.h>
+
+#include <components/terrain/defs.hpp>
+
+namespace ESMTerrain
+{
+
+    /// @brief Layer information for land textures, including the normal and specular maps that are
+    ///        available for them.
+    /// @note Thread-safe.
+    class LayerInfoCache
+    {
+    public:
+        /// Look up the layer for a diffuse texture, starting to load its textures in the background
+        /// the first time it is used.
+        Terrain::LayerInfo get (const std::string& texture);
+
+    private:
+        boost::mutex mMutex;
+        std::map<std::string, Terrain::LayerInfo> mMap;
+    };
+
+}
+
+#endif
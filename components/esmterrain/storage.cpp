@@ -7,24 +7,238 @@
 #include <OgreTextureManager.h>
 #include <OgreStringConverter.h>
 #include <OgreRenderSystem.h>
-#include <OgreResourceGroupManager.h>
-#include <OgreResourceBackgroundQueue.h>
 #include <OgreRoot.h>
 
-#include <boost/algorithm/string.hpp>
-
 #include <components/terrain/quadtreenode.hpp>
 #include <components/misc/resourcehelpers.hpp>
 
 namespace ESMTerrain
 {
 
-    const ESM::Land::LandData *Storage::getLandData (int cellX, int cellY, int flags)
+    namespace
+    {
+        boost::mutex sLandLoadMutex;
+
+        /// Number of blendmaps needed for the given number of layers. The base layer doesn't need blending.
+        size_t getBlendmapCount (size_t numTextures, bool pack)
+        {
+            return pack ? (numTextures - 1 + 3) / 4 : numTextures - 1;
+        }
+
+        void writeInt (std::vector<char>& data, int value)
+        {
+            const char* bytes = reinterpret_cast<const char*> (&value);
+            data.insert (data.end(), bytes, bytes + sizeof (value));
+        }
+
+        /// @return false if there is not enough data left
+        bool readInt (const std::vector<char>& data, size_t& offset, int& value)
+        {
+            if (data.size() - offset < sizeof (value))
+                return false;
+
+            memcpy (&value, &data[offset], sizeof (value));
+            offset += sizeof (value);
+            return true;
+        }
+
+        /// Land objects of three consecutive rows of cells, which is all that is needed to fill and
+        /// stitch the vertices of the middle row. The window is moved along as the rows are filled,
+        /// so that large chunks don't keep all of their cells decoded at the same time.
+        class LandNeighbourhood
+        {
+                Storage& mStorage;
+                int mX;
+                int mY; ///< first row in the window
+                int mWidth;
+                int mFirst; ///< slot of row mY in mLands
+                bool mCache;
+                std::vector<LandCache::Ptr> mLands;
+
+                void loadRow (int cellY, int slot)
+                {
+                    for (int cellX=0; cellX<mWidth; ++cellX)
+                        mLands[slot*mWidth + cellX] = mStorage.getLandObject (mX+cellX, cellY, mCache);
+                }
+
+            public:
+
+                /// @param cacheCapacity Capacity of the land cache of \a storage
+                /// @param width Number of cells in each row
+                /// @param height Number of rows that will be walked through
+                LandNeighbourhood (Storage& storage, size_t cacheCapacity, int x, int y, int width, int height)
+                    : mStorage (storage), mX (x), mY (y), mWidth (width), mFirst (0), mLands (3*width)
+                {
+                    // The cells of large chunks would flush the cache, including the cells of the chunks
+                    // around the camera that are actually reused. Those are still taken from the cache,
+                    // but the rest is loaded without being cached.
+                    mCache = static_cast<size_t> (width*height) <= cacheCapacity/2;
+
+                    for (int row=0; row<3; ++row)
+                        loadRow (y+row, row);
+                }
+
+                /// Drop the first row and load the one after the last.
+                void advance()
+                {
+                    loadRow (mY+3, mFirst);
+                    mFirst = (mFirst+1) % 3;
+                    ++mY;
+                }
+
+                /// Return the land of a cell if it has data of the given type, 0 otherwise.
+                const LandObject *get (int cellX, int cellY, int dataType) const
+                {
+                    assert (cellX >= mX && cellX < mX+mWidth);
+                    assert (cellY >= mY && cellY < mY+3);
+
+                    const int slot = (mFirst + cellY-mY) % 3;
+                    const LandCache::Ptr& land = mLands[slot*mWidth + (cellX-mX)];
+                    return land && land->has (dataType) ? land.get() : 0;
+                }
+        };
+
+        Ogre::Vector3 getNormal (const LandObject *land, int col, int row)
+        {
+            if (!land)
+                return Ogre::Vector3::UNIT_Z;
+
+            const float *normal = &land->mNormals[col*ESM::Land::LAND_SIZE*3+row*3];
+            return Ogre::Vector3 (normal[0], normal[1], normal[2]);
+        }
+
+        Ogre::ColourValue getColour (const LandObject *land, int col, int row)
+        {
+            if (!land)
+                return Ogre::ColourValue::White;
+
+            const unsigned char *colour = &land->mColours[col*ESM::Land::LAND_SIZE*3+row*3];
+            return Ogre::ColourValue (colour[0] / 255.f, colour[1] / 255.f, colour[2] / 255.f);
+        }
+
+        Ogre::Vector3 fixNormal (const LandNeighbourhood& lands, int cellX, int cellY, int col, int row)
+        {
+            while (col >= ESM::Land::LAND_SIZE-1)
+            {
+                ++cellY;
+                col -= ESM::Land::LAND_SIZE-1;
+            }
+            while (row >= ESM::Land::LAND_SIZE-1)
+            {
+                ++cellX;
+                row -= ESM::Land::LAND_SIZE-1;
+            }
+            while (col < 0)
+            {
+                --cellY;
+                col += ESM::Land::LAND_SIZE-1;
+            }
+            while (row < 0)
+            {
+                --cellX;
+                row += ESM::Land::LAND_SIZE-1;
+            }
+
+            return getNormal (lands.get (cellX, cellY, ESM::Land::DATA_VNML), col, row);
+        }
+
+        Ogre::Vector3 averageNormal (const LandNeighbourhood& lands, int cellX, int cellY, int col, int row)
+        {
+            Ogre::Vector3 normal = fixNormal (lands, cellX, cellY, col+1, row)
+                + fixNormal (lands, cellX, cellY, col-1, row)
+                + fixNormal (lands, cellX, cellY, col, row+1)
+                + fixNormal (lands, cellX, cellY, col, row-1);
+            normal.normalise();
+            return normal;
+        }
+
+        Ogre::ColourValue fixColour (const LandNeighbourhood& lands, int cellX, int cellY, int col, int row)
+        {
+            if (col == ESM::Land::LAND_SIZE-1)
+            {
+                ++cellY;
+                col = 0;
+            }
+            if (row == ESM::Land::LAND_SIZE-1)
+            {
+                ++cellX;
+                row = 0;
+            }
+
+            return getColour (lands.get (cellX, cellY, ESM::Land::DATA_VCLR), col, row);
+        }
+
+        /// Stitching table for one cell.
+        ///
+        /// Normals and colours don't always connect seamlessly between cells, so those of the last
+        /// row and column are taken from the neighbouring cells instead. Some corner normals appear
+        /// to be complete garbage (z < 0), so they are averaged from the surrounding vertices.
+        struct CellBorder
+        {
+            Ogre::Vector3 mLastRowNormals[ESM::Land::LAND_SIZE]; // indexed by column
+            Ogre::Vector3 mLastColNormals[ESM::Land::LAND_SIZE]; // indexed by row
+            Ogre::ColourValue mLastRowColours[ESM::Land::LAND_SIZE]; // indexed by column
+            Ogre::ColourValue mLastColColours[ESM::Land::LAND_SIZE]; // indexed by row
+            Ogre::Vector3 mCornerNormals[2][2]; // [last column][last row]
+
+            /// Only the entries for the rows and columns in the given ranges are filled in.
+            CellBorder (const LandNeighbourhood& lands, int cellX, int cellY,
+                int rowStart, int rowEnd, int colStart, int colEnd, int increment)
+            {
+                const int last = ESM::Land::LAND_SIZE-1;
+
+                for (int col=colStart; col<colEnd; col += increment)
+                {
+                    mLastRowNormals[col] = fixNormal (lands, cellX, cellY, col, last);
+                    mLastRowColours[col] = fixColour (lands, cellX, cellY, col, last);
+                }
+
+                for (int row=rowStart; row<rowEnd; row += increment)
+                {
+                    mLastColNormals[row] = fixNormal (lands, cellX, cellY, last, row);
+                    mLastColColours[row] = fixColour (lands, cellX, cellY, last, row);
+                }
+
+                for (int col=0; col<2; ++col)
+                    for (int row=0; row<2; ++row)
+                        mCornerNormals[col][row] = averageNormal (lands, cellX, cellY, col*last, row*last);
+            }
+        };
+    }
+
+    Storage::Storage (size_t landCacheSize)
+        : mLandCache (landCacheSize)
+        , mColourType (Ogre::VertexElement::getBestColourVertexElementType())
+    {
+    }
+
+    boost::mutex& Storage::getLandLoadMutex()
+    {
+        return sLandLoadMutex;
+    }
+
+    LandCache::Ptr Storage::getLandObject (int cellX, int cellY, bool cache)
     {
+        LandCache::Ptr object;
+        if (mLandCache.search (cellX, cellY, object))
+            return object;
+
+        boost::mutex::scoped_lock lock (getLandLoadMutex());
+
+        // another thread may have loaded the cell while we were waiting
+        if (mLandCache.search (cellX, cellY, object))
+            return object;
+
         if (const ESM::Land *land = getLand (cellX, cellY))
-            return land->getLandData (flags);
+        {
+            const int flags = ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX;
+            if (const ESM::Land::LandData *data = land->getLandData (flags))
+                object.reset (new LandObject (*land, *data));
+        }
 
-        return 0;
+        if (cache)
+            mLandCache.insert (cellX, cellY, object);
+        return object;
     }
 
     bool Storage::getMinMaxHeights(float size, const Ogre::Vector2 &center, float &min, float &max)
@@ -44,7 +258,8 @@ namespace ESMTerrain
         int endRow = startRow + size * (ESM::Land::LAND_SIZE-1) + 1;
         int endColumn = startColumn + size * (ESM::Land::LAND_SIZE-1) + 1;
 
-        if (const ESM::Land::LandData *data = getLandData (cellX, cellY, ESM::Land::DATA_VHGT))
+        LandCache::Ptr land = getLandObject (cellX, cellY);
+        if (land && land->has (ESM::Land::DATA_VHGT))
         {
             min = std::numeric_limits<float>::max();
             max = -std::numeric_limits<float>::max();
@@ -52,7 +267,7 @@ namespace ESMTerrain
             {
                 for (int col=startColumn; col<endColumn; ++col)
                 {
-                    float h = data->mHeights[col*ESM::Land::LAND_SIZE+row];
+                    float h = land->mHeights[col*ESM::Land::LAND_SIZE+row];
                     if (h > max)
                         max = h;
                     if (h < min)
@@ -65,91 +280,19 @@ namespace ESMTerrain
         return false;
     }
 
-    void Storage::fixNormal (Ogre::Vector3& normal, int cellX, int cellY, int col, int row)
-    {
-        while (col >= ESM::Land::LAND_SIZE-1)
-        {
-            ++cellY;
-            col -= ESM::Land::LAND_SIZE-1;
-        }
-        while (row >= ESM::Land::LAND_SIZE-1)
-        {
-            ++cellX;
-            row -= ESM::Land::LAND_SIZE-1;
-        }
-        while (col < 0)
-        {
-            --cellY;
-            col += ESM::Land::LAND_SIZE-1;
-        }
-        while (row < 0)
-        {
-            --cellX;
-            row += ESM::Land::LAND_SIZE-1;
-        }
-
-        if (const ESM::Land::LandData *data = getLandData (cellX, cellY, ESM::Land::DATA_VNML))
-        {
-            normal.x = data->mNormals[col*ESM::Land::LAND_SIZE*3+row*3];
-            normal.y = data->mNormals[col*ESM::Land::LAND_SIZE*3+row*3+1];
-            normal.z = data->mNormals[col*ESM::Land::LAND_SIZE*3+row*3+2];
-            normal.normalise();
-        }
-        else
-            normal = Ogre::Vector3(0,0,1);
-    }
-
-    void Storage::averageNormal(Ogre::Vector3 &normal, int cellX, int cellY, int col, int row)
-    {
-        Ogre::Vector3 n1,n2,n3,n4;
-        fixNormal(n1, cellX, cellY, col+1, row);
-        fixNormal(n2, cellX, cellY, col-1, row);
-        fixNormal(n3, cellX, cellY, col, row+1);
-        fixNormal(n4, cellX, cellY, col, row-1);
-        normal = (n1+n2+n3+n4);
-        normal.normalise();
-    }
-
-    void Storage::fixColour (Ogre::ColourValue& color, int cellX, int cellY, int col, int row)
-    {
-        if (col == ESM::Land::LAND_SIZE-1)
-        {
-            ++cellY;
-            col = 0;
-        }
-        if (row == ESM::Land::LAND_SIZE-1)
-        {
-            ++cellX;
-            row = 0;
-        }
-
-        if (const ESM::Land::LandData *data = getLandData (cellX, cellY, ESM::Land::DATA_VCLR))
-        {
-            color.r = data->mColours[col*ESM::Land::LAND_SIZE*3+row*3] / 255.f;
-            color.g = data->mColours[col*ESM::Land::LAND_SIZE*3+row*3+1] / 255.f;
-            color.b = data->mColours[col*ESM::Land::LAND_SIZE*3+row*3+2] / 255.f;
-        }
-        else
-        {
-            color.r = 1;
-            color.g = 1;
-            color.b = 1;
-        }
-
-    }
-
     void Storage::fillVertexBuffers (int lodLevel, float size, const Ogre::Vector2& center, Terrain::Alignment align,
                                             std::vector<float>& positions,
                                             std::vector<float>& normals,
                                             std::vector<Ogre::uint8>& colours)
     {
         // LOD level n means every 2^n-th vertex is kept
-        size_t increment = 1 << lodLevel;
+        int increment = 1 << lodLevel;
 
         Ogre::Vector2 origin = center - Ogre::Vector2(size/2.f, size/2.f);
 
         int startCellX = static_cast<int>(std::floor(origin.x));
         int startCellY = static_cast<int>(std::floor(origin.y));
+        int cellCount = static_cast<int>(std::ceil(size));
 
         size_t numVerts = static_cast<size_t>(size*(ESM::Land::LAND_SIZE - 1) / increment + 1);
 
@@ -157,106 +300,110 @@ namespace ESMTerrain
         normals.resize(numVerts*numVerts*3);
         colours.resize(numVerts*numVerts*4);
 
-        Ogre::Vector3 normal;
-        Ogre::ColourValue color;
+        // The cells of the chunk plus their neighbours, which are needed for stitching the borders
+        LandNeighbourhood lands (*this, mLandCache.getCapacity(), startCellX-1, startCellY-1, cellCount+2, cellCount+2);
 
-        float vertY = 0;
-        float vertX = 0;
+        const float scale = size * 8192;
 
-        float vertY_ = 0; // of current cell corner
-        for (int cellY = startCellY; cellY < startCellY + std::ceil(size); ++cellY)
+        size_t vertY = 0;
+        size_t vertY_ = 0; // of current cell corner
+        size_t vertX_ = 0; // of current cell corner
+        for (int cellY = startCellY; cellY < startCellY + cellCount; ++cellY)
         {
-            float vertX_ = 0; // of current cell corner
-            for (int cellX = startCellX; cellX < startCellX + std::ceil(size); ++cellX)
+            if (cellY != startCellY)
+                lands.advance();
+
+            vertX_ = 0;
+            for (int cellX = startCellX; cellX < startCellX + cellCount; ++cellX)
             {
-                const ESM::Land::LandData *heightData = getLandData (cellX, cellY, ESM::Land::DATA_VHGT);
-                const ESM::Land::LandData *normalData = getLandData (cellX, cellY, ESM::Land::DATA_VNML);
-                const ESM::Land::LandData *colourData = getLandData (cellX, cellY, ESM::Land::DATA_VCLR);
+                const LandObject *heightData = lands.get (cellX, cellY, ESM::Land::DATA_VHGT);
+                const LandObject *normalData = lands.get (cellX, cellY, ESM::Land::DATA_VNML);
+                const LandObject *colourData = lands.get (cellX, cellY, ESM::Land::DATA_VCLR);
 
                 int rowStart = 0;
                 int colStart = 0;
                 // Skip the first row / column unless we're at a chunk edge,
                 // since this row / column is already contained in a previous cell
                 // This is only relevant if we're creating a chunk spanning multiple cells
-                if (colStart == 0 && vertY_ != 0)
+                if (vertY_ != 0)
                     colStart += increment;
-                if (rowStart == 0 && vertX_ != 0)
+                if (vertX_ != 0)
                     rowStart += increment;
 
                 // Only relevant for chunks smaller than (contained in) one cell
                 rowStart += (origin.x - startCellX) * ESM::Land::LAND_SIZE;
                 colStart += (origin.y - startCellY) * ESM::Land::LAND_SIZE;
-                int rowEnd = rowStart + std::min(1.f, size) * (ESM::Land::LAND_SIZE-1) + 1;
-                int colEnd = colStart + std::min(1.f, size) * (ESM::Land::LAND_SIZE-1) + 1;
+                // The first row / column may have been skipped, so don't run past the end of the cell
+                int rowEnd = std::min(static_cast<int>(rowStart + std::min(1.f, size) * (ESM::Land::LAND_SIZE-1) + 1),
+                                      static_cast<int>(ESM::Land::LAND_SIZE));
+                int colEnd = std::min(static_cast<int>(colStart + std::min(1.f, size) * (ESM::Land::LAND_SIZE-1) + 1),
+                                      static_cast<int>(ESM::Land::LAND_SIZE));
+
+                assert(rowStart >= 0 && rowEnd <= ESM::Land::LAND_SIZE);
+                assert(colStart >= 0 && colEnd <= ESM::Land::LAND_SIZE);
 
+                const CellBorder border (lands, cellX, cellY, rowStart, rowEnd, colStart, colEnd, increment);
+
+                size_t vertX = vertX_;
                 vertY = vertY_;
                 for (int col=colStart; col<colEnd; col += increment)
                 {
+                    assert (vertY < numVerts);
+
+                    // Vertices of one row of the cell; consecutive vertices are numVerts apart in the buffers
+                    const size_t first = vertX_*numVerts + vertY;
+
+                    // positions
+                    const float y = (vertY / float(numVerts - 1) - 0.5f) * scale;
                     vertX = vertX_;
-                    for (int row=rowStart; row<rowEnd; row += increment)
+                    for (int row=rowStart; row<rowEnd; row += increment, ++vertX)
                     {
-                        positions[static_cast<unsigned int>(vertX*numVerts * 3 + vertY * 3)] = ((vertX / float(numVerts - 1) - 0.5f) * size * 8192);
-                        positions[static_cast<unsigned int>(vertX*numVerts * 3 + vertY * 3 + 1)] = ((vertY / float(numVerts - 1) - 0.5f) * size * 8192);
-
-                        assert(row >= 0 && row < ESM::Land::LAND_SIZE);
-                        assert(col >= 0 && col < ESM::Land::LAND_SIZE);
-
-                        assert (vertX < numVerts);
-                        assert (vertY < numVerts);
-
-                        float height = -2048;
-                        if (heightData)
-                            height = heightData->mHeights[col*ESM::Land::LAND_SIZE + row];
-                        positions[static_cast<unsigned int>(vertX*numVerts * 3 + vertY * 3 + 2)] = height;
-
-                        if (normalData)
-                        {
-                            normal.x = normalData->mNormals[col*ESM::Land::LAND_SIZE*3+row*3];
-                            normal.y = normalData->mNormals[col*ESM::Land::LAND_SIZE*3+row*3+1];
-                            normal.z = normalData->mNormals[col*ESM::Land::LAND_SIZE*3+row*3+2];
-                            normal.normalise();
-                        }
-                        else
-                            normal = Ogre::Vector3(0,0,1);
+                        float* position = &positions[(vertX*numVerts + vertY) * 3];
+                        position[0] = (vertX / float(numVerts - 1) - 0.5f) * scale;
+                        position[1] = y;
+                        position[2] = heightData ? heightData->mHeights[col*ESM::Land::LAND_SIZE + row] : -2048;
+                    }
 
-                        // Normals apparently don't connect seamlessly between cells
-                        if (col == ESM::Land::LAND_SIZE-1 || row == ESM::Land::LAND_SIZE-1)
-                            fixNormal(normal, cellX, cellY, col, row);
+                    assert (vertX <= numVerts);
 
-                        // some corner normals appear to be complete garbage (z < 0)
-                        if ((row == 0 || row == ESM::Land::LAND_SIZE-1) && (col == 0 || col == ESM::Land::LAND_SIZE-1))
-                            averageNormal(normal, cellX, cellY, col, row);
+                    // normals and colours; the last row and column come from the neighbouring cells
+                    const bool lastCol = col == ESM::Land::LAND_SIZE-1;
+                    const bool cornerCol = col == 0 || lastCol;
+
+                    size_t vertex = first;
+                    for (int row=rowStart; row<rowEnd; row += increment, vertex += numVerts)
+                    {
+                        const bool lastRow = row == ESM::Land::LAND_SIZE-1;
+
+                        Ogre::Vector3 normal;
+                        Ogre::ColourValue color;
+
+                        if (cornerCol && (row == 0 || lastRow))
+                            normal = border.mCornerNormals[lastCol][lastRow];
+                        else if (lastCol)
+                            normal = border.mLastColNormals[row];
+                        else if (lastRow)
+                            normal = border.mLastRowNormals[col];
+                        else
+                            normal = getNormal (normalData, col, row);
 
                         assert(normal.z > 0);
 
-                        normals[static_cast<unsigned int>(vertX*numVerts * 3 + vertY * 3)] = normal.x;
-                        normals[static_cast<unsigned int>(vertX*numVerts * 3 + vertY * 3 + 1)] = normal.y;
-                        normals[static_cast<unsigned int>(vertX*numVerts * 3 + vertY * 3 + 2)] = normal.z;
+                        normals[vertex*3] = normal.x;
+                        normals[vertex*3+1] = normal.y;
+                        normals[vertex*3+2] = normal.z;
 
-                        if (colourData)
-                        {
-                            color.r = colourData->mColours[col*ESM::Land::LAND_SIZE*3+row*3] / 255.f;
-                            color.g = colourData->mColours[col*ESM::Land::LAND_SIZE*3+row*3+1] / 255.f;
-                            color.b = colourData->mColours[col*ESM::Land::LAND_SIZE*3+row*3+2] / 255.f;
-                        }
+                        if (lastCol)
+                            color = border.mLastColColours[row];
+                        else if (lastRow)
+                            color = border.mLastRowColours[col];
                         else
-                        {
-                            color.r = 1;
-                            color.g = 1;
-                            color.b = 1;
-                        }
-
-                        // Unlike normals, colors mostly connect seamlessly between cells, but not always...
-                        if (col == ESM::Land::LAND_SIZE-1 || row == ESM::Land::LAND_SIZE-1)
-                            fixColour(color, cellX, cellY, col, row);
-
-                        color.a = 1;
-                        Ogre::uint32 rsColor;
-                        Ogre::Root::getSingleton().getRenderSystem()->convertColourValue(color, &rsColor);
-                        memcpy(&colours[static_cast<unsigned int>(vertX*numVerts * 4 + vertY * 4)], &rsColor, sizeof(Ogre::uint32));
-
-                        ++vertX;
+                            color = getColour (colourData, col, row);
+
+                        Ogre::uint32 rsColor = Ogre::VertexElement::convertColourValue(color, mColourType);
+                        memcpy(&colours[vertex*4], &rsColor, sizeof(Ogre::uint32));
                     }
+
                     ++vertY;
                 }
                 vertX_ = vertX;
@@ -288,12 +435,13 @@ namespace ESMTerrain
         assert(x<ESM::Land::LAND_TEXTURE_SIZE);
         assert(y<ESM::Land::LAND_TEXTURE_SIZE);
 
-        if (const ESM::Land::LandData *data = getLandData (cellX, cellY, ESM::Land::DATA_VTEX))
+        LandCache::Ptr land = getLandObject (cellX, cellY);
+        if (land && land->has (ESM::Land::DATA_VTEX))
         {
-            int tex = data->mTextures[y * ESM::Land::LAND_TEXTURE_SIZE + x];
+            int tex = land->mTextures[y * ESM::Land::LAND_TEXTURE_SIZE + x];
             if (tex == 0)
                 return std::make_pair(0,0); // vtex 0 is always the base texture, regardless of plugin
-            return std::make_pair(tex, getLand (cellX, cellY)->mPlugin);
+            return std::make_pair(tex, land->mPlugin);
         }
         else
             return std::make_pair(0,0);
@@ -319,24 +467,66 @@ namespace ESMTerrain
         return texture;
     }
 
+    void Storage::setTextureCache (Terrain::TextureCache* cache)
+    {
+        mTextureCache.reset (cache);
+    }
+
+    Terrain::TextureCache* Storage::getTextureCache()
+    {
+        return mTextureCache.get();
+    }
+
     void Storage::getBlendmaps (const std::vector<Terrain::QuadTreeNode*>& nodes, std::vector<Terrain::LayerCollection>& out, bool pack)
     {
         for (std::vector<Terrain::QuadTreeNode*>::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
         {
             out.push_back(Terrain::LayerCollection());
             out.back().mTarget = *it;
-            getBlendmapsImpl(static_cast<float>((*it)->getSize()), (*it)->getCenter(), pack, out.back().mBlendmaps, out.back().mLayers);
+            getBlendmapsImpl(static_cast<float>((*it)->getSize()), (*it)->getCenter(), pack, out.back().mBlendmaps, out.back().mLayers,
+                             out.back().mHash);
         }
     }
 
     void Storage::getBlendmaps(float chunkSize, const Ogre::Vector2 &chunkCenter,
         bool pack, std::vector<Ogre::PixelBox> &blendmaps, std::vector<Terrain::LayerInfo> &layerList)
     {
-        getBlendmapsImpl(chunkSize, chunkCenter, pack, blendmaps, layerList);
+        boost::uint64_t hash;
+        getBlendmapsImpl(chunkSize, chunkCenter, pack, blendmaps, layerList, hash);
+    }
+
+    void Storage::hashBlendmapSource (float chunkSize, const Ogre::Vector2& chunkCenter, bool pack,
+        Terrain::TextureHash& hash)
+    {
+        hash.add (std::string ("blendmap"));
+        hash.add (static_cast<int> (pack));
+        hash.add (chunkSize);
+        hash.add (chunkCenter.x);
+        hash.add (chunkCenter.y);
+
+        Ogre::Vector2 origin = chunkCenter - Ogre::Vector2(chunkSize/2.f, chunkSize/2.f);
+        int cellX = static_cast<int>(std::floor(origin.x));
+        int cellY = static_cast<int>(std::floor(origin.y));
+
+        // The texels at the borders are taken from the neighbour cells to the left and to the top,
+        // see getVtexIndexAt
+        for (int y=cellY; y<=cellY+1; ++y)
+            for (int x=cellX-1; x<=cellX; ++x)
+            {
+                LandCache::Ptr land = getLandObject (x, y);
+                if (land && land->has (ESM::Land::DATA_VTEX))
+                {
+                    hash.add (land->mPlugin);
+                    hash.add (land->mTextures, sizeof (land->mTextures));
+                }
+                else
+                    hash.add (-1);
+            }
     }
 
     void Storage::getBlendmapsImpl(float chunkSize, const Ogre::Vector2 &chunkCenter,
-        bool pack, std::vector<Ogre::PixelBox> &blendmaps, std::vector<Terrain::LayerInfo> &layerList)
+        bool pack, std::vector<Ogre::PixelBox> &blendmaps, std::vector<Terrain::LayerInfo> &layerList,
+        boost::uint64_t& hash)
     {
         // TODO - blending isn't completely right yet; the blending radius appears to be
         // different at a cell transition (2 vertices, not 4), so we may need to create a larger blendmap
@@ -357,49 +547,86 @@ namespace ESMTerrain
         assert (rowEnd <= realTextureSize);
         assert (colEnd <= realTextureSize);
 
-        // Save the used texture indices so we know the total number of textures
-        // and number of required blend maps
-        std::set<UniqueTextureId> textureIndices;
-        // Due to the way the blending works, the base layer will always shine through in between
-        // blend transitions (eg halfway between two texels, both blend values will be 0.5, so 25% of base layer visible).
-        // To get a consistent look, we need to make sure to use the same base layer in all cells.
-        // So we're always adding _land_default.dds as the base layer here, even if it's not referenced in this cell.
-        textureIndices.insert(std::make_pair(0,0));
-
-        for (int y=colStart; y<colEnd; ++y)
-            for (int x=rowStart; x<rowEnd; ++x)
-            {
-                UniqueTextureId id = getVtexIndexAt(cellX, cellY, x, y);
-                textureIndices.insert(id);
-            }
+        int channels = pack ? 4 : 1;
+        Ogre::PixelFormat format = pack ? Ogre::PF_A8B8G8R8 : Ogre::PF_A8;
+
+        const int blendmapSize = (realTextureSize-1) * chunkSize + 1;
+        const size_t blendmapBytes = blendmapSize*blendmapSize*channels;
+
+        // Texture indices used by the chunk, in splatting order
+        std::vector<UniqueTextureId> textures;
+        // Pixel data of all blendmaps
+        std::vector<char> blendmapData;
+
+        Terrain::TextureHash sourceHash;
+        bool cached = false;
 
-        // Makes sure the indices are sorted, or rather,
-        // retrieved as sorted. This is important to keep the splatting order
-        // consistent across cells.
-        std::map<UniqueTextureId, int> textureIndicesMap;
-        for (std::set<UniqueTextureId>::iterator it = textureIndices.begin(); it != textureIndices.end(); ++it)
+        // Looked up once, the cache may be switched off while this chunk is loaded
+        Terrain::TextureCache* cache = getTextureCache();
+
+        if (cache)
         {
-            int size = textureIndicesMap.size();
-            textureIndicesMap[*it] = size;
-            layerList.push_back(getLayerInfo(getTextureName(*it)));
-        }
+            hashBlendmapSource (chunkSize, chunkCenter, pack, sourceHash);
 
-        int numTextures = textureIndices.size();
-        // numTextures-1 since the base layer doesn't need blending
-        int numBlendmaps = pack ? static_cast<int>(std::ceil((numTextures - 1) / 4.f)) : (numTextures - 1);
+            std::vector<char> entry;
+            if (cache->read (sourceHash.get(), entry))
+            {
+                size_t offset = 0;
+                int numTextures = 0;
+                if (readInt (entry, offset, numTextures) && numTextures>0)
+                {
+                    for (int i=0; i<numTextures; ++i)
+                    {
+                        int index = 0;
+                        int plugin = 0;
+                        if (!readInt (entry, offset, index) || !readInt (entry, offset, plugin))
+                            break;
+                        textures.push_back (std::make_pair (static_cast<short> (index), static_cast<short> (plugin)));
+                    }
 
-        int channels = pack ? 4 : 1;
+                    if (static_cast<int> (textures.size())==numTextures
+                        && entry.size()-offset==getBlendmapCount (numTextures, pack) * blendmapBytes)
+                    {
+                        blendmapData.assign (entry.begin()+offset, entry.end());
+                        cached = true;
+                    }
+                }
 
-        // Second iteration - create and fill in the blend maps
-        const int blendmapSize = (realTextureSize-1) * chunkSize + 1;
+                if (!cached)
+                    textures.clear();
+            }
+        }
 
-        for (int i=0; i<numBlendmaps; ++i)
+        if (!cached)
         {
-            Ogre::PixelFormat format = pack ? Ogre::PF_A8B8G8R8 : Ogre::PF_A8;
+            // Save the used texture indices so we know the total number of textures
+            // and number of required blend maps
+            std::set<UniqueTextureId> textureIndices;
+            // Due to the way the blending works, the base layer will always shine through in between
+            // blend transitions (eg halfway between two texels, both blend values will be 0.5, so 25% of base layer visible).
+            // To get a consistent look, we need to make sure to use the same base layer in all cells.
+            // So we're always adding _land_default.dds as the base layer here, even if it's not referenced in this cell.
+            textureIndices.insert(std::make_pair(0,0));
+
+            for (int y=colStart; y<colEnd; ++y)
+                for (int x=rowStart; x<rowEnd; ++x)
+                {
+                    UniqueTextureId id = getVtexIndexAt(cellX, cellY, x, y);
+                    textureIndices.insert(id);
+                }
+
+            // Makes sure the indices are sorted, or rather,
+            // retrieved as sorted. This is important to keep the splatting order
+            // consistent across cells.
+            textures.assign (textureIndices.begin(), textureIndices.end());
 
-            Ogre::uchar* pData =
-                            OGRE_ALLOC_T(Ogre::uchar, blendmapSize*blendmapSize*channels, Ogre::MEMCATEGORY_GENERAL);
-            memset(pData, 0, blendmapSize*blendmapSize*channels);
+            std::map<UniqueTextureId, int> textureIndicesMap;
+            for (size_t i=0; i<textures.size(); ++i)
+                textureIndicesMap[textures[i]] = i;
+
+            // Second iteration - fill in the blend maps. Each texel is only set in the blendmap of its
+            // own layer; the base layer doesn't need blending.
+            blendmapData.resize (getBlendmapCount (textures.size(), pack) * blendmapBytes, 0);
 
             for (int y=0; y<blendmapSize; ++y)
             {
@@ -408,17 +635,57 @@ namespace ESMTerrain
                     UniqueTextureId id = getVtexIndexAt(cellX, cellY, x+rowStart, y+colStart);
                     assert(textureIndicesMap.find(id) != textureIndicesMap.end());
                     int layerIndex = textureIndicesMap.find(id)->second;
-                    int blendIndex = (pack ? static_cast<int>(std::floor((layerIndex - 1) / 4.f)) : layerIndex - 1);
-                    int channel = pack ? std::max(0, (layerIndex-1) % 4) : 0;
 
-                    if (blendIndex == i)
-                        pData[y*blendmapSize*channels + x*channels + channel] = 255;
-                    else
-                        pData[y*blendmapSize*channels + x*channels + channel] = 0;
+                    if (layerIndex == 0)
+                        continue;
+
+                    int blendIndex = pack ? (layerIndex - 1) / 4 : layerIndex - 1;
+                    int channel = pack ? (layerIndex - 1) % 4 : 0;
+
+                    blendmapData[blendIndex*blendmapBytes + y*blendmapSize*channels + x*channels + channel] =
+                        static_cast<char>(255);
                 }
             }
+
+            if (cache)
+            {
+                std::vector<char> entry;
+                writeInt (entry, static_cast<int> (textures.size()));
+                for (std::vector<UniqueTextureId>::const_iterator it = textures.begin(); it != textures.end(); ++it)
+                {
+                    writeInt (entry, it->first);
+                    writeInt (entry, it->second);
+                }
+                entry.insert (entry.end(), blendmapData.begin(), blendmapData.end());
+
+                cache->write (sourceHash.get(), entry);
+            }
+        }
+
+        for (size_t i=0; i<blendmapData.size(); i+=blendmapBytes)
+        {
+            Ogre::uchar* pData = OGRE_ALLOC_T(Ogre::uchar, blendmapBytes, Ogre::MEMCATEGORY_GENERAL);
+            memcpy(pData, &blendmapData[i], blendmapBytes);
             blendmaps.push_back(Ogre::PixelBox(blendmapSize, blendmapSize, 1, format, pData));
         }
+
+        // Land texture records are not part of the cached data, so that the layers always use the
+        // current textures
+        Terrain::TextureHash layerHash;
+        layerHash.add (sourceHash.get());
+
+        for (std::vector<UniqueTextureId>::const_iterator it = textures.begin(); it != textures.end(); ++it)
+        {
+            layerList.push_back(mLayerInfoCache.get(getTextureName(*it)));
+
+            const Terrain::LayerInfo& layer = layerList.back();
+            layerHash.add (layer.mDiffuseMap);
+            layerHash.add (layer.mNormalMap);
+            layerHash.add (static_cast<int> (layer.mParallax));
+            layerHash.add (static_cast<int> (layer.mSpecular));
+        }
+
+        hash = cache ? layerHash.get() : 0;
     }
 
     float Storage::getHeightAt(const Ogre::Vector3 &worldPos)
@@ -426,8 +693,8 @@ namespace ESMTerrain
         int cellX = static_cast<int>(std::floor(worldPos.x / 8192.f));
         int cellY = static_cast<int>(std::floor(worldPos.y / 8192.f));
 
-        const ESM::Land* land = getLand(cellX, cellY);
-        if (!land || !(land->mDataTypes&ESM::Land::DATA_VHGT))
+        LandCache::Ptr land = getLandObject(cellX, cellY);
+        if (!land || !land->has(ESM::Land::DATA_VHGT))
             return -2048;
 
         // Mostly lifted from Ogre::Terrain::getHeightAtTerrainPosition
@@ -466,10 +733,10 @@ namespace ESMTerrain
         */
 
         // Build all 4 positions in normalized cell space, using point-sampled height
-        Ogre::Vector3 v0 (startXTS, startYTS, getVertexHeight(land, startX, startY) / 8192.f);
-        Ogre::Vector3 v1 (endXTS, startYTS, getVertexHeight(land, endX, startY) / 8192.f);
-        Ogre::Vector3 v2 (endXTS, endYTS, getVertexHeight(land, endX, endY) / 8192.f);
-        Ogre::Vector3 v3 (startXTS, endYTS, getVertexHeight(land, startX, endY) / 8192.f);
+        Ogre::Vector3 v0 (startXTS, startYTS, getVertexHeight(*land, startX, startY) / 8192.f);
+        Ogre::Vector3 v1 (endXTS, startYTS, getVertexHeight(*land, endX, startY) / 8192.f);
+        Ogre::Vector3 v2 (endXTS, endYTS, getVertexHeight(*land, endX, endY) / 8192.f);
+        Ogre::Vector3 v3 (startXTS, endYTS, getVertexHeight(*land, startX, endY) / 8192.f);
         // define this plane in terrain space
         Ogre::Plane plane;
         // (At the moment, all rows have the same triangle alignment)
@@ -499,57 +766,11 @@ namespace ESMTerrain
 
     }
 
-    float Storage::getVertexHeight(const ESM::Land *land, int x, int y)
+    float Storage::getVertexHeight(const LandObject& land, int x, int y)
     {
         assert(x < ESM::Land::LAND_SIZE);
         assert(y < ESM::Land::LAND_SIZE);
-        return land->getLandData()->mHeights[y * ESM::Land::LAND_SIZE + x];
-    }
-
-    Terrain::LayerInfo Storage::getLayerInfo(const std::string& texture)
-    {
-        // Already have this cached?
-        std::map<std::string, Terrain::LayerInfo>::iterator found = mLayerInfoMap.find(texture);
-        if (found != mLayerInfoMap.end())
-            return found->second;
-
-        Terrain::LayerInfo info;
-        info.mParallax = false;
-        info.mSpecular = false;
-        info.mDiffuseMap = texture;
-        std::string texture_ = texture;
-        boost::replace_last(texture_, ".", "_nh.");
-
-        if (Ogre::ResourceGroupManager::getSingleton().resourceExistsInAnyGroup(texture_))
-        {
-            info.mNormalMap = texture_;
-            info.mParallax = true;
-        }
-        else
-        {
-            texture_ = texture;
-            boost::replace_last(texture_, ".", "_n.");
-            if (Ogre::ResourceGroupManager::getSingleton().resourceExistsInAnyGroup(texture_))
-                info.mNormalMap = texture_;
-        }
-
-        texture_ = texture;
-        boost::replace_last(texture_, ".", "_diffusespec.");
-        if (Ogre::ResourceGroupManager::getSingleton().resourceExistsInAnyGroup(texture_))
-        {
-            info.mDiffuseMap = texture_;
-            info.mSpecular = true;
-        }
-
-        // This wasn't cached, so the textures are probably not loaded either.
-        // Background load them so they are hopefully already loaded once we need them!
-        Ogre::ResourceBackgroundQueue::getSingleton().load("Texture", info.mDiffuseMap, "General");
-        if (!info.mNormalMap.empty())
-            Ogre::ResourceBackgroundQueue::getSingleton().load("Texture", info.mNormalMap, "General");
-
-        mLayerInfoMap[texture] = info;
-
-        return info;
+        return land.mHeights[y * ESM::Land::LAND_SIZE + x];
     }
 
     Terrain::LayerInfo Storage::getDefaultLayer()
@@ -1,11 +1,18 @@
 #ifndef COMPONENTS_ESM_TERRAIN_STORAGE_H
 #define COMPONENTS_ESM_TERRAIN_STORAGE_H
 
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
 #include <components/terrain/storage.hpp>
+#include <components/terrain/texturecache.hpp>
 
 #include <components/esm/loadland.hpp>
 #include <components/esm/loadltex.hpp>
 
+#include "landcache.hpp"
+#include "layerinfocache.hpp"
+
 namespace ESMTerrain
 {
 
@@ -16,15 +23,35 @@ namespace ESMTerrain
     private:
 
         // Not implemented in this class, because we need different Store implementations for game and editor
+        /// @note Only called with the land loading mutex locked, so implementations may load data on demand.
         virtual const ESM::Land* getLand (int cellX, int cellY)= 0;
         virtual const ESM::LandTexture* getLandTexture(int index, short plugin) = 0;
 
+    protected:
+
+        /// @param landCacheSize Maximum number of cells kept in the land cache
+        explicit Storage (size_t landCacheSize = 128);
+
     public:
 
-        /// Data is loaded first, if necessary. Will return a 0-pointer if there is no data for
-        /// any of the data types specified via \a flags. Will also return a 0-pointer if there
-        /// is no land record for the coordinates \a cellX / \a cellY.
-        const ESM::Land::LandData *getLandData (int cellX, int cellY, int flags);
+        /// Return the decoded land data of a cell, loading it first if necessary. Will return a
+        /// 0-pointer if there is no land record or no land data for the coordinates \a cellX / \a cellY.
+        /// @param cache Add the land data to the land cache if it had to be loaded? Reads of more cells
+        ///        than the cache holds would only evict the cells that are reused.
+        /// @note Thread-safe.
+        LandCache::Ptr getLandObject (int cellX, int cellY, bool cache = true);
+
+        /// Land records are read through shared ESM readers and buffers, so loading and unloading
+        /// land data (ESM::Land::loadData, getLandData, unloadData) must be serialised with the
+        /// terrain worker threads. Lock this mutex for it anywhere outside of the storage.
+        static boost::mutex& getLandLoadMutex();
+
+        /// Store generated blendmaps in \a cache and reuse them from there. Composite maps of the
+        /// terrain using this storage are cached as well. Must be set before the storage is used.
+        /// @note Takes ownership of \a cache.
+        void setTextureCache (Terrain::TextureCache* cache);
+
+        virtual Terrain::TextureCache* getTextureCache();
 
         // Not implemented in this class, because we need different Store implementations for game and editor
         /// Get bounds of the whole terrain in cell units
@@ -94,11 +121,7 @@ namespace ESMTerrain
         virtual int getCellVertices();
 
     private:
-        void fixNormal (Ogre::Vector3& normal, int cellX, int cellY, int col, int row);
-        void fixColour (Ogre::ColourValue& colour, int cellX, int cellY, int col, int row);
-        void averageNormal (Ogre::Vector3& normal, int cellX, int cellY, int col, int row);
-
-        float getVertexHeight (const ESM::Land* land, int x, int y);
+        float getVertexHeight (const LandObject& land, int x, int y);
 
         // Since plugins can define new texture palettes, we need to know the plugin index too
         // in order to retrieve the correct texture name.
@@ -109,14 +132,25 @@ namespace ESMTerrain
                                                int x, int y);
         std::string getTextureName (UniqueTextureId id);
 
-        std::map<std::string, Terrain::LayerInfo> mLayerInfoMap;
+        LandCache mLandCache;
+
+        // Format of the vertex colours, as expected by the render system
+        Ogre::VertexElementType mColourType;
 
-        Terrain::LayerInfo getLayerInfo(const std::string& texture);
+        LayerInfoCache mLayerInfoCache;
+
+        boost::scoped_ptr<Terrain::TextureCache> mTextureCache;
+
+        /// Add the data that the blendmaps of a terrain chunk depend on to \a hash
+        void hashBlendmapSource (float chunkSize, const Ogre::Vector2& chunkCenter, bool pack,
+                           Terrain::TextureHash& hash);
 
         // Non-virtual
+        /// @param hash See Terrain::LayerCollection::mHash
         void getBlendmapsImpl (float chunkSize, const Ogre::Vector2& chunkCenter, bool pack,
                            std::vector<Ogre::PixelBox>& blendmaps,
-                           std::vector<Terrain::LayerInfo>& layerList);
+                           std::vector<Terrain::LayerInfo>& layerList,
+                           boost::uint64_t& hash);
     };
 
 }
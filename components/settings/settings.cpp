@@ -1,6 +1,7 @@
 #include "settings.hpp"
 
 #include <stdexcept>
+#include <vector>
 
 #include <OgreString.h> // FIXME: workaround compilation error with OgreCommon.h included by OgreStringConverter.h
 #include <OgreStringConverter.h>
@@ -8,6 +9,7 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/atomic.hpp>
 
 namespace Settings
 {
@@ -16,6 +18,79 @@ CategorySettingValueMap Manager::mDefaultSettings = CategorySettingValueMap();
 CategorySettingValueMap Manager::mUserSettings = CategorySettingValueMap();
 CategorySettingVector Manager::mChangedSettings = CategorySettingVector();
 
+namespace
+{
+    struct KeyName
+    {
+        const char *mCategory;
+        const char *mSetting;
+    };
+
+    // in the same order as Key
+    const KeyName sKeyNames[Key_Count] =
+    {
+        { "Game", "best attack" },
+        { "Game", "difficulty" },
+        { "GUI", "hit fader" },
+        { "Cells", "exterior grid size" },
+        { "Objects", "use static geometry" },
+        { "Viewing distance", "viewing distance" },
+        { "Viewing distance", "fog start factor" },
+        { "Viewing distance", "fog end factor" },
+        { "Viewing distance", "small object size" },
+        { "Viewing distance", "small object distance" },
+        { "Viewing distance", "limit small object distance" },
+        { "Terrain", "texture cache" }
+    };
+
+    const Snapshot sEmptySnapshot;
+
+    boost::atomic<const Snapshot*> sCurrentSnapshot (&sEmptySnapshot);
+
+    // Replaced snapshots, only accessed from the main thread. Readers may still use the ones
+    // replaced during the current frame, so they are freed one frame later.
+    std::vector<const Snapshot*> sReplacedSnapshots;
+    std::vector<const Snapshot*> sExpiredSnapshots;
+}
+
+Snapshot::Snapshot()
+{
+    for (int i=0; i<Key_Count; ++i)
+    {
+        mValues[i].mInt = 0;
+        mValues[i].mFloat = 0;
+        mValues[i].mBool = false;
+        mValues[i].mPresent = false;
+    }
+}
+
+const Snapshot::Value& Snapshot::get (Key key) const
+{
+    const Value& value = mValues[key];
+
+    if (!value.mPresent)
+        throw std::runtime_error(std::string("Trying to retrieve a non-existing setting: ")
+                                 + sKeyNames[key].mSetting
+                                 + ".\nMake sure the settings-default.cfg file file was properly installed.");
+
+    return value;
+}
+
+int Snapshot::getInt (Key key) const
+{
+    return get (key).mInt;
+}
+
+float Snapshot::getFloat (Key key) const
+{
+    return get (key).mFloat;
+}
+
+bool Snapshot::getBool (Key key) const
+{
+    return get (key).mBool;
+}
+
 
 class SettingsFileParser
 {
@@ -103,12 +178,14 @@ void Manager::loadDefault(const std::string &file)
 {
     SettingsFileParser parser;
     parser.loadSettingsFile(file, mDefaultSettings);
+    publishSnapshot();
 }
 
 void Manager::loadUser(const std::string &file)
 {
     SettingsFileParser parser;
     parser.loadSettingsFile(file, mUserSettings);
+    publishSnapshot();
 }
 
 void Manager::saveUser(const std::string &file)
@@ -192,7 +269,50 @@ const CategorySettingVector Manager::apply()
 {
     CategorySettingVector vec = mChangedSettings;
     mChangedSettings.clear();
+    publishSnapshot();
     return vec;
 }
 
+const Snapshot& Manager::getSnapshot()
+{
+    return *sCurrentSnapshot.load (boost::memory_order_acquire);
+}
+
+void Manager::releaseSnapshots()
+{
+    for (std::vector<const Snapshot*>::const_iterator it = sExpiredSnapshots.begin(); it != sExpiredSnapshots.end(); ++it)
+        delete *it;
+
+    sExpiredSnapshots.swap (sReplacedSnapshots);
+    sReplacedSnapshots.clear();
+}
+
+void Manager::publishSnapshot()
+{
+    Snapshot* snapshot = new Snapshot;
+
+    for (int i=0; i<Key_Count; ++i)
+    {
+        CategorySettingValueMap::key_type key = std::make_pair(sKeyNames[i].mCategory, sKeyNames[i].mSetting);
+
+        CategorySettingValueMap::const_iterator it = mUserSettings.find(key);
+        if (it == mUserSettings.end())
+        {
+            it = mDefaultSettings.find(key);
+            if (it == mDefaultSettings.end())
+                continue;
+        }
+
+        Snapshot::Value& value = snapshot->mValues[i];
+        value.mInt = Ogre::StringConverter::parseInt(it->second);
+        value.mFloat = Ogre::StringConverter::parseReal(it->second);
+        value.mBool = Ogre::StringConverter::parseBool(it->second);
+        value.mPresent = true;
+    }
+
+    const Snapshot* replaced = sCurrentSnapshot.exchange (snapshot, boost::memory_order_acq_rel);
+    if (replaced != &sEmptySnapshot)
+        sReplacedSnapshots.push_back (replaced);
+}
+
 }
@@ -11,6 +11,55 @@ namespace Settings
     typedef std::set< std::pair<std::string, std::string> > CategorySettingVector;
     typedef std::map < CategorySetting, std::string > CategorySettingValueMap;
 
+    /// \brief Settings that are read often, e.g. every frame or from background threads
+    enum Key
+    {
+        Key_BestAttack,             // [Game] best attack
+        Key_Difficulty,             // [Game] difficulty
+        Key_HitFader,               // [GUI] hit fader
+        Key_ExteriorGridSize,       // [Cells] exterior grid size
+        Key_UseStaticGeometry,      // [Objects] use static geometry
+        Key_ViewingDistance,        // [Viewing distance] viewing distance
+        Key_FogStartFactor,         // [Viewing distance] fog start factor
+        Key_FogEndFactor,           // [Viewing distance] fog end factor
+        Key_SmallObjectSize,        // [Viewing distance] small object size
+        Key_SmallObjectDistance,    // [Viewing distance] small object distance
+        Key_LimitSmallObjectDistance, // [Viewing distance] limit small object distance
+        Key_TerrainTextureCache,    // [Terrain] texture cache
+
+        Key_Count
+    };
+
+    ///
+    /// \brief Immutable, pre-parsed values of the settings listed in Key
+    ///
+    /// Each value is parsed the same way Manager::getInt/getFloat/getBool would parse it.
+    class Snapshot
+    {
+    public:
+        Snapshot();
+        ///< All values are missing.
+
+        int getInt (Key key) const;
+        float getFloat (Key key) const;
+        bool getBool (Key key) const;
+
+    private:
+        friend class Manager;
+
+        struct Value
+        {
+            int mInt;
+            float mFloat;
+            bool mBool;
+            bool mPresent;
+        };
+
+        const Value& get (Key key) const;
+
+        Value mValues[Key_Count];
+    };
+
     ///
     /// \brief Settings management (can change during runtime)
     ///
@@ -34,6 +83,20 @@ namespace Settings
 
         static const CategorySettingVector apply();
         ///< returns the list of changed settings and then clears it
+        ///
+        /// \note Also publishes a new snapshot.
+
+        static const Snapshot& getSnapshot();
+        ///< Return the most recently published snapshot.
+        ///
+        /// Safe to call from any thread, does not lock. Snapshots are published when settings are
+        /// loaded and on apply(), so changes made with the set functions only show up here once
+        /// they are applied. A replaced snapshot is freed by the second releaseSnapshots() call
+        /// after it was replaced, so do not keep the reference beyond the current frame or task.
+
+        static void releaseSnapshots();
+        ///< Free the snapshots that were replaced before the previous call. Call once per frame
+        /// from the main thread.
 
         static int getInt (const std::string& setting, const std::string& category);
         static float getFloat (const std::string& setting, const std::string& category);
@@ -44,6 +107,10 @@ namespace Settings
         static void setFloat (const std::string& setting, const std::string& category, const float value);
         static void setString (const std::string& setting, const std::string& category, const std::string& value);
         static void setBool (const std::string& setting, const std::string& category, const bool value);
+
+    private:
+
+        static void publishSnapshot();
     };
 
 }
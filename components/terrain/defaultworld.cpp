@@ -228,6 +228,14 @@ namespace Terrain
         target->getBuffer()->blit(mCompositeMapRenderTexture->getBuffer());
     }
 
+    void DefaultWorld::readCompositeMap(std::vector<char>& data)
+    {
+        const size_t width = mCompositeMapRenderTexture->getWidth();
+        const size_t height = mCompositeMapRenderTexture->getHeight();
+        data.resize(width*height*4);
+        mCompositeMapRenderTarget->copyContentsToMemory(Ogre::PixelBox(width, height, 1, Ogre::PF_A8B8G8R8, &data[0]));
+    }
+
     void DefaultWorld::clearCompositeMapSceneManager()
     {
         mCompositeMapSceneMgr->destroyAllManualObjects();
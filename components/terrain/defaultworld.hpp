@@ -128,6 +128,8 @@ namespace Terrain
         // Delete all quads
         void clearCompositeMapSceneManager();
         void renderCompositeMap (Ogre::TexturePtr target);
+        /// Copy the composite map rendered last into \a data (PF_A8B8G8R8), reading it back from the render target.
+        void readCompositeMap (std::vector<char>& data);
 
         // Adds a WorkQueue request to load a chunk for this node in the background.
         void queueLoad (QuadTreeNode* node);
@@ -22,6 +22,8 @@
 #ifndef COMPONENTS_TERRAIN_DEFS_HPP
 #define COMPONENTS_TERRAIN_DEFS_HPP
 
+#include <boost/cstdint.hpp>
+
 namespace Terrain
 {
     class QuadTreeNode;
@@ -76,10 +78,15 @@ namespace Terrain
 
     struct LayerCollection
     {
+        LayerCollection() : mTarget(NULL), mHash(0) {}
+
         QuadTreeNode* mTarget;
         // Since we can't create a texture from a different thread, this only holds the raw texel data
         std::vector<Ogre::PixelBox> mBlendmaps;
         std::vector<LayerInfo> mLayers;
+        // Hash of the data the blendmaps and layers were generated from, used to key cached composite maps.
+        // 0 if unknown.
+        boost::uint64_t mHash;
     };
 }
 
@@ -26,12 +26,14 @@
 #include <OgreSceneNode.h>
 #include <OgreMaterialManager.h>
 #include <OgreTextureManager.h>
+#include <OgreHardwarePixelBuffer.h>
 
 #include "defaultworld.hpp"
 #include "chunk.hpp"
 #include "storage.hpp"
 #include "buffercache.hpp"
 #include "material.hpp"
+#include "texturecache.hpp"
 
 using namespace Terrain;
 
@@ -145,6 +147,7 @@ QuadTreeNode::QuadTreeNode(DefaultWorld* terrain, ChildDirection dir, float size
     , mParent(parent)
     , mChunk(NULL)
     , mTerrain(terrain)
+    , mLayerHash(0)
 {
     mBounds.setNull();
     for (int i=0; i<4; ++i)
@@ -502,6 +505,7 @@ void QuadTreeNode::loadLayers(const LayerCollection& collection)
 
     mMaterialGenerator->setLayerList(collection.mLayers);
     mMaterialGenerator->setBlendmapList(blendTextures);
+    mLayerHash = collection.mHash;
 }
 
 void QuadTreeNode::loadMaterials()
@@ -571,6 +575,29 @@ void QuadTreeNode::prepareForCompositeMap(Ogre::TRect<float> area)
     }
 }
 
+bool QuadTreeNode::hashCompositeMapSource(TextureHash& hash)
+{
+    if (mIsDummy)
+    {
+        hash.add(mTerrain->getStorage()->getDefaultLayer().mDiffuseMap);
+        return true;
+    }
+    if (mSize > 1)
+    {
+        assert(hasChildren());
+
+        for (int i=0; i<4; ++i)
+            if (!mChildren[i]->hashCompositeMapSource(hash))
+                return false;
+        return true;
+    }
+
+    if (!mLayerHash)
+        return false;
+    hash.add(mLayerHash);
+    return true;
+}
+
 void QuadTreeNode::ensureCompositeMap()
 {
     if (mCompositeMap)
@@ -585,6 +612,24 @@ void QuadTreeNode::ensureCompositeMap()
                 name.str(), Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
         Ogre::TEX_TYPE_2D, size, size, Ogre::MIP_DEFAULT, Ogre::PF_A8B8G8R8);
 
+    // Composite maps only depend on the layers of the leafs, so they can be reused from the texture cache
+    // of the storage as long as those did not change
+    TextureCache* cache = mTerrain->getStorage()->getTextureCache();
+    TextureHash hash;
+    hash.add(std::string("composite"));
+    hash.add(size);
+    hash.add(static_cast<int>(mTerrain->getShadersEnabled()));
+    if (cache && !hashCompositeMapSource(hash))
+        cache = NULL;
+
+    const size_t bytes = size*size*4;
+    std::vector<char> data;
+    if (cache && cache->read(hash.get(), data) && data.size() == bytes)
+    {
+        mCompositeMap->getBuffer()->blitFromMemory(Ogre::PixelBox(size, size, 1, Ogre::PF_A8B8G8R8, &data[0]));
+        return;
+    }
+
     // Create quads for each cell
     prepareForCompositeMap(Ogre::TRect<float>(0,0,1,1));
 
@@ -592,6 +637,13 @@ void QuadTreeNode::ensureCompositeMap()
 
     mTerrain->clearCompositeMapSceneManager();
 
+    // mCompositeMap is a static texture and can't be read back on every render system
+    if (cache)
+    {
+        mTerrain->readCompositeMap(data);
+        if (data.size() == bytes)
+            cache->write(hash.get(), data);
+    }
 }
 
 void QuadTreeNode::applyMaterials()
@@ -38,6 +38,7 @@ namespace Terrain
     class DefaultWorld;
     class Chunk;
     class MaterialGenerator;
+    class TextureHash;
     struct LoadResponseData;
 
     enum ChildDirection
@@ -146,6 +147,11 @@ namespace Terrain
         /// @param area area in image space to put the quad
         void prepareForCompositeMap(Ogre::TRect<float> area);
 
+        /// Add the layers that the composite map of this node would be rendered from to \a hash,
+        /// in the same order as prepareForCompositeMap.
+        /// @return false if the layers of some leaf are not known, i.e. the composite map can't be cached.
+        bool hashCompositeMapSource (TextureHash& hash);
+
         /// Create a chunk for this node from the given data.
         void load (const LoadResponseData& data);
         void unload(bool recursive=false);
@@ -181,6 +187,9 @@ namespace Terrain
 
         Ogre::TexturePtr mCompositeMap;
 
+        // See LayerCollection::mHash
+        boost::uint64_t mLayerHash;
+
         void ensureCompositeMap();
     };
 
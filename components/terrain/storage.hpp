@@ -28,6 +28,8 @@
 
 namespace Terrain
 {
+    class TextureCache;
+
     /// We keep storage of terrain data abstract here since we need different implementations for game and editor
     class Storage
     {
@@ -100,6 +102,10 @@ namespace Terrain
 
         /// Get the number of vertices on one side for each cell. Should be (power of two)+1
         virtual int getCellVertices() = 0;
+
+        /// Get the cache for generated terrain textures, or 0 if they should not be cached.
+        /// @note Storages that return a cache should also fill in LayerCollection::mHash.
+        virtual TextureCache* getTextureCache() { return 0; }
     };
 
 }
@@ -0,0 +1,228 @@
+#include "texturecache.hpp"
+
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+namespace
+{
+    const char sMagic[4] = { 'O', 'M', 'W', 'T' };
+
+    /// Increase whenever the format of the entries or the way any of the cached textures are
+    /// generated changes.
+    const boost::uint32_t sVersion = 1;
+
+    struct Header
+    {
+        char mMagic[4];
+        boost::uint32_t mVersion;
+        boost::uint64_t mKey;
+        boost::uint64_t mSize;
+    };
+}
+
+namespace Terrain
+{
+
+    TextureCache::TextureCache (const boost::filesystem::path& path, boost::uint64_t maxSize)
+        : mPath (path), mEnabled (true), mMaxSize (maxSize), mWriteCount (0), mUseCount (0), mSize (0)
+    {
+        try
+        {
+            if (!boost::filesystem::exists (mPath))
+                boost::filesystem::create_directories (mPath);
+            else
+            {
+                // entries are touched when they are read, so the oldest ones were used least recently
+                std::multimap<std::time_t, std::pair<std::string, boost::uint64_t> > files;
+
+                for (boost::filesystem::directory_iterator iter (mPath);
+                    iter!=boost::filesystem::directory_iterator(); ++iter)
+                {
+                    const boost::filesystem::path& file = iter->path();
+                    boost::system::error_code error;
+
+                    if (file.extension()==".tmp")
+                        boost::filesystem::remove (file, error); // left behind by an interrupted write
+                    else if (file.extension()==".bin")
+                    {
+                        std::time_t time = boost::filesystem::last_write_time (file, error);
+                        boost::uint64_t size = error ? 0 : boost::filesystem::file_size (file, error);
+
+                        if (!error)
+                            files.insert (std::make_pair (time, std::make_pair (file.filename().string(), size)));
+                    }
+                }
+
+                for (std::multimap<std::time_t, std::pair<std::string, boost::uint64_t> >::const_iterator
+                    iter (files.begin()); iter!=files.end(); ++iter)
+                {
+                    Entry& entry = mEntries[iter->second.first];
+                    entry.mSize = iter->second.second;
+                    entry.mLastUse = ++mUseCount;
+                    mSize += entry.mSize;
+                }
+
+                if (mSize>mMaxSize)
+                    evict();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to create terrain texture cache " << mPath.string() << ": " << e.what() << std::endl;
+            mEnabled = false;
+        }
+    }
+
+    boost::filesystem::path TextureCache::getPath (boost::uint64_t key) const
+    {
+        std::ostringstream name;
+        name << std::hex << std::setfill ('0') << std::setw (16) << key << ".bin";
+        return mPath / name.str();
+    }
+
+    bool TextureCache::read (boost::uint64_t key, std::vector<char>& data) const
+    {
+        if (!mEnabled)
+            return false;
+
+        boost::filesystem::path path = getPath (key);
+
+        boost::filesystem::ifstream stream (path, std::ios::binary);
+        if (!stream.is_open())
+            return false;
+
+        Header header;
+        if (!stream.read (reinterpret_cast<char*> (&header), sizeof (header)))
+            return false;
+
+        // entries from other versions or hash collisions of the file name are treated as missing
+        if (std::memcmp (header.mMagic, sMagic, sizeof (sMagic))!=0 || header.mVersion!=sVersion
+            || header.mKey!=key)
+            return false;
+
+        // don't trust the size stored in the entry, a truncated or damaged file could make it
+        // allocate an arbitrary amount of memory
+        boost::system::error_code error;
+        boost::uint64_t fileSize = boost::filesystem::file_size (path, error);
+        if (error || fileSize<sizeof (header) || header.mSize!=fileSize-sizeof (header))
+        {
+            stream.close();
+            remove (path);
+            return false;
+        }
+
+        data.resize (static_cast<size_t> (header.mSize));
+
+        if (!data.empty() && !stream.read (&data[0], data.size()))
+            return false;
+
+        {
+            boost::mutex::scoped_lock lock (mMutex);
+            Entries::iterator found = mEntries.find (path.filename().string());
+            if (found!=mEntries.end())
+                found->second.mLastUse = ++mUseCount;
+        }
+
+        stream.close();
+
+        // keep the order of use for later sessions
+        boost::filesystem::last_write_time (path, std::time (0), error);
+
+        return true;
+    }
+
+    void TextureCache::write (boost::uint64_t key, const std::vector<char>& data)
+    {
+        if (!mEnabled)
+            return;
+
+        boost::filesystem::path path = getPath (key);
+
+        // Write to a temporary file first, so that other threads never see an incomplete entry
+        boost::filesystem::path tempPath;
+        {
+            boost::mutex::scoped_lock lock (mMutex);
+            std::ostringstream extension;
+            extension << "." << mWriteCount++ << ".tmp";
+            tempPath = path.string() + extension.str();
+        }
+
+        Header header;
+        std::memcpy (header.mMagic, sMagic, sizeof (sMagic));
+        header.mVersion = sVersion;
+        header.mKey = key;
+        header.mSize = data.size();
+
+        try
+        {
+            {
+                boost::filesystem::ofstream stream (tempPath, std::ios::binary);
+                stream.write (reinterpret_cast<const char*> (&header), sizeof (header));
+                if (!data.empty())
+                    stream.write (&data[0], data.size());
+
+                if (!stream.good())
+                    throw std::runtime_error ("write failed");
+            }
+
+            boost::filesystem::rename (tempPath, path);
+
+            boost::mutex::scoped_lock lock (mMutex);
+
+            Entry& entry = mEntries[path.filename().string()];
+            mSize -= entry.mSize;
+            entry.mSize = sizeof (header) + data.size();
+            entry.mLastUse = ++mUseCount;
+            mSize += entry.mSize;
+
+            if (mSize>mMaxSize)
+                evict();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to write terrain texture cache entry " << path.string() << ": " << e.what() << std::endl;
+
+            boost::system::error_code error;
+            boost::filesystem::remove (tempPath, error);
+        }
+    }
+
+    void TextureCache::evict()
+    {
+        std::map<boost::uint64_t, Entries::iterator> byUse;
+        for (Entries::iterator iter (mEntries.begin()); iter!=mEntries.end(); ++iter)
+            byUse.insert (std::make_pair (iter->second.mLastUse, iter));
+
+        for (std::map<boost::uint64_t, Entries::iterator>::const_iterator iter (byUse.begin());
+            iter!=byUse.end() && mSize>mMaxSize/4*3; ++iter)
+        {
+            boost::system::error_code error;
+            boost::filesystem::remove (mPath / iter->second->first, error);
+
+            mSize -= iter->second->second.mSize;
+            mEntries.erase (iter->second);
+        }
+    }
+
+    void TextureCache::remove (const boost::filesystem::path& path) const
+    {
+        boost::system::error_code error;
+        boost::filesystem::remove (path, error);
+
+        boost::mutex::scoped_lock lock (mMutex);
+        Entries::iterator found = mEntries.find (path.filename().string());
+        if (found!=mEntries.end())
+        {
+            mSize -= found->second.mSize;
+            mEntries.erase (found);
+        }
+    }
+
+}
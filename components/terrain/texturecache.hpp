@@ -0,0 +1,97 @@
+#ifndef COMPONENTS_TERRAIN_TEXTURECACHE_H
+#define COMPONENTS_TERRAIN_TEXTURECACHE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace Terrain
+{
+
+    /// @brief 64-bit FNV-1a hash over everything a generated texture depends on, used as cache key.
+    class TextureHash
+    {
+    public:
+        TextureHash() : mHash (14695981039346656037ULL) {}
+
+        void add (const void* data, size_t size)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*> (data);
+            for (size_t i=0; i<size; ++i)
+            {
+                mHash ^= bytes[i];
+                mHash *= 1099511628211ULL;
+            }
+        }
+
+        void add (int value) { add (&value, sizeof (value)); }
+        void add (float value) { add (&value, sizeof (value)); }
+        void add (boost::uint64_t value) { add (&value, sizeof (value)); }
+
+        /// @note The terminating 0 is included, so that consecutive strings can't be confused.
+        void add (const std::string& value) { add (value.c_str(), value.size()+1); }
+
+        boost::uint64_t get() const { return mHash; }
+
+    private:
+        boost::uint64_t mHash;
+    };
+
+    /// @brief Generated terrain textures (blendmaps, composite maps), stored on disk so they can be reused
+    ///        in later sessions instead of being generated again.
+    /// @note Entries are stamped with a format version. Entries written by a different version are ignored
+    ///       and overwritten, so changing how textures are generated only requires bumping the version.
+    /// @note Once the entries exceed the size limit, the least recently used ones are deleted.
+    /// @note All functions are thread-safe.
+    class TextureCache
+    {
+    public:
+        /// @param path Directory to store the textures in. Will be created if it does not exist.
+        /// @param maxSize Size limit of all entries together, in bytes.
+        TextureCache (const boost::filesystem::path& path, boost::uint64_t maxSize);
+
+        /// @param data The cached data will be written here.
+        /// @return Was a valid entry found for \a key?
+        bool read (boost::uint64_t key, std::vector<char>& data) const;
+
+        /// Add or replace the entry for \a key. Failing to write the entry is not an error; it is
+        /// simply generated again next time.
+        void write (boost::uint64_t key, const std::vector<char>& data);
+
+    private:
+        struct Entry
+        {
+            boost::uint64_t mSize;
+            boost::uint64_t mLastUse;
+        };
+
+        typedef std::map<std::string, Entry> Entries; // by file name
+
+        boost::filesystem::path getPath (boost::uint64_t key) const;
+
+        /// Delete the least recently used entries, until the remaining ones take up no more than
+        /// 3/4 of the size limit, so that this is not necessary again on the next write.
+        /// @note mMutex must be locked.
+        void evict();
+
+        /// Delete a corrupt entry.
+        void remove (const boost::filesystem::path& path) const;
+
+        boost::filesystem::path mPath;
+        bool mEnabled;
+        boost::uint64_t mMaxSize;
+
+        mutable boost::mutex mMutex;
+        int mWriteCount;
+        mutable Entries mEntries;
+        mutable boost::uint64_t mUseCount;
+        mutable boost::uint64_t mSize;
+    };
+
+}
+
+#endif
@@ -2,9 +2,12 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <fstream>
+#include <algorithm>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include "Platform.hpp"
@@ -12,6 +15,33 @@
 #include "ShaderSet.hpp"
 #include "MaterialInstanceTextureUnit.hpp"
 
+namespace
+{
+	/// Read a source cache entry, which is only valid if it was generated from input with the same \a hash
+	bool readSourceCache (const std::string& file, size_t hash, std::string& source)
+	{
+		std::ifstream stream (file.c_str(), std::ios_base::in | std::ios_base::binary);
+		if (!stream.is_open())
+			return false;
+
+		std::string line;
+		if (!std::getline(stream, line) || line != boost::lexical_cast<std::string>(hash))
+			return false;
+
+		std::stringstream buffer;
+		buffer << stream.rdbuf();
+		source = buffer.str();
+		return true;
+	}
+
+	void writeSourceCache (const std::string& file, size_t hash, const std::string& source)
+	{
+		std::ofstream stream (file.c_str(), std::ios_base::out | std::ios_base::binary);
+		stream << hash << '\n';
+		stream.write(source.c_str(), source.size());
+	}
+}
+
 namespace sh
 {
 	Factory* Factory::sThis = 0;
@@ -33,10 +63,14 @@ namespace sh
 		, mShaderDebugOutputEnabled(false)
 		, mReadMicrocodeCache(false)
 		, mWriteMicrocodeCache(false)
-		, mReadSourceCache(false)
-		, mWriteSourceCache(false)
+		, mReadSourceCache(true)
+		, mWriteSourceCache(true)
+		, mPreprocessQueue(NULL)
+		, mIncludeHash(0)
 		, mCurrentConfiguration(NULL)
 		, mCurrentLodConfiguration(NULL)
+		, mCurrentConfigurationName("Default")
+		, mCurrentLodLevel(0)
 		, mCurrentLanguage(Language_None)
 		, mListener(NULL)
 		, mPlatform(platform)
@@ -78,6 +112,8 @@ namespace sh
 			mShadersLastModified.clear();
 		}
 
+		loadPermutations();
+
 		// load configurations
 		{
 			ScriptLoader shaderSetLoader(".configuration");
@@ -247,6 +283,11 @@ namespace sh
 
 	Factory::~Factory ()
 	{
+		delete mPreprocessQueue;
+
+		if (mWriteSourceCache)
+			savePermutations();
+
 		mShaderSets.clear();
 
 		if (mPlatform->supportsShaderSerialization () && mWriteMicrocodeCache)
@@ -485,6 +526,7 @@ namespace sh
 
 	void Factory::setActiveConfiguration (const std::string& configuration)
 	{
+		mCurrentConfigurationName = configuration;
 		if (configuration == "Default")
 			mCurrentConfiguration = 0;
 		else
@@ -496,6 +538,7 @@ namespace sh
 
 	void Factory::setActiveLodLevel (int level)
 	{
+		mCurrentLodLevel = level;
 		if (level == 0)
 			mCurrentLodConfiguration = 0;
 		else
@@ -678,6 +721,34 @@ namespace sh
 		notifyConfigurationChanged();
 
 		bool removeBinaryCache = false;
+
+		// included files are not tracked per shader, so any change to them invalidates all cached sources
+		mIncludeHash = 0;
+		try
+		{
+			std::vector<std::string> includes;
+			boost::filesystem::directory_iterator end;
+			for (boost::filesystem::directory_iterator it (mPlatform->getBasePath()); it != end; ++it)
+			{
+				if (boost::filesystem::is_regular_file(it->status()) && it->path().extension() == ".h")
+					includes.push_back(it->path().string());
+			}
+			std::sort(includes.begin(), includes.end());
+
+			for (std::vector<std::string>::const_iterator it = includes.begin(); it != includes.end(); ++it)
+			{
+				std::ifstream stream (it->c_str(), std::ios_base::in | std::ios_base::binary);
+				std::stringstream buffer;
+				buffer << stream.rdbuf();
+				boost::hash_combine(mIncludeHash, *it);
+				boost::hash_combine(mIncludeHash, buffer.str());
+			}
+		}
+		catch (std::exception& e)
+		{
+			std::cerr << "Failed to hash shader include files: " << e.what() << std::endl;
+		}
+
 		ScriptLoader shaderSetLoader(".shaderset");
 		ScriptLoader::loadAllFiles (&shaderSetLoader, mPlatform->getBasePath());
 		std::map <std::string, ScriptNode*> nodes = shaderSetLoader.getAllConfigScripts();
@@ -786,6 +857,181 @@ namespace sh
 			reloadShaders();
 	}
 
+	size_t Factory::hashPreprocessJob (const PreprocessJob& job) const
+	{
+		size_t seed = mIncludeHash;
+		boost::hash_combine(seed, job.mSource);
+		boost::hash_combine(seed, job.mBasePath);
+		boost::hash_combine(seed, static_cast<int>(job.mLanguage));
+		for (std::vector<std::string>::const_iterator it = job.mDefinitions.begin(); it != job.mDefinitions.end(); ++it)
+			boost::hash_combine(seed, *it);
+		return seed;
+	}
+
+	std::string Factory::getPreprocessedSource (const PreprocessJob& job)
+	{
+		std::string file = getCacheFolder() + "/" + job.mName;
+		std::string source;
+
+		if (mPreprocessQueue && mPreprocessQueue->take(job.mName, job.mHash, source))
+		{
+			// prewarmed because the cache entry was missing or outdated
+		}
+		else if (mReadSourceCache && readSourceCache(file, job.mHash, source))
+			return source;
+		else
+			source = ShaderInstance::generateSource(job);
+
+		if (mWriteSourceCache)
+			writeSourceCache(file, job.mHash, source);
+
+		return source;
+	}
+
+	void Factory::recordPermutation (const std::string& shaderSet, const std::string& instance, PropertySetGet* properties)
+	{
+		if (!mWriteSourceCache)
+			return;
+
+		ShaderPermutation permutation;
+		permutation.mShaderSet = shaderSet;
+		permutation.mConfiguration = mCurrentConfigurationName;
+		permutation.mLodLevel = mCurrentLodLevel;
+
+		// flatten the properties, so that parents and linked values don't need to be restored later
+		for (PropertySetGet* set = properties; set; set = set->getParent())
+		{
+			const PropertyMap& map = set->listProperties();
+			for (PropertyMap::const_iterator it = map.begin(); it != map.end(); ++it)
+			{
+				if (permutation.mProperties.find(it->first) == permutation.mProperties.end())
+					permutation.mProperties[it->first] =
+						retrieveValue<StringValue>(properties->getProperty(it->first), properties->getContext()).get();
+			}
+		}
+
+		mPermutations[instance] = permutation;
+	}
+
+	void Factory::loadPermutations ()
+	{
+		std::string file = mPlatform->getCacheFolder () + "/permutations.txt";
+
+		try
+		{
+			std::ifstream stream (file.c_str());
+			std::string instance;
+			while (std::getline(stream, instance))
+			{
+				ShaderPermutation permutation;
+				std::string line;
+
+				if (!std::getline(stream, permutation.mShaderSet) || !std::getline(stream, permutation.mConfiguration)
+						|| !std::getline(stream, line))
+					throw std::runtime_error("unexpected end of file");
+				permutation.mLodLevel = boost::lexical_cast<int>(line);
+
+				if (!std::getline(stream, line))
+					throw std::runtime_error("unexpected end of file");
+				int count = boost::lexical_cast<int>(line);
+
+				for (int i=0; i<count; ++i)
+				{
+					std::string name, value;
+					if (!std::getline(stream, name) || !std::getline(stream, value))
+						throw std::runtime_error("unexpected end of file");
+					permutation.mProperties[name] = value;
+				}
+
+				mPermutations[instance] = permutation;
+			}
+		}
+		catch (std::exception& e)
+		{
+			std::cerr << "Failed to load shader permutation index: " << e.what() << std::endl;
+			mPermutations.clear();
+		}
+	}
+
+	void Factory::savePermutations ()
+	{
+		std::ofstream stream (std::string(mPlatform->getCacheFolder () + "/permutations.txt").c_str());
+
+		for (ShaderPermutationMap::const_iterator it = mPermutations.begin(); it != mPermutations.end(); ++it)
+		{
+			// permutations of shader sets that were removed are of no use anymore
+			if (mShaderSets.find(it->second.mShaderSet) == mShaderSets.end())
+				continue;
+
+			bool multiline = it->first.find('\n') != std::string::npos;
+			for (std::map<std::string, std::string>::const_iterator prop = it->second.mProperties.begin();
+					prop != it->second.mProperties.end(); ++prop)
+				multiline = multiline || prop->first.find('\n') != std::string::npos || prop->second.find('\n') != std::string::npos;
+			if (multiline)
+				continue;
+
+			stream << it->first << '\n' << it->second.mShaderSet << '\n' << it->second.mConfiguration << '\n'
+				<< it->second.mLodLevel << '\n' << it->second.mProperties.size() << '\n';
+
+			for (std::map<std::string, std::string>::const_iterator prop = it->second.mProperties.begin();
+					prop != it->second.mProperties.end(); ++prop)
+				stream << prop->first << '\n' << prop->second << '\n';
+		}
+	}
+
+	void Factory::prewarmShaders ()
+	{
+		if (!mShadersEnabled || mPermutations.empty())
+			return;
+
+		if (!mPreprocessQueue)
+			mPreprocessQueue = new PreprocessQueue(&ShaderInstance::generateSource);
+
+		std::string configuration = mCurrentConfigurationName;
+		int lodLevel = mCurrentLodLevel;
+
+		for (ShaderPermutationMap::const_iterator it = mPermutations.begin(); it != mPermutations.end(); ++it)
+		{
+			const ShaderPermutation& permutation = it->second;
+
+			ShaderSetMap::iterator set = mShaderSets.find(permutation.mShaderSet);
+			if (set == mShaderSets.end())
+				continue;
+			if (permutation.mConfiguration != "Default" && mConfigurations.find(permutation.mConfiguration) == mConfigurations.end())
+				continue;
+			if (permutation.mLodLevel != 0 && mLodConfigurations.find(permutation.mLodLevel) == mLodConfigurations.end())
+				continue;
+
+			setActiveConfiguration(permutation.mConfiguration);
+			setActiveLodLevel(permutation.mLodLevel);
+
+			PropertySetGet properties;
+			for (std::map<std::string, std::string>::const_iterator prop = permutation.mProperties.begin();
+					prop != permutation.mProperties.end(); ++prop)
+				properties.setProperty(prop->first, makeProperty<StringValue>(new StringValue(prop->second)));
+
+			try
+			{
+				PreprocessJob job;
+				if (!set->second.createPreprocessJob(it->first, &properties, job))
+					continue;
+
+				std::string source;
+				if (mReadSourceCache && readSourceCache(getCacheFolder() + "/" + job.mName, job.mHash, source))
+					continue;
+
+				mPreprocessQueue->push(job);
+			}
+			catch (std::exception&)
+			{
+				// the permutation will simply be generated on demand
+			}
+		}
+
+		setActiveConfiguration(configuration);
+		setActiveLodLevel(lodLevel);
+	}
+
 	void Factory::logError(const std::string &msg)
 	{
 		mErrorLog << msg << '\n';
@@ -8,6 +8,7 @@
 #include "MaterialInstance.hpp"
 #include "ShaderSet.hpp"
 #include "Language.hpp"
+#include "PreprocessQueue.hpp"
 
 namespace sh
 {
@@ -33,6 +34,16 @@ namespace sh
 
 	typedef std::map<std::string, std::string> TextureAliasMap;
 
+	/// A shader permutation that was used, recorded so that it can be prepared in advance in the next session
+	struct ShaderPermutation
+	{
+		std::string mShaderSet;
+		std::string mConfiguration;
+		int mLodLevel;
+		std::map<std::string, std::string> mProperties; ///< all properties of the pass, serialized
+	};
+	typedef std::map<std::string, ShaderPermutation> ShaderPermutationMap; ///< by \a ShaderInstance name
+
 	/**
 	 * @brief
 	 * Allows you to be notified when a certain material was just created. Useful for changing material properties that you can't
@@ -120,11 +131,13 @@ namespace sh
 
 		/// Controls writing of generated shader source code to the cache folder, so that the
 		/// (rather expensive) preprocessing step can be skipped on the next run. See Factory::setReadSourceCache \n
-		/// \note The default is off (no cache writing)
+		/// The shader permutations that were used are recorded in the cache folder as well, see Factory::prewarmShaders
+		/// \note The default is on
 		void setWriteSourceCache(bool write) { mWriteSourceCache = write; }
 
 		/// Controls reading of generated shader sources from the cache folder
-		/// \note The default is off (no cache reading)
+		/// \note The default is on. Cached sources are validated with a hash of the shader source, the
+		/// material properties and the included files, so outdated sources are never used.
 		/// \note Even if microcode caching is enabled, generating (or caching) the source is still required due to the macros.
 		void setReadSourceCache(bool read) { mReadSourceCache = read; }
 
@@ -138,6 +151,13 @@ namespace sh
 		/// \note The default is off (no cache reading)
 		void setReadMicrocodeCache(bool read) { mReadMicrocodeCache = read; }
 
+		/// Starts preprocessing the shader permutations used in the previous session on worker threads, unless
+		/// their source is cached already. Creating the shaders for these permutations later on will only have
+		/// to wait for the result, instead of running the preprocessor on the spot. \n
+		/// Call this after loadAllFiles and after setting up the global settings, since permutations that
+		/// depend on different settings than the current ones are skipped.
+		void prewarmShaders ();
+
 		/// Lists all materials currently registered with the factory. Whether they are
 		/// loaded or not does not matter.
 		void listMaterials (std::vector<std::string>& out);
@@ -205,8 +225,17 @@ namespace sh
 		void removeTextureAliasInstances (TextureUnitState* t);
 
 		std::string getCacheFolder () { return mPlatform->getCacheFolder (); }
-		bool getReadSourceCache() { return mReadSourceCache; }
-		bool getWriteSourceCache() { return mWriteSourceCache; }
+
+		size_t hashPreprocessJob (const PreprocessJob& job) const;
+
+		/// Get the generated source for \a job, from the preprocess queue or the source cache if possible.
+		std::string getPreprocessedSource (const PreprocessJob& job);
+
+		/// Remember the properties a shader permutation was created with, see prewarmShaders
+		void recordPermutation (const std::string& shaderSet, const std::string& instance, PropertySetGet* properties);
+
+		void loadPermutations ();
+		void savePermutations ();
 	public:
 		bool getWriteMicrocodeCache() { return mWriteMicrocodeCache; } // Fixme
 
@@ -238,6 +267,10 @@ namespace sh
 		bool mWriteSourceCache;
 		std::stringstream mErrorLog;
 
+		PreprocessQueue* mPreprocessQueue; ///< created on demand by prewarmShaders
+		size_t mIncludeHash; ///< hash of the shader include files, see hashPreprocessJob
+		ShaderPermutationMap mPermutations;
+
 		MaterialMap mMaterials;
 		ShaderSetMap mShaderSets;
 		ConfigurationMap mConfigurations;
@@ -249,6 +282,8 @@ namespace sh
 
 		PropertySetGet* mCurrentConfiguration;
 		PropertySetGet* mCurrentLodConfiguration;
+		std::string mCurrentConfigurationName;
+		int mCurrentLodLevel;
 
 		TextureAliasMap mTextureAliases;
 
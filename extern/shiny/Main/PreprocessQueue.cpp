@@ -0,0 +1,125 @@
+#include "PreprocessQueue.hpp"
+
+#include <algorithm>
+
+#include <boost/bind.hpp>
+
+namespace sh
+{
+	PreprocessQueue::PreprocessQueue (PreprocessFunction function, int threads)
+		: mFunction(function)
+		, mShutdown(false)
+	{
+		if (threads <= 0)
+			threads = std::max(1, static_cast<int>(boost::thread::hardware_concurrency()) - 1);
+
+		for (int i=0; i<threads; ++i)
+			mThreads.create_thread(boost::bind(&PreprocessQueue::run, this));
+	}
+
+	PreprocessQueue::~PreprocessQueue()
+	{
+		{
+			boost::mutex::scoped_lock lock(mMutex);
+			mShutdown = true;
+			mJobs.clear();
+		}
+		mJobAvailable.notify_all();
+		mThreads.join_all();
+	}
+
+	void PreprocessQueue::push (const PreprocessJob& job)
+	{
+		{
+			boost::mutex::scoped_lock lock(mMutex);
+
+			std::map<std::string, Result>::iterator found = mResults.find(job.mName);
+			if (found != mResults.end() && found->second.mHash == job.mHash)
+				return;
+
+			Result result;
+			result.mHash = job.mHash;
+			result.mDone = false;
+			result.mSucceeded = false;
+			mResults[job.mName] = result;
+
+			mJobs.push_back(job);
+		}
+		mJobAvailable.notify_one();
+	}
+
+	bool PreprocessQueue::take (const std::string& name, size_t hash, std::string& result)
+	{
+		boost::mutex::scoped_lock lock(mMutex);
+
+		std::map<std::string, Result>::iterator found = mResults.find(name);
+		if (found == mResults.end() || found->second.mHash != hash)
+			return false;
+
+		if (!found->second.mDone)
+		{
+			// if nobody started on the job yet, do it right here instead of waiting for a worker
+			for (std::deque<PreprocessJob>::iterator it = mJobs.begin(); it != mJobs.end(); ++it)
+			{
+				if (it->mName == name)
+				{
+					mJobs.erase(it);
+					mResults.erase(found);
+					return false;
+				}
+			}
+
+			while (!found->second.mDone)
+				mJobDone.wait(lock);
+		}
+
+		bool succeeded = found->second.mSucceeded;
+		if (succeeded)
+			result.swap(found->second.mSource);
+		mResults.erase(found);
+		return succeeded;
+	}
+
+	void PreprocessQueue::run()
+	{
+		while (true)
+		{
+			PreprocessJob job;
+			{
+				boost::mutex::scoped_lock lock(mMutex);
+				while (mJobs.empty() && !mShutdown)
+					mJobAvailable.wait(lock);
+
+				if (mShutdown)
+					return;
+
+				job = mJobs.front();
+				mJobs.pop_front();
+			}
+
+			std::string source;
+			bool succeeded = true;
+			try
+			{
+				source = mFunction(job);
+			}
+			catch (...)
+			{
+				// the job is simply repeated on the main thread, which will report the error
+				succeeded = false;
+			}
+
+			{
+				boost::mutex::scoped_lock lock(mMutex);
+				std::map<std::string, Result>::iterator found = mResults.find(job.mName);
+				if (found != mResults.end() && found->second.mHash == job.mHash)
+				{
+					found->second.mDone = true;
+					found->second.mSucceeded = succeeded;
+					found->second.mSource.swap(source);
+				}
+			}
+			mJobDone.notify_all();
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#ifndef SH_PREPROCESSQUEUE_H
+#define SH_PREPROCESSQUEUE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include "Language.hpp"
+
+namespace sh
+{
+	/**
+	 * @brief Input for the expensive, platform independent part of generating the source of a shader permutation
+	 * (running the preprocessor and expanding the passthrough macros).
+	 */
+	struct PreprocessJob
+	{
+		std::string mName; ///< name of the \a ShaderInstance
+		std::string mSource; ///< source with all property and global setting macros already resolved
+		std::string mBasePath; ///< path to search for includes
+		std::vector<std::string> mDefinitions;
+		Language mLanguage;
+
+		size_t mHash;
+		///< hash of everything the result depends on (including the included files), used to
+		/// validate cached results
+	};
+
+	typedef std::string (*PreprocessFunction)(const PreprocessJob& job);
+
+	/**
+	 * @brief Runs \a PreprocessJob's on a pool of worker threads
+	 * @note The preprocess function must not access any shared state other than the file system.
+	 */
+	class PreprocessQueue
+	{
+	public:
+		/// @param threads number of worker threads, 0 to use one less than the number of cores
+		PreprocessQueue (PreprocessFunction function, int threads = 0);
+
+		~PreprocessQueue();
+		///< Discards any jobs that have not been started yet and waits for the running ones.
+
+		void push (const PreprocessJob& job);
+		///< @note Does nothing if a job of the same name and hash is queued already.
+
+		/// Retrieve the result of a job that was pushed earlier, waiting for it to finish if necessary. \n
+		/// The result is removed from the queue.
+		/// @return false if there is no job with this name and hash, or the job failed
+		bool take (const std::string& name, size_t hash, std::string& result);
+
+	private:
+		struct Result
+		{
+			size_t mHash;
+			bool mDone;
+			bool mSucceeded;
+			std::string mSource;
+		};
+
+		void run();
+
+		PreprocessFunction mFunction;
+
+		boost::mutex mMutex;
+		boost::condition_variable mJobAvailable;
+		boost::condition_variable mJobDone;
+
+		std::deque<PreprocessJob> mJobs;
+		std::map<std::string, Result> mResults; ///< results by job name (including those that are not done yet)
+
+		bool mShutdown;
+		boost::thread_group mThreads;
+	};
+}
+
+#endif
@@ -231,20 +231,20 @@ namespace sh
 				if (cmd == "shGlobalSettingBool")
 				{
 					std::string settingName = args[0];
-					std::string value = retrieveValue<StringValue>(mParent->getCurrentGlobalSettings()->getProperty(settingName), NULL).get();
+					std::string value = retrieveValue<StringValue>(Factory::getInstance().getCurrentGlobalSettings()->getProperty(settingName), NULL).get();
 					replaceValue = (value == "true" || value == "1") ? "1" : "0";
 				}
 				else if (cmd == "shGlobalSettingEqual")
 				{
 					std::string settingName = args[0];
 					std::string comparedAgainst = args[1];
-					std::string value = retrieveValue<StringValue>(mParent->getCurrentGlobalSettings()->getProperty(settingName), NULL).get();
+					std::string value = retrieveValue<StringValue>(Factory::getInstance().getCurrentGlobalSettings()->getProperty(settingName), NULL).get();
 					replaceValue = (value == comparedAgainst) ? "1" : "0";
 				}
 				else if (cmd == "shGlobalSettingString")
 				{
 					std::string settingName = args[0];
-					replaceValue = retrieveValue<StringValue>(mParent->getCurrentGlobalSettings()->getProperty(settingName), NULL).get();
+					replaceValue = retrieveValue<StringValue>(Factory::getInstance().getCurrentGlobalSettings()->getProperty(settingName), NULL).get();
 				}
 				else
 					throw std::runtime_error ("unknown command \"" + cmd + "\"");
@@ -328,208 +328,206 @@ namespace sh
 
 	}
 
-	ShaderInstance::ShaderInstance (ShaderSet* parent, const std::string& name, PropertySetGet* properties)
-		: mName(name)
-		, mParent(parent)
-		, mSupported(true)
-		, mCurrentPassthrough(0)
-		, mCurrentComponent(0)
+	PreprocessJob ShaderInstance::createPreprocessJob (ShaderSet* parent, const std::string& name, PropertySetGet* properties)
 	{
-		std::string source = mParent->getSource();
-		int type = mParent->getType();
-		std::string basePath = mParent->getBasePath();
-		size_t pos;
-
-		bool readCache = Factory::getInstance ().getReadSourceCache () && boost::filesystem::exists(
-					Factory::getInstance ().getCacheFolder () + "/" + mName);
-		bool writeCache = Factory::getInstance ().getWriteSourceCache ();
-
-
-		if (readCache)
-		{
-			std::ifstream ifs( std::string(Factory::getInstance ().getCacheFolder () + "/" + mName).c_str() );
-			std::stringstream ss;
-			ss << ifs.rdbuf();
-			source = ss.str();
-		}
+		PreprocessJob job;
+		job.mName = name;
+		job.mSource = parent->getSource();
+		job.mBasePath = parent->getBasePath();
+		job.mLanguage = Factory::getInstance().getCurrentLanguage();
+
+		if (parent->getType() == GPT_Vertex)
+			job.mDefinitions.push_back("SH_VERTEX_SHADER");
 		else
-		{
-			std::vector<std::string> definitions;
-
-			if (mParent->getType() == GPT_Vertex)
-				definitions.push_back("SH_VERTEX_SHADER");
-			else
-				definitions.push_back("SH_FRAGMENT_SHADER");
-			definitions.push_back(convertLang(Factory::getInstance().getCurrentLanguage()));
+			job.mDefinitions.push_back("SH_FRAGMENT_SHADER");
+		job.mDefinitions.push_back(convertLang(job.mLanguage));
 
-			parse(source, properties);
+		parse(job.mSource, properties);
 
-			if (Factory::getInstance ().getShaderDebugOutputEnabled ())
-				writeDebugFile(source, name + ".pre");
+		job.mHash = Factory::getInstance().hashPreprocessJob(job);
+		return job;
+	}
 
-			// why do we need our own preprocessor? there are several custom commands available in the shader files
-			// (for example for binding uniforms to properties or auto constants) - more below. it is important that these
-			// commands are _only executed if the specific code path actually "survives" the compilation.
-			// thus, we run the code through a preprocessor first to remove the parts that are unused because of
-			// unmet #if conditions (or other preprocessor directives).
-			source = Preprocessor::preprocess(source, basePath, definitions, name);
+	std::string ShaderInstance::generateSource (const PreprocessJob& job)
+	{
+		size_t pos;
 
-			// parse counter
-			std::map<int, int> counters;
-			while (true)
-			{
-				pos = source.find("@shCounter");
-				if (pos == std::string::npos)
-					break;
+		// why do we need our own preprocessor? there are several custom commands available in the shader files
+		// (for example for binding uniforms to properties or auto constants) - more below. it is important that these
+		// commands are _only executed if the specific code path actually "survives" the compilation.
+		// thus, we run the code through a preprocessor first to remove the parts that are unused because of
+		// unmet #if conditions (or other preprocessor directives).
+		std::string source = Preprocessor::preprocess(job.mSource, job.mBasePath, job.mDefinitions, job.mName);
 
-				size_t end = source.find(")", pos);
+		int currentPassthrough = 0; // 0 - x
+		int currentComponent = 0; // 0:x, 1:y, 2:z, 3:w
+		PassthroughMap passthroughMap;
 
-				std::vector<std::string> args = extractMacroArguments (pos, source);
-				assert(args.size());
+		// parse counter
+		std::map<int, int> counters;
+		while (true)
+		{
+			pos = source.find("@shCounter");
+			if (pos == std::string::npos)
+				break;
 
-				int index = boost::lexical_cast<int>(args[0]);
+			size_t end = source.find(")", pos);
 
-				if (counters.find(index) == counters.end())
-					counters[index] = 0;
+			std::vector<std::string> args = extractMacroArguments (pos, source);
+			assert(args.size());
 
-				source.replace(pos, (end+1)-pos, boost::lexical_cast<std::string>(counters[index]++));
-			}
+			int index = boost::lexical_cast<int>(args[0]);
 
-			// parse passthrough declarations
-			while (true)
-			{
-				pos = source.find("@shAllocatePassthrough");
-				if (pos == std::string::npos)
-					break;
+			if (counters.find(index) == counters.end())
+				counters[index] = 0;
 
-				if (mCurrentPassthrough > 7)
-					throw std::runtime_error ("too many passthrough's requested (max 8)");
+			source.replace(pos, (end+1)-pos, boost::lexical_cast<std::string>(counters[index]++));
+		}
 
-				std::vector<std::string> args = extractMacroArguments (pos, source);
-				assert(args.size() == 2);
+		// parse passthrough declarations
+		while (true)
+		{
+			pos = source.find("@shAllocatePassthrough");
+			if (pos == std::string::npos)
+				break;
 
-				size_t end = source.find(")", pos);
+			if (currentPassthrough > 7)
+				throw std::runtime_error ("too many passthrough's requested (max 8)");
 
-				Passthrough passthrough;
+			std::vector<std::string> args = extractMacroArguments (pos, source);
+			assert(args.size() == 2);
 
-				passthrough.num_components = boost::lexical_cast<int>(args[0]);
-				assert (passthrough.num_components != 0);
+			size_t end = source.find(")", pos);
 
-				std::string passthroughName = args[1];
-				passthrough.lang = Factory::getInstance().getCurrentLanguage ();
-				passthrough.component_start = mCurrentComponent;
-				passthrough.passthrough_number = mCurrentPassthrough;
+			Passthrough passthrough;
 
-				mPassthroughMap[passthroughName] = passthrough;
+			passthrough.num_components = boost::lexical_cast<int>(args[0]);
+			assert (passthrough.num_components != 0);
 
-				mCurrentComponent += passthrough.num_components;
-				if (mCurrentComponent > 3)
-				{
-					mCurrentComponent -= 4;
-					++mCurrentPassthrough;
-				}
+			std::string passthroughName = args[1];
+			passthrough.lang = job.mLanguage;
+			passthrough.component_start = currentComponent;
+			passthrough.passthrough_number = currentPassthrough;
 
-				source.erase(pos, (end+1)-pos);
-			}
+			passthroughMap[passthroughName] = passthrough;
 
-			// passthrough assign
-			while (true)
+			currentComponent += passthrough.num_components;
+			if (currentComponent > 3)
 			{
-				pos = source.find("@shPassthroughAssign");
-				if (pos == std::string::npos)
-					break;
+				currentComponent -= 4;
+				++currentPassthrough;
+			}
 
-				std::vector<std::string> args = extractMacroArguments (pos, source);
-				assert(args.size() == 2);
+			source.erase(pos, (end+1)-pos);
+		}
 
-				size_t end = source.find(")", pos);
+		// passthrough assign
+		while (true)
+		{
+			pos = source.find("@shPassthroughAssign");
+			if (pos == std::string::npos)
+				break;
 
-				std::string passthroughName = args[0];
-				std::string assignTo = args[1];
+			std::vector<std::string> args = extractMacroArguments (pos, source);
+			assert(args.size() == 2);
 
-				assert(mPassthroughMap.find(passthroughName) != mPassthroughMap.end());
-				Passthrough& p = mPassthroughMap[passthroughName];
+			size_t end = source.find(")", pos);
 
-				source.replace(pos, (end+1)-pos, p.expand_assign(assignTo));
-			}
+			std::string passthroughName = args[0];
+			std::string assignTo = args[1];
 
-			// passthrough receive
-			while (true)
-			{
-				pos = source.find("@shPassthroughReceive");
-				if (pos == std::string::npos)
-					break;
+			assert(passthroughMap.find(passthroughName) != passthroughMap.end());
+			Passthrough& p = passthroughMap[passthroughName];
 
-				std::vector<std::string> args = extractMacroArguments (pos, source);
-				assert(args.size() == 1);
+			source.replace(pos, (end+1)-pos, p.expand_assign(assignTo));
+		}
 
-				size_t end = source.find(")", pos);
-				std::string passthroughName = args[0];
+		// passthrough receive
+		while (true)
+		{
+			pos = source.find("@shPassthroughReceive");
+			if (pos == std::string::npos)
+				break;
 
-				assert(mPassthroughMap.find(passthroughName) != mPassthroughMap.end());
-				Passthrough& p = mPassthroughMap[passthroughName];
+			std::vector<std::string> args = extractMacroArguments (pos, source);
+			assert(args.size() == 1);
 
-				source.replace(pos, (end+1)-pos, p.expand_receive());
-			}
+			size_t end = source.find(")", pos);
+			std::string passthroughName = args[0];
 
-			// passthrough vertex outputs
-			while (true)
-			{
-				pos = source.find("@shPassthroughVertexOutputs");
-				if (pos == std::string::npos)
-					break;
+			assert(passthroughMap.find(passthroughName) != passthroughMap.end());
+			Passthrough& p = passthroughMap[passthroughName];
 
-				std::string result;
-				for (int i = 0; i < mCurrentPassthrough+1; ++i)
-				{
-					// not using newlines here, otherwise the line numbers reported by compiler would be messed up..
-					if (Factory::getInstance().getCurrentLanguage () == Language_CG || Factory::getInstance().getCurrentLanguage () == Language_HLSL)
-						result += ", out float4 passthrough" + boost::lexical_cast<std::string>(i) + " : TEXCOORD" + boost::lexical_cast<std::string>(i);
-
-					/*
-					else
-						result += "out vec4 passthrough" + boost::lexical_cast<std::string>(i) + "; ";
-						*/
-					else
-						result += "varying vec4 passthrough" + boost::lexical_cast<std::string>(i) + "; ";
-				}
+			source.replace(pos, (end+1)-pos, p.expand_receive());
+		}
 
-				source.replace(pos, std::string("@shPassthroughVertexOutputs").length(), result);
-			}
+		// passthrough vertex outputs
+		while (true)
+		{
+			pos = source.find("@shPassthroughVertexOutputs");
+			if (pos == std::string::npos)
+				break;
 
-			// passthrough fragment inputs
-			while (true)
+			std::string result;
+			for (int i = 0; i < currentPassthrough+1; ++i)
 			{
-				pos = source.find("@shPassthroughFragmentInputs");
-				if (pos == std::string::npos)
-					break;
-
-				std::string result;
-				for (int i = 0; i < mCurrentPassthrough+1; ++i)
-				{
-					// not using newlines here, otherwise the line numbers reported by compiler would be messed up..
-					if (Factory::getInstance().getCurrentLanguage () == Language_CG || Factory::getInstance().getCurrentLanguage () == Language_HLSL)
-						result += ", in float4 passthrough" + boost::lexical_cast<std::string>(i) + " : TEXCOORD" + boost::lexical_cast<std::string>(i);
-					/*
-					else
-						result += "in vec4 passthrough" + boost::lexical_cast<std::string>(i) + "; ";
-						*/
-					else
-						result += "varying vec4 passthrough" + boost::lexical_cast<std::string>(i) + "; ";
-				}
+				// not using newlines here, otherwise the line numbers reported by compiler would be messed up..
+				if (job.mLanguage == Language_CG || job.mLanguage == Language_HLSL)
+					result += ", out float4 passthrough" + boost::lexical_cast<std::string>(i) + " : TEXCOORD" + boost::lexical_cast<std::string>(i);
 
-				source.replace(pos, std::string("@shPassthroughFragmentInputs").length(), result);
+				/*
+				else
+					result += "out vec4 passthrough" + boost::lexical_cast<std::string>(i) + "; ";
+					*/
+				else
+					result += "varying vec4 passthrough" + boost::lexical_cast<std::string>(i) + "; ";
 			}
+
+			source.replace(pos, std::string("@shPassthroughVertexOutputs").length(), result);
 		}
 
-		// save to cache _here_ - we want to preserve some macros
-		if (writeCache && !readCache)
+		// passthrough fragment inputs
+		while (true)
 		{
-			std::ofstream of (std::string(Factory::getInstance ().getCacheFolder () + "/" + mName).c_str(), std::ios_base::out);
-			of.write(source.c_str(), source.size());
-			of.close();
+			pos = source.find("@shPassthroughFragmentInputs");
+			if (pos == std::string::npos)
+				break;
+
+			std::string result;
+			for (int i = 0; i < currentPassthrough+1; ++i)
+			{
+				// not using newlines here, otherwise the line numbers reported by compiler would be messed up..
+				if (job.mLanguage == Language_CG || job.mLanguage == Language_HLSL)
+					result += ", in float4 passthrough" + boost::lexical_cast<std::string>(i) + " : TEXCOORD" + boost::lexical_cast<std::string>(i);
+				/*
+				else
+					result += "in vec4 passthrough" + boost::lexical_cast<std::string>(i) + "; ";
+					*/
+				else
+					result += "varying vec4 passthrough" + boost::lexical_cast<std::string>(i) + "; ";
+			}
+
+			source.replace(pos, std::string("@shPassthroughFragmentInputs").length(), result);
 		}
 
+		return source;
+	}
+
+	ShaderInstance::ShaderInstance (ShaderSet* parent, const std::string& name, PropertySetGet* properties)
+		: mName(name)
+		, mParent(parent)
+		, mSupported(true)
+	{
+		int type = mParent->getType();
+		size_t pos;
+
+		PreprocessJob job = createPreprocessJob(mParent, name, properties);
+
+		if (Factory::getInstance ().getShaderDebugOutputEnabled ())
+			writeDebugFile(job.mSource, name + ".pre");
+
+		// the cache is written before the remaining macros are parsed - we want to preserve them
+		std::string source = Factory::getInstance ().getPreprocessedSource (job);
 
 		// parse shared parameters
 		while (true)
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "Platform.hpp"
+#include "PreprocessQueue.hpp"
 
 namespace sh
 {
@@ -42,6 +43,15 @@ namespace sh
 
 		void setUniformParameters (boost::shared_ptr<Pass> pass, PropertySetGet* properties);
 
+		/// Resolve the property and global setting macros of \a parent 's source for the given properties,
+		/// which is cheap, and return the input for the expensive rest of the source generation.
+		/// @note Must be called from the main thread, since the properties may be modified when retrieving values.
+		static PreprocessJob createPreprocessJob (ShaderSet* parent, const std::string& name, PropertySetGet* properties);
+
+		/// Run the preprocessor and expand the passthrough macros.
+		/// @note Thread-safe, does not depend on any state besides \a job and the included files.
+		static std::string generateSource (const PreprocessJob& job);
+
 	private:
 		boost::shared_ptr<GpuProgram> mProgram;
 		std::string mName;
@@ -57,14 +67,9 @@ namespace sh
 		///< uniforms that this depends on, and their property names / value-types
 		/// @note this lists shared uniform parameters as well
 
-		int mCurrentPassthrough; ///< 0 - x
-		int mCurrentComponent; ///< 0:x, 1:y, 2:z, 3:w
-
-		PassthroughMap mPassthroughMap;
-
-		std::vector<std::string> extractMacroArguments (size_t pos, const std::string& source); ///< take a macro invocation and return vector of arguments
+		static std::vector<std::string> extractMacroArguments (size_t pos, const std::string& source); ///< take a macro invocation and return vector of arguments
 
-		void parse (std::string& source, PropertySetGet* properties);
+		static void parse (std::string& source, PropertySetGet* properties);
 	};
 }
 
@@ -136,10 +136,21 @@ namespace sh
 				return NULL;
 			}
 			mInstances.insert(std::make_pair(h, newInstance));
+			Factory::getInstance().recordPermutation(mName, newInstance.getName(), properties);
 		}
 		return &mInstances.find(h)->second;
 	}
 
+	bool ShaderSet::createPreprocessJob (const std::string& instance, PropertySetGet* properties, PreprocessJob& job)
+	{
+		size_t h = buildHash (properties);
+		if (instance != mName + "_" + boost::lexical_cast<std::string>(h) || mInstances.find(h) != mInstances.end())
+			return false;
+
+		job = ShaderInstance::createPreprocessJob(this, instance, properties);
+		return true;
+	}
+
 	size_t ShaderSet::buildHash (PropertySetGet* properties)
 	{
 		size_t seed = 0;
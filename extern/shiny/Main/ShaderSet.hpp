@@ -31,6 +31,11 @@ namespace sh
 		/// so it does not matter if you pass any extra properties that the shader does not care about.
 		ShaderInstance* getInstance (PropertySetGet* properties);
 
+		/// Prepare the generation of the permutation \a instance for the given properties, see Factory::prewarmShaders
+		/// @return false if the permutation exists already, or the properties and current global settings would
+		/// result in a different permutation
+		bool createPreprocessJob (const std::string& instance, PropertySetGet* properties, PreprocessJob& job);
+
 	private:
 		PropertySetGet* getCurrentGlobalSettings() const;
 		std::string getBasePath() const;